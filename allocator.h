@@ -0,0 +1,68 @@
+/*
+ * allocator.h
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#ifndef DUTILS_ALLOCATOR_H_
+#define DUTILS_ALLOCATOR_H_
+
+/****************************************************************************
+ * standard libraries
+ ****************************************************************************/
+
+#include <stddef.h>
+
+
+/****************************************************************************
+ * base data structures
+ ****************************************************************************/
+
+/* node allocator carrying an opaque user context.
+ *
+ * ABOUT ['ctx']: handed untouched to every call. this is where a pool,
+ * ------- an arena or any other per-list allocation state lives.
+ * ABOUT ['alloc' and 'dalloc']: required. same contract as 'malloc' and
+ * ------- 'free' from <stdlib.h> with 'ctx' as first argument.
+ * ABOUT ['bulk_alloc']: optional, may be NULL. stores up to 'n' blocks of
+ * ------- 'size' bytes in 'ptrs' and returns how many were stored.
+ * ABOUT ['bulk_dalloc']: optional, may be NULL. releases the 'n' blocks
+ * ------- stored in 'ptrs'.
+ * ABOUT ['reset']: optional, may be NULL. releases every block handed out
+ * ------- so far in one step. only allocators dedicated to a single list,
+ * ------- such as arenas, should provide it. see dlist_list_reset.
+ *
+ * NOTE: lists only keep a pointer to the allocator, it has to outlive
+ * ------- every list and node using it.
+ */
+struct dutils_allocator
+{
+	void *ctx;
+	void *(*alloc)(void *ctx, size_t size);
+	void (*dalloc)(void *ctx, void *ptr);
+	size_t (*bulk_alloc)(void *ctx, size_t size, void **ptrs, size_t n);
+	void (*bulk_dalloc)(void *ctx, void **ptrs, size_t n);
+	void (*reset)(void *ctx);
+};
+
+
+/****************************************************************************
+ * convinience data types for library consumers/users
+ ****************************************************************************/
+
+typedef struct dutils_allocator dutils_allocator_t;
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * arena.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "arena.h"
+
+/****************************************************************************
+ * internal helpers
+ ****************************************************************************/
+
+#define ARENA_ROUND(n) (((n) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+//offset of the first block inside a chunk
+#define ARENA_CHUNK_HEADER ARENA_ROUND(sizeof( struct arena_chunk))
+
+
+static struct arena_chunk *arena_chunk_new(size_t size)
+{
+	struct arena_chunk *chunk = NULL;
+
+	if ( NULL == (chunk = malloc(ARENA_CHUNK_HEADER + size)) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	chunk->next = NULL;
+	chunk->size = size;
+	chunk->used = 0;
+
+	return chunk;
+}/* arena_chunk_new */
+
+
+static void *arena_vt_alloc(void *ctx, size_t size)
+{
+	return arena_alloc(ctx, size);
+}/* arena_vt_alloc */
+
+
+static void arena_vt_dalloc(void *ctx, void *ptr)
+{
+	//blocks only go away on reset
+}/* arena_vt_dalloc */
+
+
+static size_t arena_vt_bulk_alloc(void *ctx, size_t size, void **ptrs, size_t n)
+{
+	size_t idx;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+		if ( NULL == (ptrs[idx] = arena_alloc(ctx, size)) )
+			break;
+	}
+
+	return idx;
+}/* arena_vt_bulk_alloc */
+
+
+static void arena_vt_bulk_dalloc(void *ctx, void **ptrs, size_t n)
+{
+	//blocks only go away on reset
+}/* arena_vt_bulk_dalloc */
+
+
+static void arena_vt_reset(void *ctx)
+{
+	arena_reset(ctx);
+}/* arena_vt_reset */
+
+
+/****************************************************************************
+ * arena library interface implementation
+ ****************************************************************************/
+
+struct arena *arena_init(struct arena *arena, size_t chunk_size)
+{
+	if ( !arena )
+		return NULL;
+
+	arena->chunk_size = ARENA_ROUND(chunk_size ? chunk_size :
+					ARENA_DEF_CHUNK_SIZE);
+	arena->chunks = NULL;
+
+	arena->allocator.ctx = arena;
+	arena->allocator.alloc = arena_vt_alloc;
+	arena->allocator.dalloc = arena_vt_dalloc;
+	arena->allocator.bulk_alloc = arena_vt_bulk_alloc;
+	arena->allocator.bulk_dalloc = arena_vt_bulk_dalloc;
+	arena->allocator.reset = arena_vt_reset;
+
+	return arena;
+}/* arena_init */
+
+
+void *arena_alloc(struct arena *arena, size_t size)
+{
+	if ( !arena || !size )
+		return NULL;
+
+	struct arena_chunk *chunk = arena->chunks;
+	void *block = NULL;
+
+	size = ARENA_ROUND(size);
+
+	if ( !chunk || chunk->size - chunk->used < size ) {
+		//oversized requests get a chunk of their own behind the current
+		//one, so the space left in the current chunk isn't wasted
+		if ( size > arena->chunk_size && chunk ) {
+			struct arena_chunk *big = arena_chunk_new(size);
+			if ( !big )
+				return NULL;
+
+			big->used = size;
+			big->next = chunk->next;
+			chunk->next = big;
+			return (char *)big + ARENA_CHUNK_HEADER;
+		}
+
+		chunk = arena_chunk_new(size > arena->chunk_size ?
+					size : arena->chunk_size);
+		if ( !chunk )
+			return NULL;
+
+		chunk->next = arena->chunks;
+		arena->chunks = chunk;
+	}
+
+	block = (char *)chunk + ARENA_CHUNK_HEADER + chunk->used;
+	chunk->used += size;
+
+	return block;
+}/* arena_alloc */
+
+
+void arena_reset(struct arena *arena)
+{
+	if ( !arena || !arena->chunks )
+		return;
+
+	struct arena_chunk *keep = arena->chunks;
+	struct arena_chunk *chunk = keep->next;
+	struct arena_chunk *next = NULL;
+
+	for( ; chunk; chunk = next)
+	{
+		next = chunk->next;
+		free(chunk);
+	}
+
+	//an oversized head chunk is not worth keeping around
+	if ( keep->size > arena->chunk_size ) {
+		free(keep);
+		arena->chunks = NULL;
+		return;
+	}
+
+	keep->next = NULL;
+	keep->used = 0;
+}/* arena_reset */
+
+
+void arena_release(struct arena *arena)
+{
+	if ( !arena )
+		return;
+
+	arena_reset(arena);
+	free(arena->chunks);
+	arena->chunks = NULL;
+}/* arena_release */
@@ -0,0 +1,120 @@
+/*
+ * arena.h
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#ifndef DUTILS_ARENA_H_
+#define DUTILS_ARENA_H_
+
+/****************************************************************************
+ * standard libraries
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+
+#define ARENA_DEF_CHUNK_SIZE (64 * 1024)
+
+//every block returned by arena_alloc is aligned to this
+#define ARENA_ALIGN 16
+
+
+/****************************************************************************
+ * base data structures
+ ****************************************************************************/
+
+struct arena_chunk
+{
+	struct arena_chunk *next;
+	size_t size;
+	size_t used;
+};
+
+struct arena
+{
+	size_t chunk_size;
+	struct arena_chunk *chunks;
+	struct dutils_allocator allocator;
+};
+
+
+/****************************************************************************
+ * convinience data types for library consumers/users
+ ****************************************************************************/
+
+typedef struct arena arena_t;
+
+
+/****************************************************************************
+ * library interface and _base_ documentation
+ ****************************************************************************/
+
+/* returns 'arena' initialized to bump allocate out of 'chunk_size' chunks
+ * returns NULL if 'arena' is NULL
+ * passing 0 to 'chunk_size' sets it to ARENA_DEF_CHUNK_SIZE
+ *
+ * ABOUT ['allocator']: ready to be used with dlist_init_allocator and
+ * ------- friends. its 'dalloc' does nothing and its 'reset' is
+ * ------- arena_reset, which is what dlist_list_reset and
+ * ------- slist_list_reset rely on to drop every node in one step.
+ * ------- an arena used this way must not be shared between lists,
+ * ------- other than those split off or mapped from one, which share
+ * ------- its lifetime. see dlist_list_reset.
+ *
+ * NOTE: no memory is taken until the first block is requested.
+ *
+ * passing invalid ['arena']
+ * ------- results in undefined behavior
+ */
+struct arena *arena_init(struct arena *arena, size_t chunk_size);
+
+
+/* returns a block of 'size' bytes aligned to ARENA_ALIGN
+ * returns NULL if 'arena' is NULL
+ * returns NULL if 'size' is 0
+ * returns NULL if a new chunk is required and can't be allocated
+ *
+ * ABOUT [lifetime]: blocks can't be freed one by one, they all go away
+ * ------- on arena_reset or arena_release.
+ * ------- requests bigger then 'chunk_size' get a chunk of their own.
+ *
+ * passing invalid ['arena']
+ * ------- results in undefined behavior
+ */
+void *arena_alloc(struct arena *arena, size_t size);
+
+
+/* invalidates every block of 'arena', keeping one chunk around for reuse
+ * passing NULL in 'arena' returns with no operation executed
+ *
+ * passing invalid ['arena']
+ * ------- results in undefined behavior
+ */
+void arena_reset(struct arena *arena);
+
+
+/* frees every chunk of 'arena', leaving it as arena_init left it
+ * passing NULL in 'arena' returns with no operation executed
+ *
+ * passing invalid ['arena']
+ * ------- results in undefined behavior
+ */
+void arena_release(struct arena *arena);
+
+#endif
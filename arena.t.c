@@ -0,0 +1,207 @@
+/*
+ * arena.t.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "arena.h"
+#include "dlist.h"
+#include "slist.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#include <assert.h>
+
+#define LOUD
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+	wmsg("testing arena lib interface\n");
+
+	{
+		wmsg("arena_init");
+
+		struct arena arena;
+		assert( NULL == arena_init(NULL, 0) );
+		assert( arena_init(&arena, 0) );
+		assert( ARENA_DEF_CHUNK_SIZE == arena.chunk_size );
+		assert( NULL == arena.chunks );
+		assert( &arena == arena.allocator.ctx );
+		assert( arena.allocator.reset );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("arena_alloc");
+
+		struct arena arena;
+		char *a;
+		char *b;
+		char *big;
+		arena_init(&arena, 256);
+		//test failures
+		assert( NULL == arena_alloc(NULL, 8) );
+		assert( NULL == arena_alloc(&arena, 0) );
+		//blocks are bumped and aligned
+		assert( (a = arena_alloc(&arena, 3)) );
+		assert( (b = arena_alloc(&arena, 8)) );
+		assert( 0 == (uintptr_t)a % ARENA_ALIGN );
+		assert( b == a + ARENA_ALIGN );
+		//oversized blocks get a chunk of their own
+		assert( (big = arena_alloc(&arena, 1000)) );
+		assert( b + ARENA_ALIGN == arena_alloc(&arena, 8) );
+		arena_release(&arena);
+		assert( NULL == arena.chunks );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("arena_reset");
+
+		struct arena arena;
+		struct arena_chunk *kept;
+		char *a;
+		arena_init(&arena, 256);
+		arena_reset(NULL);
+		arena_reset(&arena);
+		for(int i = 0; i < 100; ++i)
+			arena_alloc(&arena, 16);
+		assert( NULL != arena.chunks->next );
+		kept = arena.chunks;
+		arena_reset(&arena);
+		//a single chunk is kept and reused from its start
+		assert( kept == arena.chunks );
+		assert( NULL == arena.chunks->next );
+		assert( 0 == arena.chunks->used );
+		assert( (a = arena_alloc(&arena, 16)) );
+		assert( a + 16 == arena_alloc(&arena, 16) );
+		arena_release(&arena);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_list_reset on arena");
+
+		struct arena arena;
+		struct dlist_list list;
+		struct dlist_node *node;
+		arena_init(&arena, 0);
+		dlist_init_allocator(&list, &arena.allocator);
+		dlist_data_dalloc(&list, int_dalloc);
+		assert( NULL == dlist_list_reset(NULL, true) );
+		for(int i = 0; i < 10000; ++i)
+		{
+			int *data = arena_alloc(&arena, sizeof( int ));
+			*data = i;
+			node = dlist_node_new(&list, data, NULL);
+			dlist_node_append(&list, node);
+		}
+		assert( 10000 == list.count );
+		assert( 9999 == *(int*)list.tail->data );
+		//payloads live in the arena too
+		assert( &list == dlist_list_reset(&list, true) );
+		assert( 0 == list.count );
+		assert( NULL == list.head );
+		assert( NULL == list.tail );
+		assert( NULL == arena.chunks->next );
+		//the list is usable after a reset
+		node = dlist_node_new(&list, int_copy(1), int_dalloc);
+		dlist_node_push(&list, node);
+		//payloads from the heap are still freed
+		dlist_list_reset(&list, false);
+		assert( 0 == list.count );
+		arena_release(&arena);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_list_reset on arena");
+
+		struct arena arena;
+		struct slist_list list;
+		struct slist_node *node;
+		arena_init(&arena, 0);
+		slist_init_allocator(&list, &arena.allocator);
+		for(int i = 0; i < 10000; ++i)
+		{
+			int *data = arena_alloc(&arena, sizeof( int ));
+			*data = i;
+			node = slist_node_new(&list, data, NULL);
+			slist_node_push(&list, node);
+		}
+		assert( 10000 == list.count );
+		assert( &list == slist_list_reset(&list, 1) );
+		assert( 0 == list.count );
+		assert( NULL == list.head );
+		assert( NULL == arena.chunks->next );
+		arena_release(&arena);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("list_reset on a split arena list");
+
+		struct arena arena;
+		struct dlist_list list;
+		struct dlist_list *n_list;
+		struct slist_list s_list;
+		struct slist_list *sn_list;
+		int data[100];
+		arena_init(&arena, 0);
+		dlist_init_allocator(&list, &arena.allocator);
+		for(int i = 0; i < 100; ++i)
+		{
+			data[i] = i;
+			dlist_node_append(&list, dlist_node_new(&list, &data[i], NULL));
+		}
+		//the halves share the arena, and with it their lifetime
+		assert( (n_list = dlist_list_split_at(&list, 51)) );
+		assert( &arena.allocator == n_list->allocator );
+		assert( 50 == list.count && 50 == n_list->count );
+		assert( &list == dlist_list_reset(&list, true) );
+		//'n_list' nodes are gone too, so it is reset without visiting them
+		assert( n_list == dlist_list_reset(n_list, true) );
+		assert( 0 == n_list->count && NULL == n_list->head );
+		//both are usable again afterwards
+		dlist_node_append(&list, dlist_node_new(&list, &data[1], NULL));
+		dlist_node_append(n_list, dlist_node_new(n_list, &data[2], NULL));
+		assert( 1 == *(int*)list.head->data && 2 == *(int*)n_list->head->data );
+		dlist_list_reset(&list, true);
+		dlist_list_reset(n_list, true);
+		dlist_list_delete(n_list);
+		//same goes for slist
+		slist_init_allocator(&s_list, &arena.allocator);
+		for(int i = 0; i < 100; ++i)
+			slist_node_append(&s_list, slist_node_new(&s_list, &data[i], NULL));
+		assert( (sn_list = slist_list_split_at(&s_list, 51)) );
+		assert( &arena.allocator == sn_list->allocator );
+		assert( &s_list == slist_list_reset(&s_list, 1) );
+		assert( sn_list == slist_list_reset(sn_list, 1) );
+		assert( 0 == sn_list->count && NULL == sn_list->head );
+		slist_list_delete(sn_list);
+		arena_release(&arena);
+
+		wmsg("[OK]\n");
+	}
+
+	return 0;
+}
@@ -87,3 +87,59 @@ int cmp_int(void *a, void *b)
 
 	return !( *(int*)a  == *(int*)b );
 }
+
+int cmp3_int(void *a, void *b)
+{
+	if (!a || !b)
+		return -1;
+
+	return (*(int*)a > *(int*)b) - (*(int*)a < *(int*)b);
+}
+
+static void *count_alloc(void *ctx, size_t size)
+{
+	++((struct count_ctx*)ctx)->allocs;
+	return malloc(size);
+}
+
+static void count_dalloc(void *ctx, void *ptr)
+{
+	++((struct count_ctx*)ctx)->dallocs;
+	free(ptr);
+}
+
+static size_t count_bulk_alloc(void *ctx, size_t size, void **ptrs, size_t n)
+{
+	size_t i;
+
+	++((struct count_ctx*)ctx)->bulk_allocs;
+	for(i = 0; i < n; ++i)
+	{
+		if ( NULL == (ptrs[i] = malloc(size)) )
+			break;
+	}
+
+	return i;
+}
+
+static void count_bulk_dalloc(void *ctx, void **ptrs, size_t n)
+{
+	++((struct count_ctx*)ctx)->bulk_dallocs;
+	for(size_t i = 0; i < n; ++i)
+		free(ptrs[i]);
+}
+
+void count_ctx_init(struct dutils_allocator *allocator, struct count_ctx *ctx)
+{
+	ctx->allocs = 0;
+	ctx->dallocs = 0;
+	ctx->bulk_allocs = 0;
+	ctx->bulk_dallocs = 0;
+
+	allocator->ctx = ctx;
+	allocator->alloc = count_alloc;
+	allocator->dalloc = count_dalloc;
+	allocator->bulk_alloc = count_bulk_alloc;
+	allocator->bulk_dalloc = count_bulk_dalloc;
+	allocator->reset = NULL;
+}
@@ -25,6 +25,8 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include "allocator.h"
+
 /****************************************************************************
  * configure messages
  ****************************************************************************/
@@ -48,6 +50,21 @@ void print_test(void *data);
 
 int cmp_int(void *a, void *b);
 
+//three-way version of cmp_int, for sorted lists
+int cmp3_int(void *a, void *b);
+
+//helper allocator counting every call made through it, 'ctx' must point
+//to a struct count_ctx
+struct count_ctx
+{
+	size_t allocs;
+	size_t dallocs;
+	size_t bulk_allocs;
+	size_t bulk_dallocs;
+};
+
+void count_ctx_init(struct dutils_allocator *allocator, struct count_ctx *ctx);
+
 #endif
 
 
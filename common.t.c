@@ -73,6 +73,18 @@ int main(int argc, char **argv)
 		wmsg("[OK]\n");
 	}
 
+	{
+		int a = 1;
+		int b = 2;
+
+		wmsg("cmp3_int");
+		assert( 0 > cmp3_int(&a, &b) );
+		assert( 0 < cmp3_int(&b, &a) );
+		assert( 0 == cmp3_int(&a, &a) );
+
+		wmsg("[OK]\n");
+	}
+
 	{
 		void *data = NULL;
 
@@ -109,5 +121,24 @@ int main(int argc, char **argv)
 
 	}
 
+	{
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		void *ptrs[2];
+
+		wmsg("count_ctx_init");
+		count_ctx_init(&allocator, &ctx);
+		assert( &ctx == allocator.ctx );
+		ptrs[0] = allocator.alloc(allocator.ctx, sizeof( int ));
+		assert( ptrs[0] && 1 == ctx.allocs );
+		allocator.dalloc(allocator.ctx, ptrs[0]);
+		assert( 1 == ctx.dallocs );
+		assert( 2 == allocator.bulk_alloc(allocator.ctx, sizeof( int ), ptrs, 2) );
+		allocator.bulk_dalloc(allocator.ctx, ptrs, 2);
+		assert( 1 == ctx.bulk_allocs && 1 == ctx.bulk_dallocs );
+
+		wmsg("[OK]\n");
+	}
+
 	return 0;
 }
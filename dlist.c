@@ -17,638 +17,3534 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/
  */
 
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
 #include "dlist.h"
 
 /****************************************************************************
- * dlist library interface implementation
+ * internal helpers
  ****************************************************************************/
 
+//how many nodes are handed to 'bulk_dalloc' at once
+#define DLIST_BULK_BATCH 32
 
-struct dlist_list *dlist_init(struct dlist_list *list,
-			      void *(*node_alloc)(size_t),
-			      void (*node_dalloc)(void *))
+//inputs dlist_list_merge_k keeps on the stack before allocating its heap
+#define DLIST_MERGE_K_STACK 32
+
+//fewest nodes worth handing a thread of its own, see dlist_fold_parallel
+#define DLIST_PARALLEL_GRAIN 1024
+
+//segments kept on the stack before allocating room for them
+#define DLIST_PARALLEL_STACK 16
+
+//longest walk taken before falling back to the positional index
+#define DLIST_CURSOR_NEAR 32
+
+
+#ifdef DLIST_STATS
+static inline void dlist_stats_alloc(struct dlist_list *list, size_t n,
+				     size_t size)
 {
-	list->count = 0;
-	list->node_alloc = (node_alloc ? node_alloc : DLIST_DEF_ALLOC);
-	list->node_dalloc = (node_dalloc ? node_dalloc : DLIST_DEF_DALLOC);
+	list->stats.allocs += n;
+	list->stats.bytes += n * size;
+	list->stats.live += n;
 
-	list->head = NULL;
-	list->tail = NULL;
-	return list;
-}/* dlist_init */
+	if ( list->stats.live > list->stats.peak )
+		list->stats.peak = list->stats.live;
+}/* dlist_stats_alloc */
 
 
-struct dlist_list *dlist_list_new(void *(*node_alloc)(size_t),
-				  void (*node_dalloc)(void *))
+static inline void dlist_stats_dalloc(struct dlist_list *list, size_t n)
 {
-	node_alloc = (node_alloc ? node_alloc : DLIST_DEF_ALLOC);
-	node_dalloc = (node_dalloc ? node_dalloc : DLIST_DEF_DALLOC);
+	list->stats.dallocs += n;
+	list->stats.live = (list->stats.live > n ? list->stats.live - n : 0);
+}/* dlist_stats_dalloc */
 
-	struct dlist_list *list = NULL;
 
-	if ( NULL == (list = node_alloc( sizeof( struct dlist_list))) ) {
-		//FIXME: add support for custom error logging and msg
-		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
-			__LINE__,__func__);
+//'n' nodes changed hands from 'list' to 'n_list'
+static inline void dlist_stats_move(struct dlist_list *list,
+				    struct dlist_list *n_list, size_t n)
+{
+	list->stats.live = (list->stats.live > n ? list->stats.live - n : 0);
+	n_list->stats.live += n;
 
-		return NULL;
-	}
+	if ( n_list->stats.live > n_list->stats.peak )
+		n_list->stats.peak = n_list->stats.live;
+}/* dlist_stats_move */
 
-	list->node_alloc = node_alloc;
-	list->node_dalloc = node_dalloc;
-	list->count = 0;
-	list->head = NULL;
-	list->tail = NULL;
+#define dlist_stats_data(list) (++(list)->stats.data_dallocs)
+#else
+#define dlist_stats_alloc(list, n, size) ((void)0)
+#define dlist_stats_dalloc(list, n) ((void)0)
+#define dlist_stats_move(list, n_list, n) ((void)0)
+#define dlist_stats_data(list) ((void)0)
+#endif
 
-	return list;
-}/* dlist_list_new */
 
+static inline void *dlist_alloc(struct dlist_list *list, size_t size)
+{
+	void *ptr = NULL;
 
-struct dlist_node *dlist_node_new(struct dlist_list *list,
-				  void *data, void (*dalloc)(void *))
+	if ( list->allocator )
+		ptr = list->allocator->alloc(list->allocator->ctx, size);
+	else
+		ptr = list->node_alloc(size);
+
+	if ( ptr )
+		dlist_stats_alloc(list, 1, size);
+
+	return ptr;
+}/* dlist_alloc */
+
+
+static inline void dlist_dalloc(struct dlist_list *list, void *ptr)
 {
-	struct dlist_node *node = NULL;
+	if ( list->allocator )
+		list->allocator->dalloc(list->allocator->ctx, ptr);
+	else
+		list->node_dalloc(ptr);
 
-	if ( NULL == (node = list->node_alloc(sizeof( struct dlist_node))) ) {
-		//FIXME: add support for custom error loggin and msg
-		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
-			__LINE__,__func__);
+	dlist_stats_dalloc(list, 1);
+}/* dlist_dalloc */
 
-		return NULL;
+
+//stores up to 'n' node sized blocks in 'ptrs', returning how many
+static size_t dlist_bulk_alloc(struct dlist_list *list, void **ptrs, size_t n)
+{
+	if ( list->allocator && list->allocator->bulk_alloc ) {
+		n = list->allocator->bulk_alloc(list->allocator->ctx,
+						sizeof( struct dlist_node),
+						ptrs, n);
+		dlist_stats_alloc(list, n, sizeof( struct dlist_node));
+		return n;
 	}
 
+	if ( NULL == (ptrs[0] = dlist_alloc(list, sizeof( struct dlist_node))) )
+		return 0;
+
+	return 1;
+}/* dlist_bulk_alloc */
+
+
+static inline struct dlist_node *dlist_node_set(struct dlist_node *node,
+						void *data,
+						void (*dalloc)(void *))
+{
 	node->data = data;
+#ifndef DLIST_COMPACT_NODE
 	node->data_dalloc = dalloc;
+#endif
 	node->next = NULL;
 	node->prev = NULL;
 
 	return node;
-}/* dlist_node_new */
+}/* dlist_node_set */
 
 
-inline void dlist_node_print(const struct dlist_node *node,
-			     void (*print)(void *))
+//unlinks 'node', known to be in 'list', returning it
+static struct dlist_node *dlist_node_unlink(struct dlist_list *list,
+					    struct dlist_node *node)
 {
-	if ( !node || !print )
-		return;
-	print(node->data);
-}/* dlist_node_print */
+	if ( node->prev )
+		node->prev->next = node->next;
+	else
+		list->head = node->next;
 
+	if ( node->next )
+		node->next->prev = node->prev;
+	else
+		list->tail = node->prev;
 
-void dlist_node_delete(struct dlist_list *list,
-		       struct dlist_node *node)
+	node->next = NULL;
+	node->prev = NULL;
+	--list->count;
+
+	return node;
+}/* dlist_node_unlink */
+
+
+static inline void dlist_cursor_set(struct dlist_list *list,
+				    struct dlist_node *node, size_t index)
 {
-	if ( !list || !node )
+	list->cursor.node = node;
+	list->cursor.index = index;
+}/* dlist_cursor_set */
+
+
+//'node' at 'rank' is about to be unlinked, 0 for an unknown 'rank'
+static inline void dlist_cursor_remove(struct dlist_list *list,
+				       const struct dlist_node *node,
+				       size_t rank)
+{
+	struct dlist_cursor *cursor = &list->cursor;
+
+	if ( !cursor->node )
 		return;
 
-	//FIXME: add debug warning for existing 'node->data
-	//------ without _node_dalloc
-	if ( node->data && node->data_dalloc )
-		node->data_dalloc( node->data );
+	//step back, or forward when at the head, NULL if it was the last
+	if ( node == cursor->node ) {
+		if ( node->prev )
+			dlist_cursor_set(list, node->prev, cursor->index - 1);
+		else
+			dlist_cursor_set(list, node->next, 1);
 
-	list->node_dalloc(node);
-	node = NULL;
-}/* dlist_node_delete */
+		return;
+	}
 
+	if ( !rank )
+		cursor->node = NULL;
+	else if ( rank < cursor->index )
+		--cursor->index;
+}/* dlist_cursor_remove */
 
-void dlist_list_delete(struct dlist_list *list)
+
+//hands the cursor to 'n_list' when it lies at 'index' or past it
+static inline void dlist_cursor_cut(struct dlist_list *list,
+				    struct dlist_list *n_list, size_t index)
 {
-	if (!list)
+	if ( !list->cursor.node || list->cursor.index < index )
 		return;
 
-	void (*node_dalloc)(void *) = list->node_dalloc;
-	node_dalloc(list);
-}/* dlist_list_delete */
+	dlist_cursor_set(n_list, list->cursor.node, list->cursor.index - index + 1);
+	list->cursor.node = NULL;
+}/* dlist_cursor_cut */
 
 
-struct dlist_node *dlist_node_push(struct dlist_list *list,
-				   struct dlist_node *node)
+#ifndef DLIST_COMPACT_NODE
+//marks inline nodes, never called: their 'data' goes with the node
+static void dlist_inline_dalloc(void *data)
 {
-	if ( !list || !node )
-		return NULL;
-
-	node->next = list->head;
+}/* dlist_inline_dalloc */
+#endif
 
-	//is this our first node ?
-	if (!list->head)
-		list->tail = node;
-	else
-		list->head->prev = node;
 
-	node->prev = NULL;
-	++list->count;
+static inline bool dlist_node_is_inline(const struct dlist_node *node)
+{
+#ifdef DLIST_COMPACT_NODE
+	//no room for the mark, dlist_node_new_inline makes none
+	return false;
+#else
+	return ( dlist_inline_dalloc == node->data_dalloc );
+#endif
+}/* dlist_node_is_inline */
+
+
+//deletes 'node' 'data' with its own dalloc, or else the 'list' one
+static inline void dlist_node_data_dalloc(struct dlist_list *list,
+					  struct dlist_node *node)
+{
+	if ( !node->data || dlist_node_is_inline(node) )
+		return;
 
-	list->head = node;
+#ifndef DLIST_COMPACT_NODE
+	if ( node->data_dalloc ) {
+		dlist_stats_data(list);
+		node->data_dalloc( node->data );
+		return;
+	}
+#endif
 
-	return node;
-}/* dlist_node_push */
+	if ( list->data_dalloc ) {
+		dlist_stats_data(list);
+		list->data_dalloc( node->data );
+	}
+}/* dlist_node_data_dalloc */
 
 
-struct dlist_node *dlist_node_append(struct dlist_list *list,
-				     struct dlist_node *node)
+//gives a node, whose 'data' is already taken care of, back
+static inline void dlist_node_release(struct dlist_list *list,
+				      struct dlist_node *node)
 {
-	if ( !list || !node )
-		return NULL;
-
-	//check add @ head
-	if ( !list->head ) {
-		list->head = node;
-		node->next = NULL;
-		node->prev = NULL;
-		list->tail = node;
-		++list->count;
-		return node;
+	if ( list->cache_count < list->cache_max && !dlist_node_is_inline(node) ) {
+		node->next = list->cache;
+		list->cache = node;
+		++list->cache_count;
+		return;
 	}
 
-	list->tail->next = node;
-	node->next = NULL;
-	node->prev = list->tail;
-	list->tail = node;
-	++list->count;
+	dlist_dalloc(list, node);
+}/* dlist_node_release */
 
-	return node;
-}/* dlist_node_append */
 
+static struct dlist_list *dlist_setup(struct dlist_list *list,
+				      void *(*node_alloc)(size_t),
+				      void (*node_dalloc)(void *),
+				      const struct dutils_allocator *allocator)
+{
+	list->count = 0;
+	list->head = NULL;
+	list->tail = NULL;
+	list->allocator = allocator;
+	list->data_dalloc = NULL;
+	list->cache = NULL;
+	list->cache_count = 0;
+	list->cache_max = 0;
+	list->skip = NULL;
+	list->hash = NULL;
+	list->cursor.node = NULL;
+	list->cursor.index = 0;
+#ifdef DLIST_STATS
+	memset(&list->stats, 0, sizeof( struct dlist_stats));
+#endif
+
+	if ( allocator ) {
+		list->node_alloc = NULL;
+		list->node_dalloc = NULL;
+	} else {
+		list->node_alloc = (node_alloc ? node_alloc : DLIST_DEF_ALLOC);
+		list->node_dalloc = (node_dalloc ? node_dalloc : DLIST_DEF_DALLOC);
+	}
 
-struct dlist_node *dlist_node_pop(struct dlist_list *list)
+	return list;
+}/* dlist_setup */
+
+
+//returns a new empty list allocating nodes the same way 'list' does
+static struct dlist_list *dlist_list_new_from(const struct dlist_list *list)
 {
-	if ( !list || !list->head )
-		return NULL;
+	if ( list->allocator )
+		return dlist_list_new_allocator(list->allocator);
 
-	struct dlist_node *node = list->head;
+	return dlist_list_new(list->node_alloc, list->node_dalloc);
+}/* dlist_list_new_from */
 
-	if ( list->head == list->tail )
-		list->tail = NULL;
 
-	list->head = list->head->next;
-	if ( list->head )
-		list->head->prev = NULL;
+/****************************************************************************
+ * positional index internals
+ *
+ * ranks count 'nodes' from the head, which is rank 1, the sentinel tower
+ * sits at rank 0. a level 'span' is the rank of 'next' minus the tower
+ * own rank, or 'count' minus it when 'next' is NULL.
+ ****************************************************************************/
 
-	--list->count;
-	return node;
-}/* dlist_node_pop */
 
+struct dlist_skip_tower;
 
-struct dlist_node *dlist_node_find(struct dlist_list *list, void *key,
-				   int (*cmp)(void *a, void *b))
+struct dlist_skip_level
 {
+	struct dlist_skip_tower *next;
+	size_t span;
+};
 
-	if ( !list || !list->head || !key || !cmp )
-		return NULL;
+struct dlist_skip_tower
+{
+	//NULL for the sentinel
+	struct dlist_node *node;
+	size_t height;
+	struct dlist_skip_level lv[];
+};
 
-	struct dlist_node *iter;
-	//check if found @ head
-	if ( 0 == cmp(list->head->data, key) )
-		return list->head;
+struct dlist_skip
+{
+	//sentinel, DLIST_SKIP_LEVELS high
+	struct dlist_skip_tower *head;
+	//'node' to tower, open addressing, 'slot_count' is a power of 2
+	struct dlist_skip_tower **slots;
+	size_t slot_count;
+	size_t towers;
+	uint64_t seed;
+	//no towers while set, rebuilt on next positional lookup
+	bool stale;
+};
+
+
+static inline size_t dlist_skip_hash(const struct dlist_node *node)
+{
+	return (size_t)(((uint64_t)(uintptr_t)node * 0x9E3779B97F4A7C15ULL) >> 32);
+}/* dlist_skip_hash */
 
-	if ( list->head != list->tail && 0 == cmp(list->tail->data, key) )
-		return list->tail;
 
-	for(iter = list->head; NULL != iter->next; iter = iter->next)
+static struct dlist_skip_tower *dlist_skip_lookup(const struct dlist_skip *skip,
+						  const struct dlist_node *node)
+{
+	if ( !skip->slot_count )
+		return NULL;
+
+	size_t mask = skip->slot_count - 1;
+	size_t i = dlist_skip_hash(node) & mask;
+
+	for( ; NULL != skip->slots[i]; i = (i + 1) & mask)
 	{
-		if ( 0 == cmp(iter->next->data, key) )
-			break;
+		if ( node == skip->slots[i]->node )
+			return skip->slots[i];
 	}
 
-	return iter->next;
+	return NULL;
+}/* dlist_skip_lookup */
 
-}/* dlist_node_find */
 
+static void dlist_skip_put(struct dlist_skip *skip,
+			   struct dlist_skip_tower *tower)
+{
+	size_t mask = skip->slot_count - 1;
+	size_t i = dlist_skip_hash(tower->node) & mask;
+
+	while ( skip->slots[i] )
+		i = (i + 1) & mask;
 
-struct dlist_node *dlist_node_fast_find(struct dlist_list *list, void *key,
-					int (*cmp)(void *a, void *b))
+	skip->slots[i] = tower;
+	++skip->towers;
+}/* dlist_skip_put */
+
+
+//keeps slots at most half full for 'towers' towers
+static bool dlist_skip_reserve(struct dlist_skip *skip, size_t towers)
 {
-	if ( !list || !list->head || !key || !cmp )
-		return NULL;
+	if ( towers * 2 <= skip->slot_count )
+		return true;
 
-	struct dlist_node *h_iter = list->head;
-	struct dlist_node *t_iter = list->tail;
-	//check if found @ head
-	if ( 0 == cmp(list->head->data, key) )
-		return list->head;
+	struct dlist_skip_tower **old = skip->slots;
+	size_t old_count = skip->slot_count;
+	size_t count = (old_count ? old_count : 16);
 
-	if ( list->head != list->tail && 0 == cmp(list->tail->data, key) )
-		return list->tail;
+	while ( count < towers * 2 )
+		count *= 2;
 
-	for( ; !h_iter && !t_iter; h_iter = h_iter->next, t_iter = t_iter->prev)
-	{
-		if ( 0 == cmp(h_iter->next->data, key) )
-			return h_iter->next;
+	if ( NULL == (skip->slots = calloc(count, sizeof( *skip->slots))) ) {
+		skip->slots = old;
+		return false;
+	}
 
-		if ( 0 == cmp(t_iter->next->data, key) )
-			return t_iter->next;
+	skip->slot_count = count;
+	skip->towers = 0;
 
-		if ( h_iter == t_iter )
-			break;
+	for(size_t i = 0; i < old_count; ++i)
+	{
+		if ( old[i] )
+			dlist_skip_put(skip, old[i]);
 	}
 
-	return NULL;
-}
+	DLIST_DEF_DALLOC(old);
+	return true;
+}/* dlist_skip_reserve */
 
-size_t dlist_find_index_of(struct dlist_list *list, void *key,
-			   int (*cmp)(void *a, void *b))
+
+//takes 'node' tower out of the slots, it has to be there
+static void dlist_skip_drop(struct dlist_skip *skip,
+			    const struct dlist_node *node)
 {
-	if ( !list || !list->head || !key || !cmp )
-		return 0;
+	size_t mask = skip->slot_count - 1;
+	size_t i = dlist_skip_hash(node) & mask;
+	size_t j;
+	size_t home;
 
-	struct dlist_node *iter;
-	size_t idx = 1;
+	while ( node != skip->slots[i]->node )
+		i = (i + 1) & mask;
 
-	for(iter = list->head; NULL != iter; iter = iter->next, ++idx)
+	//shift back followers that would no longer be found
+	for(j = (i + 1) & mask; NULL != skip->slots[j]; j = (j + 1) & mask)
 	{
-		if ( 0 == cmp(iter->data, key) )
-			break;
+		home = dlist_skip_hash(skip->slots[j]->node) & mask;
+		if ( ((j - home) & mask) >= ((j - i) & mask) ) {
+			skip->slots[i] = skip->slots[j];
+			i = j;
+		}
 	}
 
-	if ( !iter )
-		return 0;
-
-	return idx;
-}/* dlist_find_index_of */
+	skip->slots[i] = NULL;
+	--skip->towers;
+}/* dlist_skip_drop */
 
 
-struct dlist_node *dlist_node_remove(struct dlist_list *list, void *key,
-				     int (*cmp)(void *a, void *b))
+//returns 0 for no tower, 'n' with probability 1/4^n otherwise
+static size_t dlist_skip_height(struct dlist_skip *skip)
 {
-	if ( !list || !list->head || !key || !cmp )
-		return NULL;
+	uint64_t bits;
+	size_t height = 0;
 
-	struct dlist_node *iter;
-	struct dlist_node *pnode;
-	//check found @ head
-	if ( 0 == cmp(list->head->data, key) ) {
-		pnode = list->head;
-		if ( list->head == list->tail )
-			list->tail = NULL;
-
-		list->head = list->head->next;
-		if ( list->head )
-			list->head->prev = NULL;
-		--list->count;
+	skip->seed ^= skip->seed >> 12;
+	skip->seed ^= skip->seed << 25;
+	skip->seed ^= skip->seed >> 27;
+	bits = skip->seed * 0x2545F4914F6CDD1DULL;
 
-		return pnode;
+	while ( 0 == (bits & 3) && height < DLIST_SKIP_LEVELS )
+	{
+		++height;
+		bits >>= 2;
 	}
 
-	//check found @ tail
-	if ( list->head != list->tail && 0 == cmp(list->tail->data, key) ) {
-		pnode = list->tail;
-		list->tail->prev->next = NULL;
-		list->tail = list->tail->prev;
-		--list->count;
-		return pnode;
-	}
+	return height;
+}/* dlist_skip_height */
 
-	for(iter = list->head; NULL != iter->next; iter = iter->next)
-	{
-		if ( 0 == cmp(iter->next->data, key) )
-			break;
-	}
 
-	//see if found a node
-	if ( !iter->next )
+static struct dlist_skip_tower *dlist_skip_tower_new(struct dlist_node *node,
+						     size_t height)
+{
+	struct dlist_skip_tower *tower = NULL;
+
+	tower = DLIST_DEF_ALLOC(sizeof( struct dlist_skip_tower) +
+				height * sizeof( struct dlist_skip_level));
+	if ( !tower )
 		return NULL;
 
-	pnode = iter->next;
-	pnode->next->prev = pnode->prev;
-	pnode->prev->next = pnode->next;
-	--list->count;
-	return pnode;
-}/* dlist_node_remove */
+	tower->node = node;
+	tower->height = height;
 
+	for(size_t l = 0; l < height; ++l)
+	{
+		tower->lv[l].next = NULL;
+		tower->lv[l].span = 0;
+	}
 
-struct dlist_node *dlist_node_remove_at(struct dlist_list *list,
-				       const size_t index)
+	return tower;
+}/* dlist_skip_tower_new */
+
+
+static struct dlist_skip *dlist_skip_new(uint64_t seed)
 {
-	if ( !list || !list->head || 0 == index || index > list->count )
+	struct dlist_skip *skip = NULL;
+
+	if ( NULL == (skip = DLIST_DEF_ALLOC(sizeof( struct dlist_skip))) )
 		return NULL;
 
-	//check remove @ head
-	if ( 1 == index )
-		return dlist_node_pop(list);
+	if ( NULL == (skip->head = dlist_skip_tower_new(NULL, DLIST_SKIP_LEVELS)) ) {
+		DLIST_DEF_DALLOC(skip);
+		return NULL;
+	}
 
-	struct dlist_node *node = NULL;
-	//check remove @ tail
-	if ( list->count == index ) {
-		node = list->tail;
-		list->tail->prev->next = NULL;
-		list->tail = list->tail->prev;
-		--list->count;
-		return node;
+	skip->slots = NULL;
+	skip->slot_count = 0;
+	skip->towers = 0;
+	skip->seed = (seed ? seed : 0x9E3779B97F4A7C15ULL);
+	skip->stale = false;
+
+	return skip;
+}/* dlist_skip_new */
+
+
+//frees every tower, leaving the index of an empty list
+static void dlist_skip_clear(struct dlist_skip *skip)
+{
+	struct dlist_skip_tower *tower = skip->head->lv[0].next;
+	struct dlist_skip_tower *next = NULL;
+
+	for( ; NULL != tower; tower = next)
+	{
+		next = tower->lv[0].next;
+		DLIST_DEF_DALLOC(tower);
 	}
 
-	node = list->head;
-	for(size_t idx=1; idx < index; ++idx)
-		node = node->next;
+	for(size_t l = 0; l < DLIST_SKIP_LEVELS; ++l)
+	{
+		skip->head->lv[l].next = NULL;
+		skip->head->lv[l].span = 0;
+	}
 
-	node->prev->next = node->next;
-	node->next->prev = node->prev;
+	if ( skip->slots )
+		memset(skip->slots, 0, skip->slot_count * sizeof( *skip->slots));
 
-	--list->count;
-	return node;
-}/* dlist_node_remove_at */
+	skip->towers = 0;
+}/* dlist_skip_clear */
 
 
-void dlist_node_foreach(struct dlist_list *list,
-			void *(*action)(void *carry, void *data, void *param),
-			void *param)
+//drops the towers of 'list', they get rebuilt on next use
+static void dlist_skip_stale(struct dlist_list *list)
 {
-	if ( !list || !list->head || !action )
+	if ( !list->skip || list->skip->stale )
 		return;
 
-	struct dlist_node *iter = NULL;
-	void *carry = NULL;
+	dlist_skip_clear(list->skip);
+	list->skip->stale = true;
+}/* dlist_skip_stale */
 
-	for(iter = list->head; NULL != iter; iter = iter->next)
-		carry = action(carry, iter->data, param);
 
-	return;
-}/* dlist_node_foreach */
+//'list' just became empty, so an empty index matches it
+static void dlist_skip_empty(struct dlist_list *list)
+{
+	if ( !list->skip )
+		return;
 
+	dlist_skip_clear(list->skip);
+	list->skip->stale = false;
+}/* dlist_skip_empty */
 
-struct dlist_list *dlist_list_delete_all_nodes(struct dlist_list *list)
+
+static bool dlist_skip_build(struct dlist_list *list)
 {
-	if ( !list || !list->head )
-		return NULL;
+	struct dlist_skip *skip = list->skip;
+	struct dlist_skip_tower *last[DLIST_SKIP_LEVELS];
+	size_t last_rank[DLIST_SKIP_LEVELS];
+	struct dlist_skip_tower *tower = NULL;
+	struct dlist_node *iter = NULL;
+	size_t rank = 1;
+	size_t height;
 
-	while( NULL != list->head )
-		dlist_node_delete(list, dlist_node_pop(list));
+	dlist_skip_clear(skip);
+	skip->stale = true;
 
-	return list;
-}/* dlist_list_delete_all_nodes */
+	for(size_t l = 0; l < DLIST_SKIP_LEVELS; ++l)
+	{
+		last[l] = skip->head;
+		last_rank[l] = 0;
+	}
 
+	for(iter = list->head; NULL != iter; iter = iter->next, ++rank)
+	{
+		if ( 0 == (height = dlist_skip_height(skip)) )
+			continue;
 
-struct dlist_list *dlist_list_reverse(struct dlist_list *list)
-{
-	if ( !list || !list->head )
-		return NULL;
+		if ( !dlist_skip_reserve(skip, skip->towers + 1) ||
+		     NULL == (tower = dlist_skip_tower_new(iter, height)) ) {
+			dlist_skip_clear(skip);
+			return false;
+		}
 
-	struct dlist_node *node = NULL;
-	struct dlist_node *head = list->head;
-	while ( head )
+		dlist_skip_put(skip, tower);
+
+		for(size_t l = 0; l < height; ++l)
+		{
+			last[l]->lv[l].next = tower;
+			last[l]->lv[l].span = rank - last_rank[l];
+			last[l] = tower;
+			last_rank[l] = rank;
+		}
+	}
+
+	for(size_t l = 0; l < DLIST_SKIP_LEVELS; ++l)
 	{
-		node = head->prev;
-		head->prev = head->next;
-		head->next = node;
-		head = head->prev;
+		last[l]->lv[l].next = NULL;
+		last[l]->lv[l].span = list->count - last_rank[l];
 	}
 
-	//set new head and return
-	node = list->tail;
-	list->tail = list->head;
-	list->head = node;
+	skip->stale = false;
+	return true;
+}/* dlist_skip_build */
 
-	return list;
-}/* dlist_list_reverse */
 
+//returns the index of 'list' ready for lookups, NULL if there is none
+static struct dlist_skip *dlist_skip_ready(struct dlist_list *list)
+{
+	if ( !list->skip )
+		return NULL;
 
-inline size_t dlist_get_size(struct dlist_list *list)
+	if ( list->skip->stale && !dlist_skip_build(list) )
+		return NULL;
+
+	return list->skip;
+}/* dlist_skip_ready */
+
+
+//stores in 'update' the last tower ranked before 'rank' on every level
+static void dlist_skip_seek(struct dlist_skip *skip, size_t rank,
+			    struct dlist_skip_tower **update, size_t *ranks)
 {
-	return list->count;
-}/* dlist_get_size */
+	struct dlist_skip_tower *tower = skip->head;
+	size_t at = 0;
+
+	for(size_t l = DLIST_SKIP_LEVELS; l--; )
+	{
+		while ( tower->lv[l].next && at + tower->lv[l].span < rank )
+		{
+			at += tower->lv[l].span;
+			tower = tower->lv[l].next;
+		}
 
+		update[l] = tower;
+		ranks[l] = at;
+	}
+}/* dlist_skip_seek */
 
-struct dlist_list *dlist_list_push(struct dlist_list *list,
-				   struct dlist_list *s_list)
+
+static struct dlist_node *dlist_skip_node_at(struct dlist_list *list,
+					     struct dlist_skip *skip,
+					     size_t rank)
 {
-	if ( !list || !s_list || !s_list->head )
-		return NULL;
+	struct dlist_skip_tower *tower = skip->head;
+	struct dlist_node *node = list->head;
+	size_t at = 0;
 
-	if ( !list->head ) {
-		list->head = s_list->head;
-		list->count = s_list->count;
-		//empty s_list
-		s_list->head = NULL;
-		s_list->count = 0;
-		return list;
+	for(size_t l = DLIST_SKIP_LEVELS; l--; )
+	{
+		while ( tower->lv[l].next && at + tower->lv[l].span <= rank )
+		{
+			at += tower->lv[l].span;
+			tower = tower->lv[l].next;
+		}
 	}
 
-	s_list->tail->next = list->head;
-	list->head->prev = s_list->tail;
+	if ( tower == skip->head )
+		at = 1;
+	else
+		node = tower->node;
 
-	list->head = s_list->head;
-	list->head->prev = NULL;
-	list->count += s_list->count;
+	for( ; at < rank; ++at)
+		node = node->next;
 
-	s_list->head = NULL;
-	s_list->tail = NULL;
-	s_list->count = 0;
-	return list;
-}/* dlist_list_push */
+	return node;
+}/* dlist_skip_node_at */
 
 
-struct dlist_list *dlist_list_append(struct dlist_list *list,
-				     struct dlist_list *s_list)
+//rank of 'tower', found climbing towards the tail where spans end in 'count'
+static size_t dlist_skip_tower_rank(const struct dlist_list *list,
+				    const struct dlist_skip_tower *tower)
 {
-	if ( !list || !s_list || !s_list->head )
-		return NULL;
+	size_t left = 0;
 
-	if ( !list->head ) {
-		list->head = s_list->head;
-		list->count = s_list->count;
-		//empty s_list
-		s_list->head = NULL;
-		s_list->count = 0;
-		return list;
+	for(;;)
+	{
+		left += tower->lv[tower->height - 1].span;
+		if ( !tower->lv[tower->height - 1].next )
+			break;
+
+		tower = tower->lv[tower->height - 1].next;
 	}
 
-	list->tail->next = s_list->head;
-	s_list->head->prev = list->tail;
-	list->count += s_list->count;
+	return list->count - left;
+}/* dlist_skip_tower_rank */
 
-	list->tail = s_list->tail;
 
-	s_list->head = NULL;
-	s_list->tail = NULL;
-	s_list->count = 0;
+static size_t dlist_skip_rank(const struct dlist_list *list,
+			      const struct dlist_skip *skip,
+			      const struct dlist_node *node)
+{
+	const struct dlist_skip_tower *tower = NULL;
+	size_t back = 0;
 
-	return list;
-}/* dlist_list_append */
+	//walk back to the closest node with a tower, or off the head
+	for( ; NULL != node; node = node->prev, ++back)
+	{
+		if ( (tower = dlist_skip_lookup(skip, node)) )
+			return dlist_skip_tower_rank(list, tower) + back;
+	}
 
+	return back;
+}/* dlist_skip_rank */
 
-struct dlist_list *dlist_list_split(struct dlist_list *list, void *key,
-				    int (*cmp)(void *a, void *b))
-{
-	if ( !list || !list->head || !key || !cmp )
-		return NULL;
 
-	struct dlist_list *n_list = NULL;
-	struct dlist_node *iter = NULL;
+//'node' was just linked in at 'rank', 'count' already accounts for it
+static void dlist_skip_insert(struct dlist_list *list,
+			      struct dlist_node *node, size_t rank)
+{
+	struct dlist_skip *skip = list->skip;
+	struct dlist_skip_tower *update[DLIST_SKIP_LEVELS];
+	size_t ranks[DLIST_SKIP_LEVELS];
+	struct dlist_skip_tower *tower = NULL;
+	size_t height;
 
-	//check key @ head
-	if ( 0 == cmp(list->head->data, key) ) {
-		n_list = dlist_list_new(list->node_alloc, list->node_dalloc);
-		if ( !n_list ) {
-			//FIXME: add support for custom error loggin and msg
-			fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
-				__LINE__,__func__);
+	if ( skip->stale )
+		return;
 
-			return NULL;
+	if ( (height = dlist_skip_height(skip)) ) {
+		if ( !dlist_skip_reserve(skip, skip->towers + 1) ||
+		     NULL == (tower = dlist_skip_tower_new(node, height)) ) {
+			dlist_skip_stale(list);
+			return;
 		}
 
-		n_list->head = list->head;
-		n_list->tail = list->tail;
-		n_list->count = list->count;
-		//make list empty
-		list->head = NULL;
-		list->tail = NULL;
-		list->count = 0;
-		return n_list;
+		dlist_skip_put(skip, tower);
 	}
 
-	//help us update list sizes without transversing twice
-	size_t idx = 0;
-	//search for key
-	for(iter = list->head; NULL != iter->next; iter = iter->next, ++idx)
+	dlist_skip_seek(skip, rank, update, ranks);
+
+	for(size_t l = 0; l < DLIST_SKIP_LEVELS; ++l)
 	{
-		if ( 0 == cmp(iter->next->data, key) )
-			break;
+		if ( l >= height ) {
+			++update[l]->lv[l].span;
+			continue;
+		}
+
+		tower->lv[l].next = update[l]->lv[l].next;
+		tower->lv[l].span = update[l]->lv[l].span - (rank - 1 - ranks[l]);
+		update[l]->lv[l].next = tower;
+		update[l]->lv[l].span = rank - ranks[l];
 	}
+}/* dlist_skip_insert */
 
-	//check if node was found
-	if ( !iter->next )
-		return NULL;
 
-	n_list = dlist_list_new(list->node_alloc, list->node_dalloc);
+//the node at 'rank' is about to be unlinked, 'count' still accounts for it
+static void dlist_skip_remove(struct dlist_list *list, size_t rank)
+{
+	struct dlist_skip *skip = list->skip;
+	struct dlist_skip_tower *update[DLIST_SKIP_LEVELS];
+	size_t ranks[DLIST_SKIP_LEVELS];
+	struct dlist_skip_tower *tower = NULL;
 
-	if ( !n_list ) {
-		//FIXME: add support for custom error loggin and msg
-		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
-			__LINE__,__func__);
+	if ( skip->stale )
+		return;
 
-		return NULL;
-	}
+	dlist_skip_seek(skip, rank, update, ranks);
 
-	//keep in mind we are one node behind so we can remove/trim
-	n_list->head = iter->next;
-	n_list->head->prev = NULL;
-	n_list->tail = list->tail;
-	n_list->count = list->count - idx - 1;
-	list->tail = iter;
-	list->count = idx + 1;
-	iter->next = NULL;
+	tower = update[0]->lv[0].next;
+	if ( tower && ranks[0] + update[0]->lv[0].span != rank )
+		tower = NULL;
 
-	return n_list;
-}/* dlist_list_split */
+	for(size_t l = 0; l < DLIST_SKIP_LEVELS; ++l)
+	{
+		if ( tower && update[l]->lv[l].next == tower ) {
+			update[l]->lv[l].span += tower->lv[l].span - 1;
+			update[l]->lv[l].next = tower->lv[l].next;
+		} else {
+			--update[l]->lv[l].span;
+		}
+	}
 
+	if ( tower ) {
+		dlist_skip_drop(skip, tower->node);
+		DLIST_DEF_DALLOC(tower);
+	}
+}/* dlist_skip_remove */
 
-struct dlist_list *dlist_list_split_at(struct dlist_list *list,
-				       const size_t index)
+
+//moves the towers linked from 'to' sentinel out of 'from' slots into its own
+static void dlist_skip_move(struct dlist_skip *from, struct dlist_skip *to)
 {
-	if ( !list || !list->head || 0 == index || index > list->count )
-		return NULL;
+	struct dlist_skip_tower *tower = NULL;
+	size_t count = 0;
+	bool room;
 
-	struct dlist_list *n_list = NULL;
-	n_list = dlist_list_new(list->node_alloc, list->node_dalloc);
+	for(tower = to->head->lv[0].next; NULL != tower; tower = tower->lv[0].next)
+		++count;
 
-	if ( !n_list ) {
-		//FIXME: add support for custom error loggin and msg
-		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
-			__LINE__,__func__);
+	room = dlist_skip_reserve(to, count);
 
-		return NULL;
+	for(tower = to->head->lv[0].next; NULL != tower; tower = tower->lv[0].next)
+	{
+		dlist_skip_drop(from, tower->node);
+		if ( room )
+			dlist_skip_put(to, tower);
 	}
 
-	//check @ head
-	if ( 1 == index ) {
-		n_list->head = list->head;
-		n_list->tail = list->tail;
-		n_list->count = list->count;
-		//make list empty
-		list->head = NULL;
-		list->tail = NULL;
-		list->count = 0;
-		return n_list;
+	//without slots the towers can't be found, start over later
+	if ( !room ) {
+		dlist_skip_clear(to);
+		to->stale = true;
 	}
+}/* dlist_skip_move */
 
-	struct dlist_node *head = NULL;
-	struct dlist_node *prev = NULL;
-	size_t idx;
 
-	prev = head = list->head;
+/* hands the towers of the nodes from 'index' onwards to 'n_list'.
+ * called before the nodes themselves change list, 'count' still whole.
+ */
+static void dlist_skip_cut(struct dlist_list *list, struct dlist_list *n_list,
+			   size_t index)
+{
+	struct dlist_skip *skip = list->skip;
+	struct dlist_skip *fresh = NULL;
+	struct dlist_skip_tower *update[DLIST_SKIP_LEVELS];
+	size_t ranks[DLIST_SKIP_LEVELS];
+	struct dlist_skip_tower *head = NULL;
+	size_t kept = index - 1;
+
+	//nothing to hand over, 'n_list' builds its own on first use
+	if ( skip->stale ) {
+		if ( (n_list->skip = dlist_skip_new(skip->seed)) )
+			n_list->skip->stale = true;
+		return;
+	}
+
+	if ( NULL == (fresh = dlist_skip_new(skip->seed)) ) {
+		dlist_skip_stale(list);
+		return;
+	}
+
+	dlist_skip_seek(skip, index, update, ranks);
 
-	for(idx= index -1; idx; --idx)
+	for(size_t l = 0; l < DLIST_SKIP_LEVELS; ++l)
 	{
-		prev = head;
-		head = head->next;
+		fresh->head->lv[l].next = update[l]->lv[l].next;
+		fresh->head->lv[l].span = update[l]->lv[l].span - (kept - ranks[l]);
+		update[l]->lv[l].next = NULL;
+		update[l]->lv[l].span = kept - ranks[l];
 	}
 
-	prev->next->prev = NULL;
-	n_list->tail = list->tail;
-	prev->next = NULL;
-	n_list->head = head;
+	//fewer towers change slots when the shorter side is the one moving
+	if ( list->count - kept <= kept ) {
+		dlist_skip_move(skip, fresh);
+		n_list->skip = fresh;
+		return;
+	}
 
-	//remove at tail ?
-	if ( list->count == index )
-		n_list->count = list->count - index + 1;
-	else
-		n_list->count = index;
+	head = skip->head;
+	skip->head = fresh->head;
+	fresh->head = head;
 
-	list->count = index - 1;
+	dlist_skip_move(skip, fresh);
+	list->skip = fresh;
+	n_list->skip = skip;
+}/* dlist_skip_cut */
 
-	return n_list;
-}/* dlist_list_split_at */
+
+/****************************************************************************
+ * key index internals
+ ****************************************************************************/
 
 
-struct dlist_list *dlist_map(const struct dlist_list *list, dlist_map_func func, void (*dalloc)(void *))
+struct dlist_hash_slot
 {
-	if (!list || !list->head || !func) return NULL;
+	//NULL for a free slot
+	struct dlist_node *node;
+	size_t hash;
+};
 
-	struct dlist_list *new_list = dlist_list_new(list->node_alloc, list->node_dalloc);
-	if (!new_list) return NULL;
+struct dlist_hash
+{
+	dlist_hash_func hash;
+	int (*cmp)(void *a, void *b);
+	//open addressing, 'slot_count' is a power of 2
+	struct dlist_hash_slot *slots;
+	size_t slot_count;
+	size_t count;
+	//no entries while set, rebuilt on next lookup
+	bool stale;
+};
+
+
+static struct dlist_hash *dlist_hash_new(dlist_hash_func hash,
+					 int (*cmp)(void *a, void *b))
+{
+	struct dlist_hash *table = NULL;
 
-	struct dlist_node *iter = list->head;
-	while (iter) {
-		void *new_data = func(iter->data);
-		struct dlist_node *new_node = dlist_node_new(new_list, new_data, dalloc);
-		if (!new_node) {
-			dlist_list_delete_all_nodes(new_list);
-			dlist_list_delete(new_list);
-			return NULL;
-		}
-		dlist_node_append(new_list, new_node);
-		iter = iter->next;
-	}
+	if ( NULL == (table = DLIST_DEF_ALLOC(sizeof( struct dlist_hash))) )
+		return NULL;
 
-	return new_list;
-}/* dlist_map */
+	table->hash = hash;
+	table->cmp = cmp;
+	table->slots = NULL;
+	table->slot_count = 0;
+	table->count = 0;
+	table->stale = false;
 
+	return table;
+}/* dlist_hash_new */
 
-struct dlist_list *dlist_filter(const struct dlist_list *list, dlist_filter_func func)
+
+static void dlist_hash_put(struct dlist_hash *table, struct dlist_node *node,
+			   size_t hash)
 {
-	if (!list || !list->head || !func) return NULL;
+	size_t mask = table->slot_count - 1;
+	size_t i = hash & mask;
 
-	struct dlist_list *new_list = dlist_list_new(list->node_alloc, list->node_dalloc);
-	if (!new_list) return NULL;
+	while ( table->slots[i].node )
+		i = (i + 1) & mask;
 
-	struct dlist_node *iter = list->head;
-	while (iter) {
-		if (func(iter->data)) {
-			struct dlist_node *new_node = dlist_node_new(new_list, iter->data, NULL);  // Shallow copy, no dalloc
-			if (!new_node) {
-				dlist_list_delete_all_nodes(new_list);
-				dlist_list_delete(new_list);
-				return NULL;
-			}
-			dlist_node_append(new_list, new_node);
-		}
-		iter = iter->next;
-	}
+	table->slots[i].node = node;
+	table->slots[i].hash = hash;
+	++table->count;
+}/* dlist_hash_put */
 
-	return new_list;
-}/* dlist_filter */
 
+//spreads user hashes, sequential ones would pile up in a single run
+static inline size_t dlist_hash_of(const struct dlist_hash *table, void *data)
+{
+	return (size_t)(((uint64_t)table->hash(data) * 0x9E3779B97F4A7C15ULL) >> 32);
+}/* dlist_hash_of */
 
-void *dlist_fold(const struct dlist_list *list, void *initial, dlist_fold_func func)
+
+static struct dlist_node *dlist_hash_lookup(struct dlist_hash *table, void *key)
 {
-	if (!list) return NULL;
-	if (!func) return initial;
+	size_t mask = table->slot_count - 1;
+	size_t hash = dlist_hash_of(table, key);
+	size_t i = hash & mask;
 
-	void *acc = initial;
-	struct dlist_node *iter = list->head;
-	while (iter) {
-		acc = func(acc, iter->data);
-		iter = iter->next;
+	//empty tables have no slots yet
+	if ( !table->count )
+		return NULL;
+
+	for( ; NULL != table->slots[i].node; i = (i + 1) & mask)
+	{
+		if ( hash == table->slots[i].hash &&
+		     0 == table->cmp(table->slots[i].node->data, key) )
+			return table->slots[i].node;
 	}
 
-	return acc;
-}/* dlist_fold */
+	return NULL;
+}/* dlist_hash_lookup */
+
+
+//keeps slots at most half full for 'count' entries
+static bool dlist_hash_reserve(struct dlist_hash *table, size_t count)
+{
+	if ( count * 2 <= table->slot_count )
+		return true;
+
+	struct dlist_hash_slot *old = table->slots;
+	size_t old_count = table->slot_count;
+	size_t slot_count = (old_count ? old_count : 16);
+
+	while ( slot_count < count * 2 )
+		slot_count *= 2;
+
+	if ( NULL == (table->slots = calloc(slot_count, sizeof( *table->slots))) ) {
+		table->slots = old;
+		return false;
+	}
+
+	table->slot_count = slot_count;
+	table->count = 0;
+
+	for(size_t i = 0; i < old_count; ++i)
+	{
+		if ( old[i].node )
+			dlist_hash_put(table, old[i].node, old[i].hash);
+	}
+
+	DLIST_DEF_DALLOC(old);
+	return true;
+}/* dlist_hash_reserve */
+
+
+//takes the entry of 'node' out, it has to be there
+static void dlist_hash_drop(struct dlist_hash *table, struct dlist_node *node)
+{
+	size_t mask = table->slot_count - 1;
+	size_t i = dlist_hash_of(table, node->data) & mask;
+	size_t j;
+
+	while ( node != table->slots[i].node )
+		i = (i + 1) & mask;
+
+	//shift back followers that would no longer be found
+	for(j = (i + 1) & mask; NULL != table->slots[j].node; j = (j + 1) & mask)
+	{
+		if ( ((j - table->slots[j].hash) & mask) >= ((j - i) & mask) ) {
+			table->slots[i] = table->slots[j];
+			i = j;
+		}
+	}
+
+	table->slots[i].node = NULL;
+	--table->count;
+}/* dlist_hash_drop */
+
+
+static void dlist_hash_clear(struct dlist_hash *table)
+{
+	if ( table->slots )
+		memset(table->slots, 0, table->slot_count * sizeof( *table->slots));
+
+	table->count = 0;
+}/* dlist_hash_clear */
+
+
+//drops the entries of 'list', they get rebuilt on next use
+static void dlist_hash_stale(struct dlist_list *list)
+{
+	if ( !list->hash || list->hash->stale )
+		return;
+
+	dlist_hash_clear(list->hash);
+	list->hash->stale = true;
+}/* dlist_hash_stale */
+
+
+//'list' just became empty, so an empty index matches it
+static void dlist_hash_empty(struct dlist_list *list)
+{
+	if ( !list->hash )
+		return;
+
+	dlist_hash_clear(list->hash);
+	list->hash->stale = false;
+}/* dlist_hash_empty */
+
+
+//'node' was just linked into 'list'
+static void dlist_hash_add(struct dlist_list *list, struct dlist_node *node)
+{
+	struct dlist_hash *table = list->hash;
+
+	if ( table->stale )
+		return;
+
+	if ( !dlist_hash_reserve(table, table->count + 1) ) {
+		dlist_hash_stale(list);
+		return;
+	}
+
+	dlist_hash_put(table, node, dlist_hash_of(table, node->data));
+}/* dlist_hash_add */
+
+
+//'node' is about to leave 'list'
+static inline void dlist_hash_remove_node(struct dlist_list *list,
+					  struct dlist_node *node)
+{
+	if ( !list->hash->stale )
+		dlist_hash_drop(list->hash, node);
+}/* dlist_hash_remove_node */
+
+
+static bool dlist_hash_build(struct dlist_list *list)
+{
+	struct dlist_hash *table = list->hash;
+	struct dlist_node *iter = NULL;
+
+	dlist_hash_clear(table);
+	table->stale = true;
+
+	if ( !dlist_hash_reserve(table, list->count) )
+		return false;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+		dlist_hash_put(table, iter, dlist_hash_of(table, iter->data));
+
+	table->stale = false;
+	return true;
+}/* dlist_hash_build */
+
+
+//returns the index of 'list' ready for lookups, NULL if there is none
+static struct dlist_hash *dlist_hash_ready(struct dlist_list *list)
+{
+	if ( !list->hash )
+		return NULL;
+
+	if ( list->hash->stale && !dlist_hash_build(list) )
+		return NULL;
+
+	return list->hash;
+}/* dlist_hash_ready */
+
+
+//the nodes of 's_list' are about to join 'list'
+static void dlist_hash_merge(struct dlist_list *list, struct dlist_list *s_list)
+{
+	struct dlist_node *iter = NULL;
+
+	if ( list->hash && !list->hash->stale ) {
+		if ( !dlist_hash_reserve(list->hash, list->hash->count + s_list->count) )
+			dlist_hash_stale(list);
+		else
+			for(iter = s_list->head; NULL != iter; iter = iter->next)
+				dlist_hash_put(list->hash, iter,
+					       dlist_hash_of(list->hash, iter->data));
+	}
+
+	dlist_hash_empty(s_list);
+}/* dlist_hash_merge */
+
+
+/* hands the entries of 'node', found at 'index', and every node after it
+ * to 'n_list'. called before the nodes themselves change list.
+ */
+static void dlist_hash_cut(struct dlist_list *list, struct dlist_list *n_list,
+			   struct dlist_node *node, size_t index)
+{
+	struct dlist_hash *table = list->hash;
+	struct dlist_hash *fresh = NULL;
+	struct dlist_node *iter = node;
+	size_t kept = index - 1;
+	size_t moving = list->count - kept;
+
+	if ( NULL == (fresh = dlist_hash_new(table->hash, table->cmp)) ) {
+		dlist_hash_stale(list);
+		return;
+	}
+
+	n_list->hash = fresh;
+
+	//nothing to hand over, 'n_list' builds its own on first use
+	if ( table->stale ) {
+		fresh->stale = true;
+		return;
+	}
+
+	//fewer entries change tables when the shorter side is the one moving
+	if ( moving > kept ) {
+		iter = list->head;
+		moving = kept;
+		n_list->hash = table;
+		list->hash = fresh;
+	}
+
+	if ( !dlist_hash_reserve(fresh, moving) )
+		fresh->stale = true;
+
+	for( ; moving; --moving, iter = iter->next)
+	{
+		dlist_hash_drop(table, iter);
+		if ( !fresh->stale )
+			dlist_hash_put(fresh, iter, dlist_hash_of(table, iter->data));
+	}
+}/* dlist_hash_cut */
+
+
+//moves 'node', found at 'index', and every node after it to a new list
+static struct dlist_list *dlist_list_cut(struct dlist_list *list,
+					 struct dlist_node *node, size_t index)
+{
+	struct dlist_list *n_list = dlist_list_new_from(list);
+
+	if ( !n_list ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	n_list->data_dalloc = list->data_dalloc;
+
+	//side structures go first, they rely on 'list' being whole
+	if ( list->skip )
+		dlist_skip_cut(list, n_list, index);
+
+	if ( list->hash )
+		dlist_hash_cut(list, n_list, node, index);
+
+	dlist_cursor_cut(list, n_list, index);
+
+	n_list->head = node;
+	n_list->tail = list->tail;
+	n_list->count = list->count - index + 1;
+	dlist_stats_move(list, n_list, n_list->count);
+
+	list->tail = node->prev;
+	list->count = index - 1;
+	if ( list->tail )
+		list->tail->next = NULL;
+	else
+		list->head = NULL;
+
+	node->prev = NULL;
+
+	return n_list;
+}/* dlist_list_cut */
+
+
+//unlinks 'node' from 'list' keeping indexes and cursor current
+static struct dlist_node *dlist_node_take(struct dlist_list *list,
+					  struct dlist_node *node)
+{
+	size_t rank = 0;
+
+	//a stale index would only find the rank by walking
+	if ( list->skip && !list->skip->stale ) {
+		rank = dlist_skip_rank(list, list->skip, node);
+		dlist_skip_remove(list, rank);
+	}
+
+	if ( list->hash )
+		dlist_hash_remove_node(list, node);
+
+	dlist_cursor_remove(list, node, rank);
+
+	return dlist_node_unlink(list, node);
+}/* dlist_node_take */
+
+
+//links 'node' before 'at', where it takes 'rank'. NULL 'at' appends
+static struct dlist_node *dlist_node_link_before(struct dlist_list *list,
+						 struct dlist_node *at,
+						 struct dlist_node *node,
+						 size_t rank)
+{
+	//the ends keep their own bookkeeping
+	if ( !at )
+		return dlist_node_append(list, node);
+
+	if ( at == list->head )
+		return dlist_node_push(list, node);
+
+	node->prev = at->prev;
+	node->next = at;
+	at->prev->next = node;
+	at->prev = node;
+	++list->count;
+
+	if ( list->cursor.node && list->cursor.index >= rank )
+		++list->cursor.index;
+
+	if ( list->skip )
+		dlist_skip_insert(list, node, rank);
+
+	if ( list->hash )
+		dlist_hash_add(list, node);
+
+	return node;
+}/* dlist_node_link_before */
+
+
+/* returns the first 'node' for which 'cmp' is at least 'past', 1 for the
+ * upper bound and 0 for the lower one. starts from the cursor when it is
+ * still short of the bound and leaves it on the result.
+ */
+static struct dlist_node *dlist_node_bound(struct dlist_list *list, void *key,
+					   dlist_cmp3_func cmp, int past)
+{
+	struct dlist_node *iter = NULL;
+	size_t idx = 1;
+
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	if ( cmp(list->tail->data, key) < past )
+		return NULL;
+
+	iter = list->head;
+	if ( list->cursor.node && cmp(list->cursor.node->data, key) < past ) {
+		iter = list->cursor.node->next;
+		idx = list->cursor.index + 1;
+	}
+
+	//the tail stops it
+	for( ; cmp(iter->data, key) < past; ++idx)
+		iter = iter->next;
+
+	dlist_cursor_set(list, iter, idx);
+	return iter;
+}/* dlist_node_bound */
+
+
+//merges the sorted 'next' chains 'a' and 'b', ties going to 'a'
+static struct dlist_node *dlist_sort_merge(struct dlist_node *a,
+					   struct dlist_node *b,
+					   dlist_cmp3_func cmp)
+{
+	struct dlist_node *head = NULL;
+	struct dlist_node **link = &head;
+
+	while ( a && b )
+	{
+		if ( cmp(a->data, b->data) <= 0 ) {
+			*link = a;
+			a = a->next;
+		} else {
+			*link = b;
+			b = b->next;
+		}
+
+		link = &(*link)->next;
+	}
+
+	*link = (a ? a : b);
+	return head;
+}/* dlist_sort_merge */
+
+
+
+/* bottom-up merge sort of the 'next' chain from 'head', returns the new head.
+ * 'runs[i]' holds a sorted run of 2^i nodes, or none, like the bits of a
+ * counter: each node carries into it and equal sized runs merge while
+ * they are still in cache. earlier nodes always sit in the higher runs.
+ */
+static struct dlist_node *dlist_sort_chain(struct dlist_node *head,
+					   dlist_cmp3_func cmp)
+{
+	struct dlist_node *runs[sizeof( size_t) * 8] = { NULL };
+	struct dlist_node *carry = NULL;
+	size_t top = 0;
+	size_t i;
+
+	while ( head )
+	{
+		carry = head;
+		head = head->next;
+		carry->next = NULL;
+
+		for(i = 0; runs[i]; ++i)
+		{
+			carry = dlist_sort_merge(runs[i], carry, cmp);
+			runs[i] = NULL;
+		}
+
+		runs[i] = carry;
+		if ( i >= top )
+			top = i + 1;
+	}
+
+	for(i = 0, carry = NULL; i < top; ++i)
+	{
+		if ( runs[i] )
+			carry = dlist_sort_merge(runs[i], carry, cmp);
+	}
+
+	return carry;
+}/* dlist_sort_chain */
+
+
+/* LSD radix sort of 'list' nodes by the low 'width' bytes of 'key'.
+ * sets 'head' and 'tail' when anything moves.
+ */
+static void dlist_radix_chain(struct dlist_list *list, dlist_key_func key,
+			      size_t width)
+{
+	struct dlist_node *heads[256];
+	struct dlist_node *tails[256];
+	struct dlist_node *node = NULL;
+	struct dlist_node *next = NULL;
+	struct dlist_node *prev = NULL;
+	uint64_t first = key(list->head->data);
+	uint64_t varying = 0;
+	uint64_t k;
+	unsigned int b;
+
+	for(unsigned int shift = 0; shift < width * 8; shift += 8)
+	{
+		//bytes every key shares would only copy the order over,
+		//the first pass finds them out
+		if ( shift && !((varying >> shift) & 0xff) )
+			continue;
+
+		for(b = 0; b < 256; ++b)
+			heads[b] = NULL;
+
+		//appending to the buckets keeps every pass stable
+		for(node = list->head; NULL != node; node = next)
+		{
+			next = node->next;
+			k = key(node->data);
+			if ( !shift )
+				varying |= k ^ first;
+
+			b = (k >> shift) & 0xff;
+			if ( heads[b] ) {
+				tails[b]->next = node;
+				node->prev = tails[b];
+			} else {
+				heads[b] = node;
+			}
+
+			tails[b] = node;
+		}
+
+		//only the bucket heads are left without their 'prev'
+		for(b = 0, prev = NULL; b < 256; ++b)
+		{
+			if ( !heads[b] )
+				continue;
+
+			if ( prev )
+				prev->next = heads[b];
+			else
+				list->head = heads[b];
+
+			heads[b]->prev = prev;
+			prev = tails[b];
+		}
+
+		prev->next = NULL;
+		list->tail = prev;
+	}
+}/* dlist_radix_chain */
+
+
+//a sorted input of dlist_list_merge_k, 'order' breaks ties
+struct dlist_merge_src
+{
+	struct dlist_node *node;
+	struct dlist_node *tail;
+	size_t order;
+};
+
+
+static inline int dlist_merge_before(const struct dlist_merge_src *a,
+				     const struct dlist_merge_src *b,
+				     dlist_cmp3_func cmp)
+{
+	int c = cmp(a->node->data, b->node->data);
+
+	return c < 0 || (0 == c && a->order < b->order);
+}/* dlist_merge_before */
+
+
+//moves 'heap[i]' down to its place in the min heap of 'n' inputs
+static void dlist_merge_sift(struct dlist_merge_src *heap, size_t n, size_t i,
+			     dlist_cmp3_func cmp)
+{
+	struct dlist_merge_src top = heap[i];
+	size_t child;
+
+	while ( (child = 2 * i + 1) < n )
+	{
+		if ( child + 1 < n &&
+		     dlist_merge_before(&heap[child + 1], &heap[child], cmp) )
+			++child;
+
+		if ( !dlist_merge_before(&heap[child], &top, cmp) )
+			break;
+
+		heap[i] = heap[child];
+		i = child;
+	}
+
+	heap[i] = top;
+}/* dlist_merge_sift */
+
+
+//'count' nodes from 'head' on, worked on by a single thread
+struct dlist_segment
+{
+	pthread_t thread;
+	bool spawned;
+	size_t index;
+	struct dlist_node *head;
+	size_t count;
+	void *job;
+	void *result;
+	void (*work)(struct dlist_segment *segment);
+};
+
+
+static void *dlist_segment_main(void *arg)
+{
+	struct dlist_segment *segment = arg;
+
+	segment->work(segment);
+	return NULL;
+}/* dlist_segment_main */
+
+
+//segments 'count' nodes are split in, 0 'nthreads' asking for one per cpu
+static size_t dlist_segment_count(size_t count, size_t nthreads)
+{
+	long cpus;
+
+	if ( 0 == nthreads ) {
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		nthreads = ( cpus > 0 ? (size_t)cpus : 1 );
+	}
+
+	if ( nthreads > count / DLIST_PARALLEL_GRAIN )
+		nthreads = count / DLIST_PARALLEL_GRAIN;
+
+	return ( nthreads ? nthreads : 1 );
+}/* dlist_segment_count */
+
+
+/* walks 'list' once, handing each of the 'n' segments to a thread as
+ * soon as its head is found. the last one, and those no thread could be
+ * made for, run on the calling thread. returns once all of them are done.
+ */
+static void dlist_segment_run(const struct dlist_list *list,
+			      struct dlist_segment *segments, size_t n,
+			      void (*work)(struct dlist_segment *), void *job)
+{
+	struct dlist_node *iter = list->head;
+	struct dlist_segment *segment;
+
+	for(size_t i = 0; i < n; ++i)
+	{
+		segment = &segments[i];
+		segment->index = i;
+		segment->head = iter;
+		segment->count = list->count / n + (i < list->count % n);
+		segment->job = job;
+		segment->result = NULL;
+		segment->work = work;
+		segment->spawned = false;
+
+		if ( i + 1 == n )
+			break;
+
+		segment->spawned = ( 0 == pthread_create(&segment->thread, NULL,
+							 dlist_segment_main,
+							 segment) );
+
+		for(size_t k = 0; k < segment->count; ++k)
+			iter = iter->next;
+	}
+
+	work(&segments[n - 1]);
+
+	for(size_t i = 0; i + 1 < n; ++i)
+	{
+		if ( segments[i].spawned )
+			pthread_join(segments[i].thread, NULL);
+		else
+			work(&segments[i]);
+	}
+}/* dlist_segment_run */
+
+
+struct dlist_fold_job
+{
+	void *initial;
+	dlist_fold_func func;
+	dlist_identity_func identity;
+};
+
+
+static void dlist_fold_segment(struct dlist_segment *segment)
+{
+	struct dlist_fold_job *job = segment->job;
+	struct dlist_node *iter = segment->head;
+	void *acc = ( 0 == segment->index ? job->initial : job->identity() );
+
+	for(size_t k = 0; k < segment->count; ++k, iter = iter->next)
+		acc = job->func(acc, iter->data);
+
+	segment->result = acc;
+}/* dlist_fold_segment */
+
+
+//dlist_map_parallel and dlist_filter_parallel, only one 'func' is set
+struct dlist_sublist_job
+{
+	const struct dlist_list *list;
+	dlist_map_func map;
+	dlist_filter_func filter;
+	void (*dalloc)(void *);
+};
+
+
+//builds the segment own sub-list, left NULL in 'result' if that fails
+static void dlist_sublist_segment(struct dlist_segment *segment)
+{
+	struct dlist_sublist_job *job = segment->job;
+	struct dlist_node *iter = segment->head;
+	struct dlist_list *n_list = dlist_list_new_from(job->list);
+	struct dlist_node *node = NULL;
+	void *data = NULL;
+
+	if ( !n_list )
+		return;
+
+	n_list->data_dalloc = job->dalloc;
+
+	for(size_t k = 0; k < segment->count; ++k, iter = iter->next)
+	{
+		if ( job->filter && !job->filter(iter->data) )
+			continue;
+
+		data = ( job->map ? job->map(iter->data) : iter->data );
+
+		if ( NULL == (node = dlist_node_new(n_list, data, job->dalloc)) ) {
+			if ( job->dalloc )
+				job->dalloc(data);
+
+			dlist_list_delete_all_nodes(n_list);
+			dlist_list_delete(n_list);
+			return;
+		}
+
+		dlist_node_append(n_list, node);
+	}
+
+	segment->result = n_list;
+}/* dlist_sublist_segment */
+
+
+//runs 'job' over 'list' in 'n' segments, joining the sub-lists in order
+static struct dlist_list *dlist_sublist_run(const struct dlist_list *list,
+					    size_t n,
+					    struct dlist_sublist_job *job)
+{
+	struct dlist_segment stack[DLIST_PARALLEL_STACK];
+	struct dlist_segment *segments = stack;
+	struct dlist_list *n_list = NULL;
+	struct dlist_list *s_list = NULL;
+	bool failed = false;
+
+	if ( DLIST_PARALLEL_STACK < n &&
+	     NULL == (segments = DLIST_DEF_ALLOC(n * sizeof( *segments))) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	dlist_segment_run(list, segments, n, dlist_sublist_segment, job);
+
+	for(size_t i = 0; i < n; ++i)
+		failed = failed || !segments[i].result;
+
+	for(size_t i = 0; i < n; ++i)
+	{
+		if ( NULL == (s_list = segments[i].result) )
+			continue;
+
+		if ( failed ) {
+			dlist_list_delete_all_nodes(s_list);
+			dlist_list_delete(s_list);
+		} else if ( !n_list ) {
+			n_list = s_list;
+		} else {
+			//O(1), an empty sub-list is simply dropped
+			dlist_list_append(n_list, s_list);
+			dlist_list_delete(s_list);
+		}
+	}
+
+	if ( stack != segments )
+		DLIST_DEF_DALLOC(segments);
+
+	return n_list;
+}/* dlist_sublist_run */
+
+
+/****************************************************************************
+ * dlist library interface implementation
+ ****************************************************************************/
+
+
+struct dlist_list *dlist_init(struct dlist_list *list,
+			      void *(*node_alloc)(size_t),
+			      void (*node_dalloc)(void *))
+{
+	if ( !list )
+		return NULL;
+
+	return dlist_setup(list, node_alloc, node_dalloc, NULL);
+}/* dlist_init */
+
+
+struct dlist_list *dlist_list_new(void *(*node_alloc)(size_t),
+				  void (*node_dalloc)(void *))
+{
+	node_alloc = (node_alloc ? node_alloc : DLIST_DEF_ALLOC);
+	node_dalloc = (node_dalloc ? node_dalloc : DLIST_DEF_DALLOC);
+
+	struct dlist_list *list = NULL;
+
+	if ( NULL == (list = node_alloc( sizeof( struct dlist_list))) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	return dlist_setup(list, node_alloc, node_dalloc, NULL);
+}/* dlist_list_new */
+
+
+struct dlist_list *dlist_init_allocator(struct dlist_list *list,
+					const struct dutils_allocator *allocator)
+{
+	if ( !list )
+		return NULL;
+
+	return dlist_setup(list, NULL, NULL, allocator);
+}/* dlist_init_allocator */
+
+
+struct dlist_list *dlist_list_new_allocator(const struct dutils_allocator *allocator)
+{
+	if ( !allocator )
+		return dlist_list_new(NULL, NULL);
+
+	struct dlist_list *list = NULL;
+
+	if ( NULL == (list = DLIST_DEF_ALLOC( sizeof( struct dlist_list))) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	return dlist_setup(list, NULL, NULL, allocator);
+}/* dlist_list_new_allocator */
+
+
+struct dlist_list *dlist_data_dalloc(struct dlist_list *list,
+				     void (*data_dalloc)(void *))
+{
+	if ( !list )
+		return NULL;
+
+	list->data_dalloc = data_dalloc;
+
+	return list;
+}/* dlist_data_dalloc */
+
+
+struct dlist_node *dlist_node_new(struct dlist_list *list,
+				  void *data, void (*dalloc)(void *))
+{
+	struct dlist_node *node = list->cache;
+
+	if ( node ) {
+		list->cache = node->next;
+		--list->cache_count;
+		return dlist_node_set(node, data, dalloc);
+	}
+
+	if ( NULL == (node = dlist_alloc(list, sizeof( struct dlist_node))) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	return dlist_node_set(node, data, dalloc);
+}/* dlist_node_new */
+
+
+inline void dlist_node_print(const struct dlist_node *node,
+			     void (*print)(void *))
+{
+	if ( !node || !print )
+		return;
+	print(node->data);
+}/* dlist_node_print */
+
+
+void dlist_node_delete(struct dlist_list *list,
+		       struct dlist_node *node)
+{
+	if ( !list || !node )
+		return;
+
+	//FIXME: add debug warning for existing 'node->data
+	//------ without _node_dalloc
+	dlist_node_data_dalloc(list, node);
+
+	dlist_node_release(list, node);
+	node = NULL;
+}/* dlist_node_delete */
+
+
+void dlist_list_delete(struct dlist_list *list)
+{
+	if (!list)
+		return;
+
+	dlist_cache_trim(list, 0);
+	dlist_skip_detach(list);
+	dlist_hash_detach(list);
+
+	//lists using an allocator always come from DLIST_DEF_ALLOC
+	if ( list->allocator ) {
+		DLIST_DEF_DALLOC(list);
+		return;
+	}
+
+	void (*node_dalloc)(void *) = list->node_dalloc;
+	node_dalloc(list);
+}/* dlist_list_delete */
+
+
+struct dlist_node *dlist_node_push(struct dlist_list *list,
+				   struct dlist_node *node)
+{
+	if ( !list || !node )
+		return NULL;
+
+	node->next = list->head;
+
+	//is this our first node ?
+	if (!list->head)
+		list->tail = node;
+	else
+		list->head->prev = node;
+
+	node->prev = NULL;
+	++list->count;
+
+	list->head = node;
+
+	if ( list->cursor.node )
+		++list->cursor.index;
+
+	if ( list->skip )
+		dlist_skip_insert(list, node, 1);
+
+	if ( list->hash )
+		dlist_hash_add(list, node);
+
+	return node;
+}/* dlist_node_push */
+
+
+struct dlist_node *dlist_node_append(struct dlist_list *list,
+				     struct dlist_node *node)
+{
+	if ( !list || !node )
+		return NULL;
+
+	//check add @ head
+	if ( !list->head ) {
+		list->head = node;
+		node->prev = NULL;
+	} else {
+		list->tail->next = node;
+		node->prev = list->tail;
+	}
+
+	node->next = NULL;
+	list->tail = node;
+	++list->count;
+
+	if ( list->skip )
+		dlist_skip_insert(list, node, list->count);
+
+	if ( list->hash )
+		dlist_hash_add(list, node);
+
+	return node;
+}/* dlist_node_append */
+
+
+struct dlist_node *dlist_node_pop(struct dlist_list *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	struct dlist_node *node = list->head;
+
+	if ( list->skip )
+		dlist_skip_remove(list, 1);
+
+	if ( list->hash )
+		dlist_hash_remove_node(list, node);
+
+	dlist_cursor_remove(list, node, 1);
+
+	if ( list->head == list->tail )
+		list->tail = NULL;
+
+	list->head = list->head->next;
+	if ( list->head )
+		list->head->prev = NULL;
+
+	--list->count;
+	return node;
+}/* dlist_node_pop */
+
+
+struct dlist_node *dlist_node_find(struct dlist_list *list, void *key,
+				   int (*cmp)(void *a, void *b))
+{
+
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	struct dlist_node *iter;
+	//check if found @ head
+	if ( 0 == cmp(list->head->data, key) )
+		return list->head;
+
+	if ( list->head != list->tail && 0 == cmp(list->tail->data, key) )
+		return list->tail;
+
+	for(iter = list->head; NULL != iter->next; iter = iter->next)
+	{
+		if ( 0 == cmp(iter->next->data, key) )
+			break;
+	}
+
+	return iter->next;
+
+}/* dlist_node_find */
+
+
+struct dlist_node *dlist_node_fast_find(struct dlist_list *list, void *key,
+					int (*cmp)(void *a, void *b))
+{
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	struct dlist_node *h_iter = list->head;
+	struct dlist_node *t_iter = list->tail;
+
+	//one step from each end until they meet
+	for(;;)
+	{
+		if ( 0 == cmp(h_iter->data, key) )
+			return h_iter;
+
+		if ( h_iter == t_iter )
+			break;
+
+		if ( 0 == cmp(t_iter->data, key) )
+			return t_iter;
+
+		if ( h_iter->next == t_iter )
+			break;
+
+		h_iter = h_iter->next;
+		t_iter = t_iter->prev;
+	}
+
+	return NULL;
+}/* dlist_node_fast_find */
+
+
+//one half of a dlist_node_fast_find_mt search
+struct dlist_find_half
+{
+	struct dlist_node *start;
+	size_t count;
+	//walks 'prev' when set
+	bool backward;
+	void *key;
+	int (*cmp)(void *a, void *b);
+	//raised by whichever half finds 'key' first
+	atomic_bool *found;
+	struct dlist_node *match;
+};
+
+
+static void *dlist_find_half_run(void *arg)
+{
+	struct dlist_find_half *half = arg;
+	struct dlist_node *iter = half->start;
+
+	for(size_t left = half->count; left; --left)
+	{
+		if ( atomic_load_explicit(half->found, memory_order_relaxed) )
+			break;
+
+		if ( 0 == half->cmp(iter->data, half->key) ) {
+			half->match = iter;
+			atomic_store_explicit(half->found, true, memory_order_relaxed);
+			break;
+		}
+
+		iter = (half->backward ? iter->prev : iter->next);
+	}
+
+	return NULL;
+}/* dlist_find_half_run */
+
+
+struct dlist_node *dlist_node_fast_find_mt(struct dlist_list *list, void *key,
+					   int (*cmp)(void *a, void *b),
+					   size_t threshold)
+{
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	if ( list->count < threshold || list->count < 2 )
+		return dlist_node_fast_find(list, key, cmp);
+
+	atomic_bool found = false;
+	pthread_t thread;
+	size_t head_count = (list->count + 1) / 2;
+	struct dlist_find_half head_half = {
+		list->head, head_count, false, key, cmp, &found, NULL
+	};
+	struct dlist_find_half tail_half = {
+		list->tail, list->count - head_count, true, key, cmp, &found, NULL
+	};
+
+	//the tail half runs aside, the calling thread takes the head half
+	if ( pthread_create(&thread, NULL, dlist_find_half_run, &tail_half) )
+		return dlist_node_fast_find(list, key, cmp);
+
+	dlist_find_half_run(&head_half);
+	pthread_join(thread, NULL);
+
+	return (head_half.match ? head_half.match : tail_half.match);
+}/* dlist_node_fast_find_mt */
+
+
+size_t dlist_find_index_of(struct dlist_list *list, void *key,
+			   int (*cmp)(void *a, void *b))
+{
+	if ( !list || !list->head || !key || !cmp )
+		return 0;
+
+	struct dlist_node *iter;
+	size_t idx = 1;
+
+	for(iter = list->head; NULL != iter; iter = iter->next, ++idx)
+	{
+		if ( 0 == cmp(iter->data, key) )
+			break;
+	}
+
+	if ( !iter )
+		return 0;
+
+	return idx;
+}/* dlist_find_index_of */
+
+
+struct dlist_node *dlist_node_remove(struct dlist_list *list, void *key,
+				     int (*cmp)(void *a, void *b))
+{
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	struct dlist_node *iter;
+	struct dlist_node *pnode;
+	//check found @ head
+	if ( 0 == cmp(list->head->data, key) )
+		return dlist_node_pop(list);
+
+	//check found @ tail
+	if ( list->head != list->tail && 0 == cmp(list->tail->data, key) ) {
+		if ( list->skip )
+			dlist_skip_remove(list, list->count);
+
+		if ( list->hash )
+			dlist_hash_remove_node(list, list->tail);
+
+		dlist_cursor_remove(list, list->tail, list->count);
+		pnode = list->tail;
+		list->tail->prev->next = NULL;
+		list->tail = list->tail->prev;
+		--list->count;
+		return pnode;
+	}
+
+	//rank of iter->next, kept for the index
+	size_t idx = 2;
+
+	for(iter = list->head; NULL != iter->next; iter = iter->next, ++idx)
+	{
+		if ( 0 == cmp(iter->next->data, key) )
+			break;
+	}
+
+	//see if found a node
+	if ( !iter->next )
+		return NULL;
+
+	if ( list->skip )
+		dlist_skip_remove(list, idx);
+
+	if ( list->hash )
+		dlist_hash_remove_node(list, iter->next);
+
+	dlist_cursor_remove(list, iter->next, idx);
+	pnode = iter->next;
+	pnode->next->prev = pnode->prev;
+	pnode->prev->next = pnode->next;
+	--list->count;
+	return pnode;
+}/* dlist_node_remove */
+
+
+struct dlist_node *dlist_node_remove_at(struct dlist_list *list,
+				       const size_t index)
+{
+	if ( !list || !list->head || 0 == index || index > list->count )
+		return NULL;
+
+	//check remove @ head
+	if ( 1 == index )
+		return dlist_node_pop(list);
+
+	//found before the index forgets about it
+	struct dlist_node *node = dlist_node_get_at(list, index);
+
+	if ( list->skip )
+		dlist_skip_remove(list, index);
+
+	if ( list->hash )
+		dlist_hash_remove_node(list, node);
+
+	dlist_cursor_remove(list, node, index);
+
+	//check remove @ tail
+	if ( list->count == index ) {
+		list->tail->prev->next = NULL;
+		list->tail = list->tail->prev;
+		--list->count;
+		return node;
+	}
+
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+
+	--list->count;
+	return node;
+}/* dlist_node_remove_at */
+
+
+void dlist_node_foreach(struct dlist_list *list,
+			void *(*action)(void *carry, void *data, void *param),
+			void *param)
+{
+	if ( !list || !list->head || !action )
+		return;
+
+	struct dlist_node *iter = NULL;
+	void *carry = NULL;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+		carry = action(carry, iter->data, param);
+
+	return;
+}/* dlist_node_foreach */
+
+
+//gathers the 'data' of up to DLIST_BATCH_SIZE nodes from '*iter' on
+static inline size_t dlist_batch_gather(struct dlist_node **iter, void **data)
+{
+	struct dlist_node *node = *iter;
+	size_t n = 0;
+
+	for(; node && n < DLIST_BATCH_SIZE; node = node->next)
+		data[n++] = node->data;
+
+	*iter = node;
+	return n;
+}/* dlist_batch_gather */
+
+
+void dlist_node_foreach_batch(struct dlist_list *list,
+			      dlist_batch_action_func action, void *param)
+{
+	if ( !list || !list->head || !action )
+		return;
+
+	struct dlist_node *iter = list->head;
+	void *data[DLIST_BATCH_SIZE];
+	void *carry = NULL;
+	size_t n;
+
+	while ( iter ) {
+		n = dlist_batch_gather(&iter, data);
+		carry = action(carry, data, n, param);
+	}
+}/* dlist_node_foreach_batch */
+
+
+//empties 'list' through its cache and bulk_dalloc, 'data' left alone if owned
+static void dlist_nodes_drop(struct dlist_list *list, bool data_owned)
+{
+	//no point in keeping the indexes current node by node
+	dlist_skip_stale(list);
+	dlist_hash_stale(list);
+	list->cursor.node = NULL;
+
+	if ( !list->allocator || !list->allocator->bulk_dalloc ) {
+		while( NULL != list->head )
+		{
+			struct dlist_node *node = dlist_node_pop(list);
+			if ( !data_owned )
+				dlist_node_data_dalloc(list, node);
+
+			dlist_node_release(list, node);
+		}
+
+		dlist_skip_empty(list);
+		dlist_hash_empty(list);
+		return;
+	}
+
+	void *batch[DLIST_BULK_BATCH];
+	size_t n = 0;
+	struct dlist_node *node = NULL;
+
+	while( NULL != list->head )
+	{
+		node = dlist_node_pop(list);
+		if ( !data_owned )
+			dlist_node_data_dalloc(list, node);
+
+		//fill the cache first
+		if ( list->cache_count < list->cache_max ) {
+			dlist_node_release(list, node);
+			continue;
+		}
+
+		batch[n++] = node;
+		if ( DLIST_BULK_BATCH == n ) {
+			list->allocator->bulk_dalloc(list->allocator->ctx, batch, n);
+			dlist_stats_dalloc(list, n);
+			n = 0;
+		}
+	}
+
+	if ( n ) {
+		list->allocator->bulk_dalloc(list->allocator->ctx, batch, n);
+		dlist_stats_dalloc(list, n);
+	}
+
+	dlist_skip_empty(list);
+	dlist_hash_empty(list);
+}/* dlist_nodes_drop */
+
+
+struct dlist_list *dlist_list_delete_all_nodes(struct dlist_list *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	dlist_nodes_drop(list, false);
+
+	return list;
+}/* dlist_list_delete_all_nodes */
+
+
+struct dlist_list *dlist_list_reset(struct dlist_list *list, bool data_owned)
+{
+	if ( !list )
+		return NULL;
+
+	if ( !list->allocator || !list->allocator->reset ) {
+		dlist_nodes_drop(list, data_owned);
+		return list;
+	}
+
+	//with an arena owning everything there is nothing to visit
+	if ( !data_owned )
+		for(struct dlist_node *iter = list->head; iter; iter = iter->next)
+			dlist_node_data_dalloc(list, iter);
+
+	//cached nodes come from the arena as well
+	dlist_stats_dalloc(list, list->count + list->cache_count);
+	list->allocator->reset(list->allocator->ctx);
+	list->cache = NULL;
+	list->cache_count = 0;
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->count = 0;
+	list->cursor.node = NULL;
+	dlist_skip_empty(list);
+	dlist_hash_empty(list);
+
+	return list;
+}/* dlist_list_reset */
+
+
+struct dlist_list *dlist_list_reverse(struct dlist_list *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	struct dlist_node *node = NULL;
+	struct dlist_node *head = list->head;
+	while ( head )
+	{
+		node = head->prev;
+		head->prev = head->next;
+		head->next = node;
+		head = head->prev;
+	}
+
+	//set new head and return
+	node = list->tail;
+	list->tail = list->head;
+	list->head = node;
+	list->cursor.index = list->count + 1 - list->cursor.index;
+	dlist_skip_stale(list);
+
+	return list;
+}/* dlist_list_reverse */
+
+
+inline size_t dlist_get_size(struct dlist_list *list)
+{
+	return list->count;
+}/* dlist_get_size */
+
+
+bool dlist_get_stats(const struct dlist_list *list, struct dlist_stats *stats)
+{
+#ifdef DLIST_STATS
+	if ( !list || !stats )
+		return false;
+
+	*stats = list->stats;
+
+	return true;
+#else
+	return false;
+#endif
+}/* dlist_get_stats */
+
+
+struct dlist_list *dlist_list_push(struct dlist_list *list,
+				   struct dlist_list *s_list)
+{
+	if ( !list || !s_list || !s_list->head )
+		return NULL;
+
+	dlist_stats_move(s_list, list, s_list->count);
+	dlist_hash_merge(list, s_list);
+
+	if ( !list->head ) {
+		list->tail = s_list->tail;
+	} else {
+		s_list->tail->next = list->head;
+		list->head->prev = s_list->tail;
+	}
+
+	list->head = s_list->head;
+	list->count += s_list->count;
+	list->cursor.index += s_list->count;
+	dlist_skip_stale(list);
+
+	//empty s_list
+	s_list->head = NULL;
+	s_list->tail = NULL;
+	s_list->count = 0;
+	s_list->cursor.node = NULL;
+	dlist_skip_empty(s_list);
+
+	return list;
+}/* dlist_list_push */
+
+
+struct dlist_list *dlist_list_append(struct dlist_list *list,
+				     struct dlist_list *s_list)
+{
+	if ( !list || !s_list || !s_list->head )
+		return NULL;
+
+	dlist_stats_move(s_list, list, s_list->count);
+	dlist_hash_merge(list, s_list);
+
+	if ( !list->head ) {
+		list->head = s_list->head;
+	} else {
+		list->tail->next = s_list->head;
+		s_list->head->prev = list->tail;
+	}
+
+	list->tail = s_list->tail;
+	list->count += s_list->count;
+	dlist_skip_stale(list);
+
+	//empty s_list
+	s_list->head = NULL;
+	s_list->tail = NULL;
+	s_list->count = 0;
+	s_list->cursor.node = NULL;
+	dlist_skip_empty(s_list);
+
+	return list;
+}/* dlist_list_append */
+
+
+struct dlist_list *dlist_list_split(struct dlist_list *list, void *key,
+				    int (*cmp)(void *a, void *b))
+{
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	struct dlist_node *iter = NULL;
+	size_t idx = 1;
+
+	//search for key
+	for(iter = list->head; NULL != iter; iter = iter->next, ++idx)
+	{
+		if ( 0 == cmp(iter->data, key) )
+			break;
+	}
+
+	//check if node was found
+	if ( !iter )
+		return NULL;
+
+	return dlist_list_cut(list, iter, idx);
+}/* dlist_list_split */
+
+
+struct dlist_list *dlist_list_split_at(struct dlist_list *list,
+				       const size_t index)
+{
+	if ( !list || !list->head || 0 == index || index > list->count )
+		return NULL;
+
+	struct dlist_list *n_list = NULL;
+	//found before anything is cut, which moves the cursor onto it
+	struct dlist_node *node = dlist_node_get_at(list, index);
+
+	if ( NULL == (n_list = dlist_list_cut(list, node, index)) )
+		return NULL;
+
+	//the new tail is where a scan continues from
+	if ( list->tail )
+		dlist_cursor_set(list, list->tail, index - 1);
+
+	return n_list;
+}/* dlist_list_split_at */
+
+
+struct dlist_list *dlist_map(const struct dlist_list *list, dlist_map_func func, void (*dalloc)(void *))
+{
+	if (!list || !list->head || !func) return NULL;
+
+	struct dlist_list *new_list = dlist_list_new_from(list);
+	if (!new_list) return NULL;
+	new_list->data_dalloc = dalloc;
+
+	//nodes are taken in batches, so bulk capable allocators are used as such
+	void *batch[DLIST_BULK_BATCH];
+	size_t left = list->count;
+	size_t got = 0;
+	size_t used = 0;
+
+	struct dlist_node *iter = list->head;
+	while (iter) {
+		if (used == got) {
+			size_t want = (left < DLIST_BULK_BATCH ? left : DLIST_BULK_BATCH);
+			used = 0;
+			got = dlist_bulk_alloc(new_list, batch, (want ? want : 1));
+			if (!got) {
+				dlist_list_delete_all_nodes(new_list);
+				dlist_list_delete(new_list);
+				return NULL;
+			}
+		}
+		void *new_data = func(iter->data);
+		struct dlist_node *new_node = dlist_node_set(batch[used++], new_data, dalloc);
+		dlist_node_append(new_list, new_node);
+		if (left) --left;
+		iter = iter->next;
+	}
+
+	return new_list;
+}/* dlist_map */
+
+
+struct dlist_list *dlist_filter(const struct dlist_list *list, dlist_filter_func func)
+{
+	if (!list || !list->head || !func) return NULL;
+
+	struct dlist_list *new_list = dlist_list_new_from(list);
+	if (!new_list) return NULL;
+
+	struct dlist_node *iter = list->head;
+	while (iter) {
+		if (func(iter->data)) {
+			struct dlist_node *new_node = dlist_node_new(new_list, iter->data, NULL);  // Shallow copy, no dalloc
+			if (!new_node) {
+				dlist_list_delete_all_nodes(new_list);
+				dlist_list_delete(new_list);
+				return NULL;
+			}
+			dlist_node_append(new_list, new_node);
+		}
+		iter = iter->next;
+	}
+
+	return new_list;
+}/* dlist_filter */
+
+
+void *dlist_fold(const struct dlist_list *list, void *initial, dlist_fold_func func)
+{
+	if (!list) return NULL;
+	if (!func) return initial;
+
+	void *acc = initial;
+	struct dlist_node *iter = list->head;
+	while (iter) {
+		acc = func(acc, iter->data);
+		iter = iter->next;
+	}
+
+	return acc;
+}/* dlist_fold */
+
+
+struct dlist_list *dlist_map_inplace(struct dlist_list *list,
+				     dlist_map_func func, bool dalloc_old)
+{
+	if (!list || !list->head || !func) return NULL;
+
+	struct dlist_node *iter = list->head;
+	while (iter) {
+		void *new_data = func(iter->data);
+		if (dalloc_old && new_data != iter->data)
+			dlist_node_data_dalloc(list, iter);
+		iter->data = new_data;
+		iter = iter->next;
+	}
+
+	//keys went with the old data, positions did not move
+	dlist_hash_stale(list);
+
+	return list;
+}/* dlist_map_inplace */
+
+
+struct dlist_list *dlist_filter_inplace(struct dlist_list *list,
+					dlist_filter_func func)
+{
+	if (!list || !list->head || !func) return NULL;
+
+	struct dlist_node *iter = list->head;
+	struct dlist_node *next = NULL;
+	size_t rank = 1;
+	while (iter) {
+		next = iter->next;
+		if (func(iter->data)) {
+			++rank;
+			iter = next;
+			continue;
+		}
+		//ranks past the first rejected node all shift
+		dlist_skip_stale(list);
+		if (list->hash)
+			dlist_hash_remove_node(list, iter);
+		dlist_cursor_remove(list, iter, rank);
+		dlist_node_delete(list, dlist_node_unlink(list, iter));
+		iter = next;
+	}
+
+	return list;
+}/* dlist_filter_inplace */
+
+
+struct dlist_list *dlist_map_batch(const struct dlist_list *list,
+				   dlist_batch_map_func func,
+				   void (*dalloc)(void *))
+{
+	if (!list || !list->head || !func) return NULL;
+
+	struct dlist_list *new_list = dlist_list_new_from(list);
+	if (!new_list) return NULL;
+	new_list->data_dalloc = dalloc;
+
+	void *src[DLIST_BATCH_SIZE];
+	void *dst[DLIST_BATCH_SIZE];
+	void *nodes[DLIST_BATCH_SIZE];
+	struct dlist_node *iter = list->head;
+	while (iter) {
+		size_t n = dlist_batch_gather(&iter, src);
+		func(dst, src, n);
+		//nodes for the whole batch, in as few allocator calls as it takes
+		for (size_t done = 0; done < n;) {
+			size_t got = dlist_bulk_alloc(new_list, nodes, n - done);
+			if (!got) {
+				for (; dalloc && done < n; ++done)
+					dalloc(dst[done]);
+				dlist_list_delete_all_nodes(new_list);
+				dlist_list_delete(new_list);
+				return NULL;
+			}
+			for (size_t i = 0; i < got; ++i, ++done)
+				dlist_node_append(new_list, dlist_node_set(nodes[i], dst[done], dalloc));
+		}
+	}
+
+	return new_list;
+}/* dlist_map_batch */
+
+
+void *dlist_fold_batch(const struct dlist_list *list, void *initial,
+		       dlist_batch_fold_func func)
+{
+	if (!list) return NULL;
+	if (!func) return initial;
+
+	void *data[DLIST_BATCH_SIZE];
+	void *acc = initial;
+	struct dlist_node *iter = list->head;
+	while (iter) {
+		size_t n = dlist_batch_gather(&iter, data);
+		acc = func(acc, data, n);
+	}
+
+	return acc;
+}/* dlist_fold_batch */
+
+
+void *dlist_fold_parallel(const struct dlist_list *list, void *initial,
+			  dlist_fold_func func, dlist_combine_func combine,
+			  dlist_identity_func identity, size_t nthreads)
+{
+	if ( !list )
+		return NULL;
+
+	if ( !func )
+		return initial;
+
+	if ( !combine || !identity )
+		return NULL;
+
+	size_t n = dlist_segment_count(list->count, nthreads);
+
+	if ( 1 == n )
+		return dlist_fold(list, initial, func);
+
+	struct dlist_segment stack[DLIST_PARALLEL_STACK];
+	struct dlist_segment *segments = stack;
+	struct dlist_fold_job job = { initial, func, identity };
+	void *acc = NULL;
+
+	if ( DLIST_PARALLEL_STACK < n &&
+	     NULL == (segments = DLIST_DEF_ALLOC(n * sizeof( *segments))) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	dlist_segment_run(list, segments, n, dlist_fold_segment, &job);
+
+	//in list order, so only associativity is asked of 'combine'
+	acc = segments[0].result;
+	for(size_t i = 1; i < n; ++i)
+		acc = combine(acc, segments[i].result);
+
+	if ( stack != segments )
+		DLIST_DEF_DALLOC(segments);
+
+	return acc;
+}/* dlist_fold_parallel */
+
+
+struct dlist_list *dlist_map_parallel(const struct dlist_list *list,
+				      dlist_map_func func,
+				      void (*dalloc)(void *), size_t nthreads)
+{
+	if ( !list || !list->head || !func )
+		return NULL;
+
+	size_t n = dlist_segment_count(list->count, nthreads);
+	struct dlist_sublist_job job = { list, func, NULL, dalloc };
+
+	if ( 1 == n )
+		return dlist_map(list, func, dalloc);
+
+	return dlist_sublist_run(list, n, &job);
+}/* dlist_map_parallel */
+
+
+struct dlist_list *dlist_filter_parallel(const struct dlist_list *list,
+					 dlist_filter_func func,
+					 size_t nthreads)
+{
+	if ( !list || !list->head || !func )
+		return NULL;
+
+	size_t n = dlist_segment_count(list->count, nthreads);
+	struct dlist_sublist_job job = { list, NULL, func, NULL };
+
+	if ( 1 == n )
+		return dlist_filter(list, func);
+
+	return dlist_sublist_run(list, n, &job);
+}/* dlist_filter_parallel */
+
+
+/****************************************************************************
+ * dlist node cache interface implementation
+ ****************************************************************************/
+
+
+struct dlist_list *dlist_cache_limit(struct dlist_list *list, size_t max)
+{
+	if ( !list )
+		return NULL;
+
+	list->cache_max = max;
+	dlist_cache_trim(list, max);
+
+	return list;
+}/* dlist_cache_limit */
+
+
+size_t dlist_cache_trim(struct dlist_list *list, size_t keep)
+{
+	if ( !list )
+		return 0;
+
+	struct dlist_node *node = NULL;
+	size_t freed = 0;
+
+	while ( list->cache_count > keep )
+	{
+		node = list->cache;
+		list->cache = node->next;
+		--list->cache_count;
+		dlist_dalloc(list, node);
+		++freed;
+	}
+
+	return freed;
+}/* dlist_cache_trim */
+
+
+/****************************************************************************
+ * dlist positional index interface implementation
+ ****************************************************************************/
+
+
+struct dlist_list *dlist_skip_attach(struct dlist_list *list)
+{
+	if ( !list )
+		return NULL;
+
+	if ( !list->skip &&
+	     NULL == (list->skip = dlist_skip_new((uintptr_t)list)) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	if ( !dlist_skip_build(list) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		dlist_skip_detach(list);
+		return NULL;
+	}
+
+	return list;
+}/* dlist_skip_attach */
+
+
+void dlist_skip_detach(struct dlist_list *list)
+{
+	if ( !list || !list->skip )
+		return;
+
+	dlist_skip_clear(list->skip);
+	DLIST_DEF_DALLOC(list->skip->slots);
+	DLIST_DEF_DALLOC(list->skip->head);
+	DLIST_DEF_DALLOC(list->skip);
+	list->skip = NULL;
+}/* dlist_skip_detach */
+
+
+struct dlist_node *dlist_node_get_at(struct dlist_list *list,
+				     const size_t index)
+{
+	if ( !list || !list->head || 0 == index || index > list->count )
+		return NULL;
+
+	struct dlist_cursor *cursor = &list->cursor;
+	struct dlist_skip *skip = NULL;
+	struct dlist_node *node = list->head;
+	size_t idx = 1;
+	size_t dist = index - 1;
+	size_t cdist;
+
+	//start from whichever of head, tail and cursor is closest
+	if ( list->count - index < dist ) {
+		node = list->tail;
+		idx = list->count;
+		dist = list->count - index;
+	}
+
+	if ( cursor->node ) {
+		cdist = (cursor->index > index ? cursor->index - index
+					       : index - cursor->index);
+		if ( cdist < dist ) {
+			node = cursor->node;
+			idx = cursor->index;
+			dist = cdist;
+		}
+	}
+
+	if ( DLIST_CURSOR_NEAR < dist && (skip = dlist_skip_ready(list)) ) {
+		node = dlist_skip_node_at(list, skip, index);
+	} else {
+		for( ; idx < index; ++idx)
+			node = node->next;
+		for( ; idx > index; --idx)
+			node = node->prev;
+	}
+
+	dlist_cursor_set(list, node, index);
+	return node;
+}/* dlist_node_get_at */
+
+
+size_t dlist_node_index_of(struct dlist_list *list,
+			   const struct dlist_node *node)
+{
+	if ( !list || !node )
+		return 0;
+
+	if ( node == list->cursor.node )
+		return list->cursor.index;
+
+	struct dlist_skip *skip = dlist_skip_ready(list);
+	const struct dlist_node *iter = node;
+	size_t idx = 0;
+
+	if ( skip ) {
+		idx = dlist_skip_rank(list, skip, node);
+	} else {
+		for( ; NULL != iter; iter = iter->prev, ++idx)
+		{
+			//the cursor knows its own position
+			if ( iter == list->cursor.node ) {
+				idx += list->cursor.index;
+				break;
+			}
+		}
+	}
+
+	dlist_cursor_set(list, (struct dlist_node *)node, idx);
+	return idx;
+}/* dlist_node_index_of */
+
+
+/****************************************************************************
+ * dlist key index interface implementation
+ ****************************************************************************/
+
+
+struct dlist_list *dlist_hash_attach(struct dlist_list *list,
+				     dlist_hash_func hash,
+				     int (*cmp)(void *a, void *b))
+{
+	if ( !list || !hash || !cmp )
+		return NULL;
+
+	dlist_hash_detach(list);
+
+	if ( NULL == (list->hash = dlist_hash_new(hash, cmp)) ||
+	     !dlist_hash_build(list) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		dlist_hash_detach(list);
+		return NULL;
+	}
+
+	return list;
+}/* dlist_hash_attach */
+
+
+void dlist_hash_detach(struct dlist_list *list)
+{
+	if ( !list || !list->hash )
+		return;
+
+	DLIST_DEF_DALLOC(list->hash->slots);
+	DLIST_DEF_DALLOC(list->hash);
+	list->hash = NULL;
+}/* dlist_hash_detach */
+
+
+struct dlist_node *dlist_hash_find(struct dlist_list *list, void *key)
+{
+	struct dlist_hash *table = NULL;
+
+	if ( !list || NULL == (table = dlist_hash_ready(list)) )
+		return NULL;
+
+	return dlist_hash_lookup(table, key);
+}/* dlist_hash_find */
+
+
+struct dlist_node *dlist_hash_remove(struct dlist_list *list, void *key)
+{
+	struct dlist_node *node = dlist_hash_find(list, key);
+
+	if ( !node )
+		return NULL;
+
+	return dlist_node_take(list, node);
+}/* dlist_hash_remove */
+
+
+struct dlist_list *dlist_hash_split(struct dlist_list *list, void *key)
+{
+	struct dlist_node *node = dlist_hash_find(list, key);
+	struct dlist_node *back = node;
+	struct dlist_node *fwd = node;
+	size_t steps = 0;
+
+	if ( !node )
+		return NULL;
+
+	if ( list->skip && !list->skip->stale )
+		return dlist_list_cut(list, node,
+				      dlist_skip_rank(list, list->skip, node));
+
+	//whichever end is met first gives the rank
+	while ( back && fwd )
+	{
+		back = back->prev;
+		fwd = fwd->next;
+		++steps;
+	}
+
+	return dlist_list_cut(list, node,
+			      (back ? list->count - steps + 1 : steps));
+}/* dlist_hash_split */
+
+
+/****************************************************************************
+ * dlist sorted list interface implementation
+ ****************************************************************************/
+
+
+struct dlist_list *dlist_list_sort(struct dlist_list *list,
+				   dlist_cmp3_func cmp)
+{
+	if ( !list || !list->head || !cmp )
+		return NULL;
+
+	struct dlist_node *iter = NULL;
+	struct dlist_node *prev = NULL;
+
+	list->head = dlist_sort_chain(list->head, cmp);
+
+	//only 'next' was kept while sorting
+	for(iter = list->head; NULL != iter; prev = iter, iter = iter->next)
+		iter->prev = prev;
+
+	list->tail = prev;
+	list->cursor.node = NULL;
+	dlist_skip_stale(list);
+
+	return list;
+}/* dlist_list_sort */
+
+
+struct dlist_list *dlist_list_radix_sort(struct dlist_list *list,
+					 dlist_key_func key, size_t width)
+{
+	if ( !list || !list->head || !key || 0 == width || 8 < width )
+		return NULL;
+
+	dlist_radix_chain(list, key, width);
+	list->cursor.node = NULL;
+	dlist_skip_stale(list);
+
+	return list;
+}/* dlist_list_radix_sort */
+
+
+struct dlist_node *dlist_node_insert_sorted(struct dlist_list *list,
+					    struct dlist_node *node,
+					    dlist_cmp3_func cmp)
+{
+	if ( !list || !node || !cmp )
+		return NULL;
+
+	struct dlist_node *at = NULL;
+	size_t rank;
+
+	//in order input only ever looks at the tail
+	if ( !list->tail || cmp(list->tail->data, node->data) <= 0 )
+		return dlist_node_append(list, node);
+
+	if ( cmp(list->head->data, node->data) > 0 )
+		return dlist_node_push(list, node);
+
+	//the head sorts before 'node', so the walk ends before it
+	for(at = list->tail, rank = list->count;
+	    cmp(at->prev->data, node->data) > 0; --rank)
+		at = at->prev;
+
+	return dlist_node_link_before(list, at, node, rank);
+}/* dlist_node_insert_sorted */
+
+
+struct dlist_node *dlist_node_find_sorted(struct dlist_list *list, void *key,
+					  dlist_cmp3_func cmp)
+{
+	struct dlist_node *node = dlist_node_bound(list, key, cmp, 0);
+
+	if ( !node || 0 != cmp(node->data, key) )
+		return NULL;
+
+	return node;
+}/* dlist_node_find_sorted */
+
+
+struct dlist_node *dlist_node_lower_bound(struct dlist_list *list, void *key,
+					  dlist_cmp3_func cmp)
+{
+	return dlist_node_bound(list, key, cmp, 0);
+}/* dlist_node_lower_bound */
+
+
+struct dlist_node *dlist_node_upper_bound(struct dlist_list *list, void *key,
+					  dlist_cmp3_func cmp)
+{
+	return dlist_node_bound(list, key, cmp, 1);
+}/* dlist_node_upper_bound */
+
+
+struct dlist_list *dlist_list_merge_sorted(struct dlist_list *list,
+					   struct dlist_list *s_list,
+					   dlist_cmp3_func cmp)
+{
+	if ( !list || !s_list || !s_list->head || !cmp )
+		return NULL;
+
+	//nothing to interleave
+	if ( !list->head || cmp(list->tail->data, s_list->head->data) <= 0 )
+		return dlist_list_append(list, s_list);
+
+	struct dlist_node *a = list->head;
+	struct dlist_node *b = s_list->head;
+	struct dlist_node *prev = NULL;
+	struct dlist_node **link = &list->head;
+
+	dlist_stats_move(s_list, list, s_list->count);
+	dlist_hash_merge(list, s_list);
+
+	while ( a && b )
+	{
+		if ( cmp(a->data, b->data) <= 0 ) {
+			*link = a;
+			a = a->next;
+		} else {
+			*link = b;
+			b = b->next;
+		}
+
+		(*link)->prev = prev;
+		prev = *link;
+		link = &prev->next;
+	}
+
+	//whatever is left is already linked and in order
+	*link = (a ? a : b);
+	(*link)->prev = prev;
+	if ( b )
+		list->tail = s_list->tail;
+
+	list->count += s_list->count;
+	list->cursor.node = NULL;
+	dlist_skip_stale(list);
+
+	//empty s_list
+	s_list->head = NULL;
+	s_list->tail = NULL;
+	s_list->count = 0;
+	s_list->cursor.node = NULL;
+	dlist_skip_empty(s_list);
+
+	return list;
+}/* dlist_list_merge_sorted */
+
+
+struct dlist_list *dlist_list_merge_k(struct dlist_list *list,
+				      struct dlist_list **lists, size_t k,
+				      dlist_cmp3_func cmp)
+{
+	if ( !list || !lists || !cmp )
+		return NULL;
+
+	struct dlist_merge_src stack[DLIST_MERGE_K_STACK];
+	struct dlist_merge_src *heap = stack;
+	struct dlist_list *s_list = NULL;
+	struct dlist_node *node = NULL;
+	struct dlist_node *prev = NULL;
+	struct dlist_node **link = &list->head;
+	size_t n = 0;
+
+	if ( DLIST_MERGE_K_STACK < k + 1 &&
+	     NULL == (heap = DLIST_DEF_ALLOC((k + 1) * sizeof( *heap))) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	if ( list->head )
+		heap[n++] = (struct dlist_merge_src){ list->head, list->tail, 0 };
+
+	//every input hands over its bookkeeping before its nodes
+	for(size_t i = 0; i < k; ++i)
+	{
+		if ( NULL == (s_list = lists[i]) || !s_list->head || list == s_list )
+			continue;
+
+		heap[n++] = (struct dlist_merge_src){ s_list->head, s_list->tail,
+							i + 1 };
+		dlist_stats_move(s_list, list, s_list->count);
+		dlist_hash_merge(list, s_list);
+		list->count += s_list->count;
+
+		s_list->head = NULL;
+		s_list->tail = NULL;
+		s_list->count = 0;
+		s_list->cursor.node = NULL;
+		dlist_skip_empty(s_list);
+	}
+
+	for(size_t i = n / 2; i--; )
+		dlist_merge_sift(heap, n, i, cmp);
+
+	//the last input left is linked whole
+	while ( 1 < n )
+	{
+		node = heap[0].node;
+		*link = node;
+		node->prev = prev;
+		prev = node;
+		link = &node->next;
+
+		if ( node->next )
+			heap[0].node = node->next;
+		else
+			heap[0] = heap[--n];
+
+		dlist_merge_sift(heap, n, 0, cmp);
+	}
+
+	if ( n ) {
+		*link = heap[0].node;
+		heap[0].node->prev = prev;
+		list->tail = heap[0].tail;
+	}
+
+	list->cursor.node = NULL;
+	dlist_skip_stale(list);
+
+	if ( heap != stack )
+		DLIST_DEF_DALLOC(heap);
+
+	return list;
+}/* dlist_list_merge_k */
+
+
+/****************************************************************************
+ * dlist inline payload interface implementation
+ ****************************************************************************/
+
+
+struct dlist_node *dlist_node_new_inline(struct dlist_list *list,
+					 const void *data, size_t size)
+{
+#ifdef DLIST_COMPACT_NODE
+	return NULL;
+#else
+	if ( 0 == size || DLIST_INLINE_MAX < size )
+		return NULL;
+
+	struct dlist_node *node = NULL;
+
+	if ( NULL == (node = dlist_alloc(list, sizeof( struct dlist_node) + size)) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	if ( data )
+		memcpy(node->payload, data, size);
+
+	return dlist_node_set(node, node->payload, dlist_inline_dalloc);
+#endif
+}/* dlist_node_new_inline */
+
+
+struct dlist_node *dlist_inline_find(struct dlist_list *list, void *key,
+				     int (*cmp)(void *a, void *b))
+{
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	struct dlist_node *iter;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+	{
+		if ( 0 == cmp(iter->payload, key) )
+			break;
+	}
+
+	return iter;
+}/* dlist_inline_find */
+
+
+struct dlist_node *dlist_inline_remove(struct dlist_list *list, void *key,
+				       int (*cmp)(void *a, void *b))
+{
+	struct dlist_node *node = dlist_inline_find(list, key, cmp);
+
+	if ( !node )
+		return NULL;
+
+	return dlist_node_take(list, node);
+}/* dlist_inline_remove */
+
+
+struct dlist_list *dlist_inline_map(const struct dlist_list *list,
+				    dlist_inline_map_func func, size_t size)
+{
+	if ( !list || !list->head || !func || 0 == size ||
+	     DLIST_INLINE_MAX < size )
+		return NULL;
+
+	struct dlist_list *new_list = dlist_list_new_from(list);
+	if ( !new_list )
+		return NULL;
+
+	struct dlist_node *iter = NULL;
+	struct dlist_node *node = NULL;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+	{
+		if ( NULL == (node = dlist_node_new_inline(new_list, NULL, size)) ) {
+			dlist_list_delete_all_nodes(new_list);
+			dlist_list_delete(new_list);
+			return NULL;
+		}
+
+		func(node->payload, iter->payload);
+		dlist_node_append(new_list, node);
+	}
+
+	return new_list;
+}/* dlist_inline_map */
+
+
+void *dlist_inline_fold(const struct dlist_list *list, void *initial,
+			dlist_fold_func func)
+{
+	if ( !list )
+		return NULL;
+	if ( !func )
+		return initial;
+
+	void *acc = initial;
+	struct dlist_node *iter;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+		acc = func(acc, iter->payload);
+
+	return acc;
+}/* dlist_inline_fold */
+
+
+/****************************************************************************
+ * dlist intrusive interface implementation
+ ****************************************************************************/
+
+
+struct dlist_ilist *dlist_ilist_init(struct dlist_ilist *list)
+{
+	if ( !list )
+		return NULL;
+
+	list->count = 0;
+	list->head = NULL;
+	list->tail = NULL;
+
+	return list;
+}/* dlist_ilist_init */
+
+
+struct dlist_link *dlist_link_push(struct dlist_ilist *list,
+				   struct dlist_link *link)
+{
+	if ( !list || !link )
+		return NULL;
+
+	link->next = list->head;
+	link->prev = NULL;
+
+	//is this our first link ?
+	if ( !list->head )
+		list->tail = link;
+	else
+		list->head->prev = link;
+
+	list->head = link;
+	++list->count;
+
+	return link;
+}/* dlist_link_push */
+
+
+struct dlist_link *dlist_link_append(struct dlist_ilist *list,
+				     struct dlist_link *link)
+{
+	if ( !list || !link )
+		return NULL;
+
+	link->next = NULL;
+	link->prev = list->tail;
+
+	//check add @ head
+	if ( !list->tail )
+		list->head = link;
+	else
+		list->tail->next = link;
+
+	list->tail = link;
+	++list->count;
+
+	return link;
+}/* dlist_link_append */
+
+
+struct dlist_link *dlist_link_pop(struct dlist_ilist *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	return dlist_link_unlink(list, list->head);
+}/* dlist_link_pop */
+
+
+struct dlist_link *dlist_link_unlink(struct dlist_ilist *list,
+				     struct dlist_link *link)
+{
+	if ( !list || !link )
+		return NULL;
+
+	if ( link->prev )
+		link->prev->next = link->next;
+	else
+		list->head = link->next;
+
+	if ( link->next )
+		link->next->prev = link->prev;
+	else
+		list->tail = link->prev;
+
+	link->next = NULL;
+	link->prev = NULL;
+	--list->count;
+
+	return link;
+}/* dlist_link_unlink */
+
+
+struct dlist_link *dlist_link_find(struct dlist_ilist *list, void *key,
+				   dlist_link_cmp_func cmp)
+{
+	if ( !list || !list->head || !cmp )
+		return NULL;
+
+	struct dlist_link *iter;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+	{
+		if ( 0 == cmp(iter, key) )
+			break;
+	}
+
+	return iter;
+}/* dlist_link_find */
+
+
+struct dlist_link *dlist_link_remove(struct dlist_ilist *list, void *key,
+				     dlist_link_cmp_func cmp)
+{
+	struct dlist_link *link = dlist_link_find(list, key, cmp);
+
+	if ( !link )
+		return NULL;
+
+	return dlist_link_unlink(list, link);
+}/* dlist_link_remove */
+
+
+void dlist_link_foreach(struct dlist_ilist *list,
+			dlist_link_action_func action, void *param)
+{
+	if ( !list || !list->head || !action )
+		return;
+
+	struct dlist_link *iter = NULL;
+	struct dlist_link *next = NULL;
+	void *carry = NULL;
+
+	for(iter = list->head; NULL != iter; iter = next)
+	{
+		next = iter->next;
+		carry = action(carry, iter, param);
+	}
+}/* dlist_link_foreach */
+
+
+struct dlist_ilist *dlist_ilist_reverse(struct dlist_ilist *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	struct dlist_link *link = NULL;
+	struct dlist_link *head = list->head;
+	while ( head )
+	{
+		link = head->prev;
+		head->prev = head->next;
+		head->next = link;
+		head = head->prev;
+	}
+
+	//set new head and return
+	link = list->tail;
+	list->tail = list->head;
+	list->head = link;
+
+	return list;
+}/* dlist_ilist_reverse */
+
+
+struct dlist_ilist *dlist_ilist_append(struct dlist_ilist *list,
+				       struct dlist_ilist *s_list)
+{
+	if ( !list || !s_list || !s_list->head )
+		return NULL;
+
+	if ( !list->head ) {
+		list->head = s_list->head;
+	} else {
+		list->tail->next = s_list->head;
+		s_list->head->prev = list->tail;
+	}
+
+	list->tail = s_list->tail;
+	list->count += s_list->count;
+
+	dlist_ilist_init(s_list);
+	return list;
+}/* dlist_ilist_append */
+
+
+//moves 'link' and everything after it from 'list' into 'n_list'
+static struct dlist_ilist *dlist_ilist_cut(struct dlist_ilist *list,
+					   struct dlist_link *link,
+					   size_t index,
+					   struct dlist_ilist *n_list)
+{
+	n_list->head = link;
+	n_list->tail = list->tail;
+	n_list->count = list->count - index + 1;
+
+	list->tail = link->prev;
+	list->count = index - 1;
+	if ( list->tail )
+		list->tail->next = NULL;
+	else
+		list->head = NULL;
+
+	link->prev = NULL;
+	return n_list;
+}/* dlist_ilist_cut */
+
+
+struct dlist_ilist *dlist_ilist_split(struct dlist_ilist *list, void *key,
+				      dlist_link_cmp_func cmp,
+				      struct dlist_ilist *n_list)
+{
+	if ( !list || !list->head || !cmp || !n_list )
+		return NULL;
+
+	struct dlist_link *iter;
+	size_t idx = 1;
+
+	for(iter = list->head; NULL != iter; iter = iter->next, ++idx)
+	{
+		if ( 0 == cmp(iter, key) )
+			return dlist_ilist_cut(list, iter, idx, n_list);
+	}
+
+	return NULL;
+}/* dlist_ilist_split */
+
+
+struct dlist_ilist *dlist_ilist_split_at(struct dlist_ilist *list,
+					 const size_t index,
+					 struct dlist_ilist *n_list)
+{
+	if ( !list || !list->head || 0 == index || index > list->count ||
+	     !n_list )
+		return NULL;
+
+	struct dlist_link *link = NULL;
+	size_t idx;
+
+	//walk from whichever end is closer
+	if ( index <= list->count / 2 ) {
+		link = list->head;
+		for(idx = 1; idx < index; ++idx)
+			link = link->next;
+	} else {
+		link = list->tail;
+		for(idx = list->count; idx > index; --idx)
+			link = link->prev;
+	}
+
+	return dlist_ilist_cut(list, link, index, n_list);
+}/* dlist_ilist_split_at */
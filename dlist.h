@@ -28,11 +28,42 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
+#include "allocator.h"
 
 #define DLIST_DEF_ALLOC malloc
 #define DLIST_DEF_DALLOC free
 
+//biggest payload dlist_node_new_inline copies into a node
+#define DLIST_INLINE_MAX 64
+
+/* data pointers the _batch functions gather on the stack before each
+ * call, see dlist_node_foreach_batch. may be defined before including
+ */
+#ifndef DLIST_BATCH_SIZE
+#define DLIST_BATCH_SIZE 64
+#endif
+
+/* define DLIST_COMPACT_NODE to drop 'data_dalloc' from every node.
+ * 'data' is then deleted by the 'list' wide 'data_dalloc' alone,
+ * see dlist_data_dalloc. saves a pointer per node.
+ * inline nodes need that pointer, see dlist_node_new_inline
+ */
+
+/* define DLIST_STATS to have every list count the node traffic going
+ * through its allocator, see dlist_get_stats.
+ */
+
+//list size from which starting a thread pays off, see dlist_node_fast_find_mt
+#define DLIST_FIND_MT_THRESHOLD 65536
+
+//levels of the positional index, enough for 4^DLIST_SKIP_LEVELS nodes
+#ifndef DLIST_SKIP_LEVELS
+#define DLIST_SKIP_LEVELS 16
+#endif
+
 
 /****************************************************************************
  * base data structures
@@ -44,7 +75,41 @@ struct dlist_node
 	void *data;
 	struct dlist_node *next;
 	struct dlist_node *prev;
+#ifndef DLIST_COMPACT_NODE
 	void (*data_dalloc)(void *);
+#endif
+	//only used by inline nodes, see dlist_node_new_inline
+	unsigned char payload[];
+};
+
+//node traffic of a list, only kept with DLIST_STATS defined
+struct dlist_stats
+{
+	size_t allocs;
+	size_t dallocs;
+	//nodes taken and not given back yet, cached ones included
+	size_t live;
+	size_t peak;
+	//node bytes requested from the allocator, list itself excluded
+	size_t bytes;
+	//'data' handed to a 'data_dalloc'
+	size_t data_dallocs;
+};
+
+//positional index, private to dlist.c, see dlist_skip_attach
+struct dlist_skip;
+//key index, private to dlist.c, see dlist_hash_attach
+struct dlist_hash;
+
+/* last position looked up, positional calls walk from it when it is
+ * closer than either end. every operation keeps it pointing at the right
+ * place, or clears it.
+ */
+struct dlist_cursor
+{
+	//NULL when there is no position to start from
+	struct dlist_node *node;
+	size_t index;
 };
 
 struct dlist_list
@@ -54,8 +119,49 @@ struct dlist_list
 	struct dlist_node *tail;
 	void *(*node_alloc)(size_t);
 	void (*node_dalloc)(void *);
+	const struct dutils_allocator *allocator;
+	//deletes 'data' of nodes without their own, see dlist_data_dalloc
+	void (*data_dalloc)(void *);
+	//recycled nodes, see dlist_cache_limit
+	struct dlist_node *cache;
+	size_t cache_count;
+	size_t cache_max;
+	//NULL unless an index is attached, see dlist_skip_attach
+	struct dlist_skip *skip;
+	//NULL unless an index is attached, see dlist_hash_attach
+	struct dlist_hash *hash;
+	struct dlist_cursor cursor;
+#ifdef DLIST_STATS
+	struct dlist_stats stats;
+#endif
+};
+
+/* intrusive variant: 'dlist_link' is embedded in the user structure, so a
+ * single allocation holds both the element and its links.
+ * see dlist_container_of to get back to the embedding structure.
+ */
+struct dlist_link
+{
+	struct dlist_link *next;
+	struct dlist_link *prev;
 };
 
+struct dlist_ilist
+{
+	size_t count;
+	struct dlist_link *head;
+	struct dlist_link *tail;
+};
+
+/* returns a pointer to the 'type' structure embedding 'ptr' as 'member'
+ * example: ******************************************************************
+ * -------- struct item { int key; struct dlist_link link; };
+ * -------- struct item *it = dlist_container_of(link, struct item, link);
+ * -------- ******************************************************************
+ */
+#define dlist_container_of(ptr, type, member) \
+	((type *)((char *)(ptr) - offsetof(type, member)))
+
 /****************************************************************************
  * conviniente data types for library consumers/users
  ****************************************************************************/
@@ -63,6 +169,10 @@ struct dlist_list
 
 typedef struct dlist_node dlist_node_t;
 typedef struct dlist_list dlist_list_t;
+typedef struct dlist_stats dlist_stats_t;
+typedef struct dlist_cursor dlist_cursor_t;
+typedef struct dlist_link dlist_link_t;
+typedef struct dlist_ilist dlist_ilist_t;
 
 /****************************************************************************
  * functional operations typedefs
@@ -71,6 +181,33 @@ typedef struct dlist_list dlist_list_t;
 typedef void *(*dlist_map_func)(void *data);
 typedef bool (*dlist_filter_func)(void *data);
 typedef void *(*dlist_fold_func)(void *acc, void *data);
+//writes the result of mapping 'src' payload into 'dst' payload
+typedef void (*dlist_inline_map_func)(void *dst, void *src);
+//needs to return the same value for 'data' and the keys matching it
+typedef size_t (*dlist_hash_func)(void *data);
+//needs to return <0, 0 or >0 when 'a' sorts before, with or after 'b'
+typedef int (*dlist_cmp3_func)(void *a, void *b);
+//returns the unsigned integer 'data' sorts by, see dlist_list_radix_sort
+typedef uint64_t (*dlist_key_func)(void *data);
+//batched forms, 'n' consecutive 'data' pointers at a time
+typedef void *(*dlist_batch_action_func)(void *carry, void **data, size_t n,
+					 void *param);
+//writes what 'src'[i] maps to in 'dst'[i], for every i under 'n'
+typedef void (*dlist_batch_map_func)(void **dst, void **src, size_t n);
+typedef void *(*dlist_batch_fold_func)(void *acc, void **data, size_t n);
+//returns the result of folding 'a' and then 'b', see dlist_fold_parallel
+typedef void *(*dlist_combine_func)(void *a, void *b);
+//returns a new accumulator nothing was folded into yet
+typedef void *(*dlist_identity_func)(void);
+
+/****************************************************************************
+ * intrusive operations typedefs
+ ****************************************************************************/
+
+//needs to return 0 when the element embedding 'link' matches 'key'
+typedef int (*dlist_link_cmp_func)(struct dlist_link *link, void *key);
+typedef void *(*dlist_link_action_func)(void *carry, struct dlist_link *link,
+					void *param);
 
 
 /****************************************************************************
@@ -110,6 +247,51 @@ struct dlist_list *dlist_list_new(void *(*node_alloc)(size_t),
 				  void (*node_dalloc)(void *));
 
 
+/* returns 'list' initialized to allocate its 'nodes' through 'allocator'
+ * NULL is returned if 'list' is NULL
+ * passing NULL to 'allocator' behaves like dlist_init(list, NULL, NULL)
+ *
+ * ABOUT ['allocator']: only a pointer is kept, see allocator.h.
+ * ------- 'node_alloc' and 'node_dalloc' are set to NULL and ignored.
+ *
+ * passing invalid ['list' or 'allocator']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_init_allocator(struct dlist_list *list,
+					const struct dutils_allocator *allocator);
+
+
+/* returns a new allocated 'list' that allocates its 'nodes' through
+ * ------- 'allocator'. the returned 'list' has to be freed
+ * passing NULL to 'allocator' behaves like dlist_list_new(NULL, NULL)
+ * NULL is returned if DLIST_DEF_ALLOC fails to allocate memory.
+ *
+ * ABOUT ['list'] _memory_ : the 'list' itself always comes from
+ * ------- DLIST_DEF_ALLOC, so 'allocator' only ever sees node sized
+ * ------- requests. dlist_list_delete knows how to release it.
+ *
+ * passing invalid ['allocator']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_list_new_allocator(const struct dutils_allocator *allocator);
+
+
+/* returns 'list' after setting 'data_dalloc' to delete the 'data' of
+ * ------- every 'node' that has no 'dalloc' of its own.
+ * returns NULL if 'list' is NULL
+ * passing NULL in 'data_dalloc' unsets it, which is the default.
+ *
+ * NOTE: meant to be set right after the 'list' is created. with
+ * ------- DLIST_COMPACT_NODE defined this is the only destructor there is.
+ * ------- dlist_list_split and dlist_list_split_at hand it to the new list.
+ *
+ * passing invalid ['list' or 'data_dalloc']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_data_dalloc(struct dlist_list *list,
+				     void (*data_dalloc)(void *));
+
+
 /* returns a new allocated 'node' initialized with 'data' and 'dalloc'
  * ------- returned 'node' needs to be freed
  * passing NULL in 'data' sets 'node' 'data' to NULL
@@ -117,6 +299,8 @@ struct dlist_list *dlist_list_new(void *(*node_alloc)(size_t),
  * ------- if 'dalloc' is set, _delete_ functions attempt to delete 'data
  * ------- check each _delete_ function documentation for better information
  *
+ * NOTE: 'dalloc' is ignored with DLIST_COMPACT_NODE, see dlist_data_dalloc
+ *
  * passing invalid ['list' or 'data' or 'dalloc']
  * ------- results in undefined behavior
  */
@@ -138,7 +322,9 @@ void dlist_node_print(const struct dlist_node *node,
 
 
 /* deletes 'node'
- * attempts to delete 'data' when 'data_dalloc' is set.
+ * attempts to delete 'data' when 'data_dalloc' is set, falling back to
+ * ------- the 'list' one, see dlist_data_dalloc.
+ * keeps 'node' in the 'list' cache when it has room, see dlist_cache_limit
  * passing NULL in 'list' returns with no operation executed
  * passing NULL in 'node' returns with no operation executed
  *
@@ -154,6 +340,7 @@ void dlist_node_delete(struct dlist_list *list,
  *
  * NOTE: deleting the 'list' won't free the 'nodes' contained in it.
  * ------- see dlist_list_delete_all_nodes for that.
+ * ------- nodes held by the 'list' cache are freed, and so are its indexes.
  *
  * passing invalid ['list']
  * ------- results in undefined behavior
@@ -215,7 +402,8 @@ struct dlist_node *dlist_node_find(struct dlist_list *list, void *key,
 /* NOTE: this function can be faster then regular dlist_node_find
  * because it performes a bidirectional search, therefor if the
  * list contains duplication it will return which ever is closer
- * to the edges.
+ * to the edges. head and tail take turns, one step each, until
+ * they meet halfway.
  *
  * returns the 'node' matching 'key'
  * returns NULL if 'key' is not found
@@ -233,6 +421,25 @@ struct dlist_node *dlist_node_fast_find(struct dlist_list *list, void *key,
 					int (*cmp)(void *a, void *b));
 
 
+/* same as dlist_node_fast_find, with the half nearest the tail searched
+ * ------- on a second thread while the calling one searches the other.
+ * ------- both stop as soon as either finds 'key'.
+ * lists holding fewer than 'threshold' nodes are searched on the calling
+ * ------- thread alone, see DLIST_FIND_MT_THRESHOLD for a sane value.
+ * falls back to dlist_node_fast_find when the thread can't be created.
+ *
+ * NOTE: when both halves hold 'key' either match may be returned, the
+ * ------- half finding one first stops the other. 'cmp' runs on two
+ * ------- threads at once and 'list' must not change meanwhile.
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_node_fast_find_mt(struct dlist_list *list, void *key,
+					   int (*cmp)(void *a, void *b),
+					   size_t threshold);
+
+
 /* returns the 'index' of 'key' in 'list'
  * returns 0 if 'list' is NULL.
  * returns 0 if 'list' is empty.
@@ -274,7 +481,10 @@ struct dlist_node *dlist_node_remove(struct dlist_list *list, void *key,
  * returns NULL if 'list' is empty.
  * returns NULL if 'index' is out of bounds.
  *
- * ABOUT ['index']: starts counting at 1
+ * ABOUT ['index']: starts counting at 1. walks from the closest of head,
+ * ------- tail and cursor, or takes O(log n) with an index attached
+ * ------- when none of them is close, see dlist_skip_attach.
+ * ------- the cursor is left on the 'node' before the removed one.
  *
  * passing invalid ['list' or 'index']
  * ------- results in undefined behavior
@@ -308,10 +518,26 @@ void dlist_node_foreach(struct dlist_list *list,
 			void *param);
 
 
+/* same as dlist_node_foreach, 'action' being called once for every
+ * ------- DLIST_BATCH_SIZE 'nodes', or less for the last call.
+ *
+ * ABOUT ['action']: receives the 'data' of 'n' consecutive 'nodes' in
+ * ------- order, 'data' is only valid until 'action' returns.
+ *
+ * passing invalid ['list' or 'action' or 'param']
+ * ------- results in undefined behavior
+ */
+void dlist_node_foreach_batch(struct dlist_list *list,
+			      dlist_batch_action_func action, void *param);
+
+
 /* returns an empty 'list' after deleting all 'nodes' contained in it.
  * returns NULL if 'list' is NULL
  * returns NULL if 'list' is empty
  *
+ * NOTE: when 'list' allocator provides 'bulk_dalloc' the 'nodes' are
+ * ------- released in batches instead of one at a time.
+ *
  * ABOUT ['list'] _status_ : still needs to be freed if it was allocated with
  * ------- dlist_list_new. see dlist_list_delete documentation for more info.
  *
@@ -321,6 +547,29 @@ void dlist_node_foreach(struct dlist_list *list,
 struct dlist_list *dlist_list_delete_all_nodes(struct dlist_list *list);
 
 
+/* returns an empty 'list' after releasing all 'nodes' contained in it.
+ * returns NULL if 'list' is NULL
+ *
+ * ABOUT ['data_owned']: when true the 'data' of each 'node' is known to
+ * ------- live in the same arena as the 'nodes' (or to be owned elsewhere)
+ * ------- and 'data_dalloc' is not called.
+ * ABOUT [arena mode]: when 'list' allocator provides 'reset' (see arena.h)
+ * ------- the 'nodes' are not freed one by one, the allocator is reset
+ * ------- instead. with 'data_owned' set this takes O(1) node visits.
+ * ------- otherwise it behaves like dlist_list_delete_all_nodes, node
+ * ------- cache and bulk_dalloc included, 'data_owned' still honored.
+ *
+ * NOTE: lists split off or mapped from an arena backed 'list' share its
+ * ------- arena, resetting one of them drops the 'nodes' of every one.
+ * ------- the others are left dangling and have to be reset as well,
+ * ------- with 'data_owned' set, before the arena hands out new blocks.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_list_reset(struct dlist_list *list, bool data_owned);
+
+
 /* returns 'list' reversed
  * example: ******************************************************************
  * -------- if your list configuration was (head perspective)
@@ -350,6 +599,21 @@ struct dlist_list *dlist_list_reverse(struct dlist_list *list);
 size_t dlist_get_size(struct dlist_list *list);
 
 
+/* returns true after copying the 'list' counters into 'stats'
+ * returns false if 'list' or 'stats' are NULL
+ * returns false if built without DLIST_STATS, 'stats' is left untouched
+ *
+ * ABOUT [counters]: kept from the moment 'list' is set up. nodes moved by
+ * ------- split and list push/append take their 'live' count along; nodes
+ * ------- carried to another list by hand count against the one freeing them.
+ * ------- the 'list' itself is not counted, only its nodes.
+ *
+ * passing invalid ['list' or 'stats']
+ * ------- results in undefined behavior
+ */
+bool dlist_get_stats(const struct dlist_list *list, struct dlist_stats *stats);
+
+
 /* returns 'list' after merging 's_list' into 'list' head
  * returns NULL if 'list' is NULL.
  * returns NULL if 's_list' is NULL.
@@ -421,6 +685,8 @@ struct dlist_list *dlist_list_append(struct dlist_list *list,
  *
  * ---info makes 'list' empty if 'key' matches @ head
  * ---info  the newly allocated list has to be freed. see dlist_list_delete
+ * ---info the new list allocates as 'list' does, arena included.
+ * ------- see dlist_list_reset
  *
  * ABOUT ['cmp']: function needs to return 0 when 'a' and 'b' match
  * example: ******************************************************************
@@ -448,6 +714,10 @@ struct dlist_list *dlist_list_split(struct dlist_list *list, void *key,
  *
  * ---info makes 'list' empty if 'index' is 1/head
  * ---info the newly allocated list has to be freed. see dlist_list_delete
+ * ---info the new list allocates as 'list' does, arena included.
+ * ------- see dlist_list_reset
+ * ---info with an index attached 'index' is found in O(log n) and both
+ * ------- lists come out indexed, see dlist_skip_attach
  *
  * ABOUT ['cmp']: function needs to return 0 when 'a' and 'b' match
  *
@@ -469,6 +739,10 @@ struct dlist_list *dlist_list_split_at(struct dlist_list *list,
 /* returns a new list with each element transformed by 'func'
  * returns NULL if 'list' is NULL or allocation fails
  * 'dalloc' is used for the new data; if NULL, no deallocator is set
+ * ------- it becomes the new list 'data_dalloc' as well
+ *
+ * NOTE: the new list allocates as 'list' does, arena included.
+ * ------- see dlist_list_reset
  *
  * passing invalid ['list' or 'func']
  * ------- results in undefined behavior
@@ -478,6 +752,8 @@ struct dlist_list *dlist_map(const struct dlist_list *list, dlist_map_func func,
 /* returns a new list with elements that pass 'func' predicate
  * returns NULL if 'list' is NULL or allocation fails
  *
+ * NOTE: allocates as dlist_map does
+ *
  * passing invalid ['list' or 'func']
  * ------- results in undefined behavior
  */
@@ -492,4 +768,676 @@ struct dlist_list *dlist_filter(const struct dlist_list *list, dlist_filter_func
  */
 void *dlist_fold(const struct dlist_list *list, void *initial, dlist_fold_func func);
 
+/* returns 'list' after replacing the 'data' of each 'node' with what
+ * ------- 'func' returns for it, in a single pass and with no allocation.
+ * returns NULL if 'list' is NULL or empty
+ * returns NULL if 'func' is NULL
+ *
+ * ABOUT ['dalloc_old']: when true the old 'data' is deleted the same way
+ * ------- dlist_node_delete would, unless 'func' handed it back as is.
+ *
+ * NOTE: 'data_dalloc' of 'list' and of each 'node' are kept, so they have
+ * ------- to be able to delete the new 'data'. the hash index, if any,
+ * ------- is rebuilt on its next use, see dlist_hash_attach.
+ *
+ * passing invalid ['list' or 'func']
+ * ------- passing a 'list' holding inline nodes, see dlist_node_new_inline
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_map_inplace(struct dlist_list *list,
+				     dlist_map_func func, bool dalloc_old);
+
+/* returns 'list' after deleting, see dlist_node_delete, every 'node'
+ * ------- whose 'data' fails the 'func' predicate. single pass, no allocation.
+ * returns NULL if 'list' is NULL or empty
+ * returns NULL if 'func' is NULL
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_filter_inplace(struct dlist_list *list,
+					dlist_filter_func func);
+
+/* same as dlist_map, 'func' mapping up to DLIST_BATCH_SIZE elements
+ * ------- per call, see dlist_batch_map_func.
+ * returns NULL if 'list' is NULL or empty, 'func' is NULL or allocation fails
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_map_batch(const struct dlist_list *list,
+				   dlist_batch_map_func func,
+				   void (*dalloc)(void *));
+
+/* same as dlist_fold, 'func' folding up to DLIST_BATCH_SIZE elements
+ * ------- per call.
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+void *dlist_fold_batch(const struct dlist_list *list, void *initial,
+		       dlist_batch_fold_func func);
+
+/* same as dlist_fold, with 'list' split in up to 'nthreads' contiguous
+ * ------- segments, each folded by a thread of its own, the partial
+ * ------- results then being combined in order with 'combine'.
+ * returns NULL if 'list' is NULL
+ * returns 'initial' if 'func' is NULL
+ * returns NULL if 'combine' or 'identity' are NULL
+ * passing 0 in 'nthreads' uses one thread per online cpu
+ *
+ * ABOUT ['func']: the same as dlist_fold takes. calls run concurrently,
+ * ------- so must not share unguarded state.
+ * ABOUT ['identity']: only the first segment folds into 'initial', every
+ * ------- other one folds into what 'identity' returns for it.
+ * ABOUT ['combine']: receives the partial results of neighbouring
+ * ------- segments, left one first. needs the fold to be associative.
+ * ------- 'b' always comes from 'identity' and is owned by 'combine',
+ * ------- which has to delete it before returning.
+ * ABOUT [threads]: segments are at least a thousand nodes or so, shorter
+ * ------- lists are folded on the calling thread. segments are found in a
+ * ------- single walk, each thread starting as soon as its head is.
+ *
+ * NOTE: 'list' must not change until it returns.
+ *
+ * passing invalid ['list' or 'func' or 'combine' or 'identity']
+ * ------- results in undefined behavior
+ */
+void *dlist_fold_parallel(const struct dlist_list *list, void *initial,
+			  dlist_fold_func func, dlist_combine_func combine,
+			  dlist_identity_func identity, size_t nthreads);
+
+/* same as dlist_map, with 'list' split in up to 'nthreads' contiguous
+ * ------- segments, each mapped into a sub-list by a thread of its own.
+ * ------- the sub-lists are then joined in order, see dlist_list_append,
+ * ------- so the result matches dlist_map exactly.
+ * returns NULL if 'list' is NULL or empty, 'func' is NULL or allocation fails
+ * passing 0 in 'nthreads' uses one thread per online cpu
+ *
+ * ABOUT ['func']: calls run concurrently, so must not share unguarded state
+ * ABOUT [threads]: as in dlist_fold_parallel
+ *
+ * NOTE: nodes are allocated from every thread at once, the 'list'
+ * ------- allocator has to be thread safe, see magazine.h.
+ * ------- 'list' must not change until it returns.
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_map_parallel(const struct dlist_list *list,
+				      dlist_map_func func,
+				      void (*dalloc)(void *), size_t nthreads);
+
+/* same as dlist_filter, split across threads as dlist_map_parallel is
+ * returns NULL if 'list' is NULL or empty, 'func' is NULL or allocation fails
+ * passing 0 in 'nthreads' uses one thread per online cpu
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_filter_parallel(const struct dlist_list *list,
+					 dlist_filter_func func,
+					 size_t nthreads);
+
+
+/****************************************************************************
+ * node cache interface and _base_ documentation
+ *
+ * a 'list' may keep up to 'cache_max' deleted 'nodes' around, and hand
+ * them back on dlist_node_new before asking its allocator. push/pop work
+ * queues then reach a steady state with no allocator calls at all.
+ * inline nodes are never cached, their size varies.
+ ****************************************************************************/
+
+/* returns 'list' after bounding its node cache to 'max' nodes.
+ * returns NULL if 'list' is NULL
+ * passing 0 in 'max' disables the cache, which is the default.
+ *
+ * NOTE: cached nodes above 'max' are freed.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_cache_limit(struct dlist_list *list, size_t max);
+
+
+/* returns the number of cached nodes freed to leave at most 'keep'
+ * ------- in the 'list' cache.
+ * returns 0 if 'list' is NULL
+ *
+ * NOTE: 'lists' set up with dlist_init need dlist_cache_trim(list, 0)
+ * ------- before going away, dlist_list_delete does it on its own.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+size_t dlist_cache_trim(struct dlist_list *list, size_t keep);
+
+
+/****************************************************************************
+ * positional index interface and _base_ documentation
+ *
+ * an index is an indexable skip list laid over the 'nodes' of a 'list':
+ * about one 'node' in four gets a tower of levels, each level knowing how
+ * many 'nodes' it skips. positional lookups then take O(log n) instead of
+ * a walk. push, append, pop, remove, remove_at and split keep the index
+ * up to date; operations moving many 'nodes' at once (reverse, list
+ * push/append, reset) drop it and it is rebuilt, in O(n), on next use.
+ * towers come from DLIST_DEF_ALLOC, never from the 'list' allocator.
+ * a 'list' without an index pays a single NULL check per operation.
+ ****************************************************************************/
+
+/* returns 'list' after building an index over its 'nodes', O(n).
+ * returns NULL if 'list' is NULL
+ * returns NULL if allocation fails, 'list' is left without an index
+ * attaching to an indexed 'list' rebuilds its index.
+ *
+ * NOTE: 'lists' set up with dlist_init need dlist_skip_detach before
+ * ------- going away, dlist_list_delete does it on its own.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_skip_attach(struct dlist_list *list);
+
+
+/* frees the 'list' index, the 'nodes' are left as they are.
+ * passing NULL or a 'list' without index returns with no operation executed
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+void dlist_skip_detach(struct dlist_list *list);
+
+
+/* returns the 'node' stored in 'index' position
+ * returns NULL if 'list' is NULL.
+ * returns NULL if 'list' is empty.
+ * returns NULL if 'index' is out of bounds.
+ *
+ * ABOUT ['index']: starts counting at 1. walks from the closest of head,
+ * ------- tail and cursor, or takes O(log n) with an index attached
+ * ------- when none of them is close. the cursor is left on the 'node'
+ * ------- returned, so near-sequential access costs O(1) per call.
+ *
+ * passing invalid ['list' or 'index']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_node_get_at(struct dlist_list *list,
+				     const size_t index);
+
+
+/* returns the 'index' of 'node' in 'list'
+ * returns 0 if 'list' or 'node' are NULL.
+ *
+ * ABOUT [index]: starts at 1, 0 is reserved (see above). O(log n) with
+ * ------- an index attached, otherwise walks back to the head or the
+ * ------- cursor. the cursor is left on 'node'.
+ *
+ * passing a 'node' not contained in 'list'
+ * ------- results in undefined behavior
+ */
+size_t dlist_node_index_of(struct dlist_list *list,
+			   const struct dlist_node *node);
+
+
+/****************************************************************************
+ * key index interface and _base_ documentation
+ *
+ * a hash index maps the 'data' of every 'node' of a 'list' to the 'node'
+ * holding it, with open addressing. the functions below then find, remove
+ * and split by key in O(1) expected time instead of calling 'cmp' on each
+ * 'node'. push, append, pop, remove, remove_at, split, list push/append
+ * and delete keep the index up to date, reordering needs no update.
+ * a 'list' without an index pays a single NULL check per operation.
+ ****************************************************************************/
+
+/* returns 'list' after building an index over its 'nodes', O(n).
+ * returns NULL if 'list', 'hash' or 'cmp' are NULL
+ * returns NULL if allocation fails, 'list' is left without an index
+ * attaching to an indexed 'list' replaces its index.
+ *
+ * ABOUT ['hash']: called with the 'data' of each 'node' and with the
+ * ------- 'key' of each lookup, so every 'data' must be hashable.
+ * ABOUT ['cmp']: function needs to return 0 when 'a' and 'b' match,
+ * ------- 'a' being a 'node' 'data' and 'b' the 'key'.
+ *
+ * NOTE: 'lists' set up with dlist_init need dlist_hash_detach before
+ * ------- going away, dlist_list_delete does it on its own.
+ * ------- 'data' must not change its key while in the 'list'.
+ *
+ * passing invalid ['list' or 'hash' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_hash_attach(struct dlist_list *list,
+				     dlist_hash_func hash,
+				     int (*cmp)(void *a, void *b));
+
+
+/* frees the 'list' index, the 'nodes' are left as they are.
+ * passing NULL or a 'list' without index returns with no operation executed
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+void dlist_hash_detach(struct dlist_list *list);
+
+
+/* returns the 'node' matching 'key'
+ * returns NULL if 'key' is not found
+ * returns NULL if 'list' is NULL or has no index attached.
+ *
+ * NOTE: with duplicated keys any of the matching 'nodes' may be returned.
+ *
+ * passing invalid ['list' or 'key']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_hash_find(struct dlist_list *list, void *key);
+
+
+/* returns the 'node' matching 'key' removing it.
+ * returns NULL if 'key' is not found
+ * returns NULL if 'list' is NULL or has no index attached.
+ *
+ * NOTE: with duplicated keys any of the matching 'nodes' may be removed.
+ *
+ * passing invalid ['list' or 'key']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_hash_remove(struct dlist_list *list, void *key);
+
+
+/* same as dlist_list_split, the 'node' matching 'key' found through
+ * ------- the index. returns NULL if 'list' has no index attached.
+ *
+ * NOTE: both lists come out indexed. entries of the shorter of the two
+ * ------- change tables, so the cost is that of walking it.
+ *
+ * passing invalid ['list' or 'key']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_hash_split(struct dlist_list *list, void *key);
+
+
+/****************************************************************************
+ * sorted list interface and _base_ documentation
+ *
+ * a 'list' kept in 'cmp' order, using a three-way comparator instead of
+ * the equal/not-equal one. lookups then stop as soon as they walk past the
+ * place 'key' would be in, and two sorted lists merge in O(n + m).
+ * 'cmp' always gets a 'node' 'data' as 'a' and a 'key' (or the 'data' of
+ * the 'node' being placed) as 'b'. using an unsorted 'list', or a 'cmp'
+ * other than the one it was sorted with, results in undefined behavior.
+ ****************************************************************************/
+
+/* returns 'list' after sorting its 'nodes' by 'cmp'
+ * returns NULL if 'list' or 'cmp' are NULL
+ * returns NULL if 'list' is empty
+ *
+ * ABOUT [sorting]: bottom-up merge sort relinking the 'nodes' in place,
+ * ------- O(n log n) time and no allocation at all. it is stable, equal
+ * ------- 'nodes' keep their order.
+ *
+ * passing invalid ['list' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_list_sort(struct dlist_list *list,
+				   dlist_cmp3_func cmp);
+
+
+/* returns 'list' after sorting its 'nodes' by the integer 'key' gives
+ * ------- for their 'data', smallest first.
+ * returns NULL if 'list' or 'key' are NULL
+ * returns NULL if 'list' is empty
+ * returns NULL if 'width' is 0 or bigger than 8
+ *
+ * ABOUT ['width']: the number of low bytes of each key that take part,
+ * ------- 4 for 32-bit keys. higher bytes are ignored.
+ * ABOUT [sorting]: LSD radix sort relinking the 'nodes' through 256
+ * ------- buckets, one pass per key byte, O(n * 'width') and no allocation.
+ * ------- the first pass also finds the bytes equal on every key, the
+ * ------- passes for those are skipped. it is stable. 'key' runs once per
+ * ------- 'node' on each pass, so it should be cheap.
+ *
+ * NOTE: keys compare as unsigned. for signed keys flip the sign bit
+ * ------- in 'key', ('value' ^ (1ULL << 63)) for 64-bit ones.
+ *
+ * passing invalid ['list' or 'key']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_list_radix_sort(struct dlist_list *list,
+					 dlist_key_func key, size_t width);
+
+
+/* returns 'node' after linking it into 'list' after every 'node' that
+ * ------- sorts before or with it, so equal 'nodes' keep insertion order.
+ * returns NULL if 'list', 'node' or 'cmp' are NULL
+ *
+ * NOTE: 'nodes' sorting after the tail or before the head take O(1),
+ * ------- the rest walk back from the tail.
+ *
+ * passing invalid ['list' or 'node' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_node_insert_sorted(struct dlist_list *list,
+					    struct dlist_node *node,
+					    dlist_cmp3_func cmp);
+
+
+/* returns the first 'node' matching 'key'
+ * returns NULL if 'key' is not found
+ * returns NULL if 'list', 'key' or 'cmp' are NULL
+ *
+ * NOTE: gives up at the first 'node' sorting after 'key', and right
+ * ------- away when the tail sorts before it.
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_node_find_sorted(struct dlist_list *list, void *key,
+					  dlist_cmp3_func cmp);
+
+
+/* returns the first 'node' not sorting before 'key'
+ * returns NULL if every 'node' sorts before 'key'
+ * returns NULL if 'list', 'key' or 'cmp' are NULL
+ *
+ * NOTE: the 'list' cursor is left on the returned 'node', so its index
+ * ------- is then O(1), see dlist_node_index_of. linking before it keeps
+ * ------- the 'list' sorted.
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_node_lower_bound(struct dlist_list *list, void *key,
+					  dlist_cmp3_func cmp);
+
+
+/* returns the first 'node' sorting after 'key'
+ * returns NULL if no 'node' sorts after 'key'
+ * returns NULL if 'list', 'key' or 'cmp' are NULL
+ *
+ * NOTE: same as dlist_node_lower_bound, the nodes matching 'key' are
+ * ------- the ones from lower bound up to, not including, upper bound.
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_node_upper_bound(struct dlist_list *list, void *key,
+					  dlist_cmp3_func cmp);
+
+
+/* returns 'list' after merging the 'nodes' of 's_list' into it, in order.
+ * returns NULL if 'list', 's_list' or 'cmp' are NULL
+ * returns NULL if 's_list' is empty.
+ *
+ * ABOUT [merging]: same as dlist_list_append, 's_list' becomes empty.
+ * ------- on equal 'nodes' the ones from 'list' come first.
+ * ------- takes O(n + m), no 'node' is allocated or copied.
+ *
+ * passing invalid ['list' or 's_list' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_list_merge_sorted(struct dlist_list *list,
+					   struct dlist_list *s_list,
+					   dlist_cmp3_func cmp);
+
+
+/* returns 'list' after merging the 'nodes' of the 'k' sorted 'lists'
+ * ------- into it, in order, 'list' counting as one more sorted input.
+ * returns NULL if 'list', 'lists' or 'cmp' are NULL
+ * returns NULL if allocation fails, every list is then left as it was.
+ * entries of 'lists' that are NULL, empty or 'list' itself are skipped.
+ *
+ * ABOUT [merging]: same as dlist_list_append, every entry of 'lists'
+ * ------- becomes empty. a heap over the heads picks each 'node' in
+ * ------- O(log k), so it all takes a single O(n log k) pass, no 'node'
+ * ------- is allocated or copied. on equal 'nodes' the ones from 'list'
+ * ------- come first, then those of the lower entries of 'lists'.
+ *
+ * passing invalid ['list' or 'lists' or 'cmp']
+ * ------- results in undefined behavior
+ * ------- passing the same 'list' twice in 'lists'
+ */
+struct dlist_list *dlist_list_merge_k(struct dlist_list *list,
+				     struct dlist_list **lists, size_t k,
+				     dlist_cmp3_func cmp);
+
+
+/****************************************************************************
+ * inline payload interface and _base_ documentation
+ *
+ * inline nodes carry their 'data' in the 'payload' at the end of the node
+ * itself, so a single allocation holds both. 'data' still points at the
+ * 'payload', so every function above keeps working on them. the functions
+ * below hand callbacks the 'payload' directly, saving the load of 'data'.
+ * they expect every 'node' in the 'list' to be an inline node.
+ ****************************************************************************/
+
+/* returns the 'payload' of an inline 'node' */
+#define dlist_node_inline_data(node) ((void *)(node)->payload)
+
+
+/* returns a new allocated inline 'node' holding a copy of 'size' bytes
+ * ------- of 'data'. returned 'node' needs to be freed, see dlist_node_delete
+ * returns NULL if 'size' is 0
+ * returns NULL if 'size' is bigger then DLIST_INLINE_MAX
+ * returns NULL if the 'list' allocator fails
+ * returns NULL with DLIST_COMPACT_NODE defined
+ * passing NULL in 'data' leaves the 'payload' uninitialized
+ *
+ * ABOUT [allocation]: the 'node' takes sizeof(struct dlist_node) + 'size'
+ * ------- bytes, fixed size allocators (see slab.h) need room for it.
+ *
+ * NOTE: inline nodes are told apart by the 'data_dalloc' they are given,
+ * ------- changing it makes the 'payload' be handed to a destructor.
+ * ------- compact nodes have no room for that mark, see DLIST_COMPACT_NODE
+ *
+ * passing invalid ['list' or 'data']
+ * ------- results in undefined behavior
+ */
+struct dlist_node *dlist_node_new_inline(struct dlist_list *list,
+					 const void *data, size_t size);
+
+
+/* same as dlist_node_find, 'cmp' receiving each 'node' 'payload' */
+struct dlist_node *dlist_inline_find(struct dlist_list *list, void *key,
+				     int (*cmp)(void *a, void *b));
+
+
+/* same as dlist_node_remove, 'cmp' receiving each 'node' 'payload' */
+struct dlist_node *dlist_inline_remove(struct dlist_list *list, void *key,
+				       int (*cmp)(void *a, void *b));
+
+
+/* returns a new list of inline 'nodes' of 'size' bytes, each written by
+ * ------- 'func' from the matching 'node' 'payload' in 'list'
+ * returns NULL if 'list' is NULL or empty
+ * returns NULL if 'func' is NULL
+ * returns NULL if 'size' is 0 or bigger then DLIST_INLINE_MAX
+ * returns NULL if allocation fails
+ *
+ * NOTE: allocates as dlist_map does
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *dlist_inline_map(const struct dlist_list *list,
+				    dlist_inline_map_func func, size_t size);
+
+
+/* same as dlist_fold, 'func' receiving each 'node' 'payload' */
+void *dlist_inline_fold(const struct dlist_list *list, void *initial,
+			dlist_fold_func func);
+
+
+/****************************************************************************
+ * intrusive interface and _base_ documentation
+ *
+ * the intrusive functions mirror the ones above, but operate on
+ * 'struct dlist_link' members embedded in user structures. they never
+ * allocate nor free memory, the user owns every element.
+ ****************************************************************************/
+
+/* returns 'list' initialized empty
+ * returns NULL if 'list' is NULL
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct dlist_ilist *dlist_ilist_init(struct dlist_ilist *list);
+
+
+/* returns 'link' after adding it at 'list' head.
+ * passing NULL in 'list' returns NULL.
+ * passing NULL in 'link' returns NULL.
+ *
+ * passing invalid ['list' or 'link']
+ * ------- results in undefined behavior
+ */
+struct dlist_link *dlist_link_push(struct dlist_ilist *list,
+				   struct dlist_link *link);
+
+
+/* returns 'link' after adding it at 'list' tail.
+ * passing NULL in 'list' returns NULL.
+ * passing NULL in 'link' returns NULL.
+ *
+ * passing invalid ['list' or 'link']
+ * ------- results in undefined behavior
+ */
+struct dlist_link *dlist_link_append(struct dlist_ilist *list,
+				     struct dlist_link *link);
+
+
+/* removes 'list' head and returns it.
+ * passing NULL in 'list' returns NULL.
+ * passing an empty 'list' returns NULL.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct dlist_link *dlist_link_pop(struct dlist_ilist *list);
+
+
+/* returns 'link' after unlinking it from 'list', in O(1).
+ * passing NULL in 'list' returns NULL.
+ * passing NULL in 'link' returns NULL.
+ *
+ * passing a 'link' not contained in 'list'
+ * ------- results in undefined behavior
+ */
+struct dlist_link *dlist_link_unlink(struct dlist_ilist *list,
+				     struct dlist_link *link);
+
+
+/* returns the 'link' matching 'key'
+ * returns NULL if 'key' is not found
+ * passing NULL in 'list' returns NULL.
+ * passing an empty 'list' returns NULL.
+ * passing NULL 'cmp' returns NULL.
+ *
+ * ABOUT ['key']: handed untouched to 'cmp', NULL is allowed.
+ * ABOUT ['cmp']: function needs to return 0 when 'link' matches 'key'
+ *
+ * passing invalid ['list' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_link *dlist_link_find(struct dlist_ilist *list, void *key,
+				   dlist_link_cmp_func cmp);
+
+
+/* returns the 'link' matching 'key' removing it.
+ * returns NULL if 'key' is not found
+ * passing NULL in 'list' returns NULL.
+ * passing an empty 'list' returns NULL.
+ * passing NULL 'cmp' returns NULL.
+ *
+ * ABOUT ['cmp']: function needs to return 0 when 'link' matches 'key'
+ *
+ * passing invalid ['list' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct dlist_link *dlist_link_remove(struct dlist_ilist *list, void *key,
+				     dlist_link_cmp_func cmp);
+
+
+/* executes 'action' on each 'link' contained in 'list'
+ * returns without any action performed if 'list' is NULL
+ * returns without any action performed if 'list' is empty
+ * returns without any action performed if 'action' is NULL
+ *
+ * ABOUT ['action']: same as dlist_node_foreach, receiving the 'link'
+ * ------- instead of the 'data'. 'action' may unlink the 'link' it was
+ * ------- given, the next 'link' is read before calling it.
+ *
+ * passing invalid ['list' or 'action' or 'param']
+ * ------- results in undefined behavior
+ */
+void dlist_link_foreach(struct dlist_ilist *list,
+			dlist_link_action_func action, void *param);
+
+
+/* returns 'list' reversed
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'list' is empty
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct dlist_ilist *dlist_ilist_reverse(struct dlist_ilist *list);
+
+
+/* returns 'list' after moving 's_list' into 'list' tail/end.
+ * returns NULL if 'list' is NULL.
+ * returns NULL if 's_list' is NULL.
+ * returns NULL if 's_list' is empty.
+ *
+ * ---info 's_list' becomes empty
+ *
+ * passing invalid ['list' or 's_list']
+ * ------- results in undefined behavior
+ */
+struct dlist_ilist *dlist_ilist_append(struct dlist_ilist *list,
+				       struct dlist_ilist *s_list);
+
+
+/* returns 'n_list' holding every 'link' of 'list' from 'key' onwards.
+ * returns NULL if 'list' is NULL.
+ * returns NULL if 'list' is empty.
+ * returns NULL if 'cmp' is NULL.
+ * returns NULL if 'n_list' is NULL.
+ * returns NULL if 'key' is not found.
+ *
+ * ---info 'n_list' is overwritten, it is expected to be empty
+ * ---info makes 'list' empty if 'key' matches @ head
+ *
+ * ABOUT ['cmp']: function needs to return 0 when 'link' matches 'key'
+ *
+ * passing invalid ['list' or 'cmp' or 'n_list']
+ * ------- results in undefined behavior
+ */
+struct dlist_ilist *dlist_ilist_split(struct dlist_ilist *list, void *key,
+				      dlist_link_cmp_func cmp,
+				      struct dlist_ilist *n_list);
+
+
+/* returns 'n_list' holding every 'link' of 'list' from 'index' onwards.
+ * returns NULL if 'list' is NULL.
+ * returns NULL if 'list' is empty.
+ * returns NULL if 'index' is out of bounds.
+ * returns NULL if 'n_list' is NULL.
+ *
+ * ---info 'n_list' is overwritten, it is expected to be empty
+ * ---info makes 'list' empty if 'index' is 1/head
+ *
+ * ABOUT ['index']: starts counting at 1
+ *
+ * passing invalid ['list' or 'n_list']
+ * ------- results in undefined behavior
+ */
+struct dlist_ilist *dlist_ilist_split_at(struct dlist_ilist *list,
+					 const size_t index,
+					 struct dlist_ilist *n_list);
+
 #endif
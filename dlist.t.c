@@ -44,6 +44,242 @@ void *add_int(void *acc, void *data) {
     return acc;
 }
 
+void double_int_inline(void *dst, void *src) {
+    *(int *)dst = *(int *)src * 2;
+}
+
+// counts the elements deleted through the list wide destructor
+static int dalloc_calls = 0;
+
+void count_dalloc(void *data) {
+    ++dalloc_calls;
+    free(data);
+}
+
+// counts without freeing, for elements the test keeps
+static void *dalloc_last = NULL;
+
+void note_dalloc(void *data) {
+    ++dalloc_calls;
+    dalloc_last = data;
+}
+
+// intrusive element used by the dlist_link tests
+struct item {
+    int key;
+    struct dlist_link link;
+};
+
+int cmp_item(struct dlist_link *link, void *key) {
+    return !( dlist_container_of(link, struct item, link)->key == *(int *)key );
+}
+
+void *sum_item(void *carry, struct dlist_link *link, void *param) {
+    *(int *)param += dlist_container_of(link, struct item, link)->key;
+    return carry;
+}
+
+//checks 'list' holds 'n' values of 'expect', by walking and by position
+int list_is(struct dlist_list *list, const int *expect, size_t n)
+{
+	struct dlist_node *node;
+	size_t idx = 0;
+
+	if ( n != list->count )
+		return 0;
+
+	for(node = list->head; NULL != node; node = node->next, ++idx)
+	{
+		if ( idx >= n || expect[idx] != *(int*)node->data )
+			return 0;
+		if ( node->next && node != node->next->prev )
+			return 0;
+		if ( node != dlist_node_get_at(list, idx + 1) )
+			return 0;
+		if ( idx + 1 != dlist_node_index_of(list, node) )
+			return 0;
+	}
+
+	return idx == n && (n ? list->tail == dlist_node_get_at(list, n)
+			      : NULL == list->tail);
+}
+
+//checks the 'list' cursor is unset or sits where it claims to
+int cursor_ok(struct dlist_list *list)
+{
+	struct dlist_node *node = list->head;
+
+	if ( !list->cursor.node )
+		return 1;
+
+	for(size_t idx = 1; idx < list->cursor.index && node; ++idx)
+		node = node->next;
+
+	return node == list->cursor.node;
+}
+
+//groups of 4 keys share a hash, so lookups have to probe
+size_t hash_int(void *data)
+{
+	return (size_t)(*(int*)data / 4);
+}
+
+//checks every key in [from, to) is found by the 'list' index iff 'in'
+int hash_has(struct dlist_list *list, int from, int to, int in)
+{
+	struct dlist_node *node;
+
+	for(int key = from; key < to; ++key)
+	{
+		node = dlist_hash_find(list, &key);
+		if ( in ? (!node || key != *(int*)node->data) : NULL != node )
+			return 0;
+	}
+
+	return 1;
+}
+
+//orders by tens only, the units tell apart nodes sorting together
+int cmp3_tens(void *a, void *b)
+{
+	return *(int*)a / 10 - *(int*)b / 10;
+}
+
+//counts its calls, see the sorted list tests
+static size_t cmp3_calls = 0;
+
+int cmp3_count(void *a, void *b)
+{
+	++cmp3_calls;
+	return cmp3_int(a, b);
+}
+
+//radix key helpers, the plain int and its tens
+uint64_t key_int(void *data)
+{
+	return (uint64_t)*(int*)data;
+}
+
+uint64_t key_tens(void *data)
+{
+	return (uint64_t)(*(int*)data / 10);
+}
+
+//counts the batches, checking 'carry' is handed from one to the next
+static size_t batch_calls = 0;
+static size_t batch_last = 0;
+
+void *sum_batch(void *carry, void **data, size_t n, void *param)
+{
+	assert( (uintptr_t)carry == batch_calls );
+	for(size_t i = 0; i < n; ++i)
+		*(int*)param += *(int*)data[i];
+	++batch_calls;
+	batch_last = n;
+	return (void*)(uintptr_t)batch_calls;
+}
+
+void double_batch(void **dst, void **src, size_t n)
+{
+	for(size_t i = 0; i < n; ++i)
+		dst[i] = int_copy(*(int*)src[i] * 2);
+	++batch_calls;
+}
+
+void *add_batch(void *acc, void **data, size_t n)
+{
+	for(size_t i = 0; i < n; ++i)
+		*(int*)acc += *(int*)data[i];
+	++batch_calls;
+	return acc;
+}
+
+//the accumulator dlist_fold_parallel segments past the first fold into
+void *int_zero(void)
+{
+	return int_copy(0);
+}
+
+void *combine_int(void *a, void *b)
+{
+	*(int*)a += *(int*)b;
+	int_dalloc(b);
+	return a;
+}
+
+//a run of consecutive ints, only folds and combines in order keep 'ok'
+struct run
+{
+	int first;
+	int last;
+	int ok;
+};
+
+void *run_new(void)
+{
+	struct run *run = malloc(sizeof( *run));
+
+	*run = (struct run){ -1, -1, 1 };
+	return run;
+}
+
+void *run_fold(void *acc, void *data)
+{
+	struct run *run = acc;
+
+	if ( run->first < 0 )
+		run->first = *(int*)data;
+	else
+		run->ok = run->ok && *(int*)data == run->last + 1;
+	run->last = *(int*)data;
+	return run;
+}
+
+void *run_combine(void *a, void *b)
+{
+	struct run *left = a;
+	struct run *right = b;
+
+	left->ok = left->ok && right->ok && right->first == left->last + 1;
+	left->last = right->last;
+	free(right);
+	return left;
+}
+
+bool under_1500(void *data)
+{
+	return *(int*)data < 1500;
+}
+
+bool is_negative(void *data)
+{
+	return *(int*)data < 0;
+}
+
+//checks 'a' and 'b' hold the same ints, in the same order
+int same_ints(struct dlist_list *a, struct dlist_list *b)
+{
+	struct dlist_node *x = a->head;
+	struct dlist_node *y = b->head;
+
+	if ( a->count != b->count )
+		return 0;
+
+	for(; x && y; x = x->next, y = y->next)
+		if ( *(int*)x->data != *(int*)y->data
+		     || (x->next && x != x->next->prev) )
+			return 0;
+
+	return !x && !y;
+}
+
+//bumps the int in place, handing the same 'data' back
+void *inc_int(void *data)
+{
+	++*(int*)data;
+	return data;
+}
+
 int main(int argc, char **argv)
 {
 	wmsg("testing dlist lib interface\n");
@@ -52,6 +288,7 @@ int main(int argc, char **argv)
 		wmsg("dlist_init");
 
 		struct dlist_list list;
+		assert( NULL == dlist_init(NULL, NULL, NULL) );
 		assert( dlist_init(&list, NULL, NULL) );
 		assert( 0 == list.count );
 		assert( NULL == list.head );
@@ -77,6 +314,69 @@ int main(int argc, char **argv)
 		wmsg("[OK]\n");
 	}
 
+	{
+		wmsg("dlist_init_allocator");
+
+		struct dlist_list list;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		count_ctx_init(&allocator, &ctx);
+		assert( NULL == dlist_init_allocator(NULL, &allocator) );
+		assert( dlist_init_allocator(&list, &allocator) );
+		assert( 0 == list.count );
+		assert( NULL == list.head );
+		assert( NULL == list.tail );
+		assert( &allocator == list.allocator );
+		//NULL allocator falls back to the defaults
+		assert( dlist_init_allocator(&list, NULL) );
+		assert( NULL == list.allocator );
+		assert( DLIST_DEF_ALLOC == list.node_alloc );
+		assert( DLIST_DEF_DALLOC == list.node_dalloc );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_list_new_allocator");
+
+		struct dlist_list *list;
+		struct dlist_list *mapped;
+		struct dlist_node *node;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		count_ctx_init(&allocator, &ctx);
+		assert( (list = dlist_list_new_allocator(&allocator)) );
+		dlist_data_dalloc(list, int_dalloc);
+		assert( &allocator == list->allocator );
+		//the list itself does not go through the allocator
+		assert( 0 == ctx.allocs );
+
+		for(int i = 0; i < 40; ++i)
+		{
+			node = dlist_node_new(list, int_copy(i), int_dalloc);
+			dlist_node_append(list, node);
+		}
+		assert( 40 == ctx.allocs );
+		dlist_node_delete(list, dlist_node_pop(list));
+		assert( 1 == ctx.dallocs );
+		//map takes its nodes in bulk
+		assert( (mapped = dlist_map(list, double_int, int_dalloc)) );
+		assert( &allocator == mapped->allocator );
+		assert( 2 == ctx.bulk_allocs );
+		assert( 39 == mapped->count );
+		assert( 2 == *(int*)mapped->head->data );
+		assert( 78 == *(int*)mapped->tail->data );
+		//and deleting all nodes gives them back in bulk
+		assert( dlist_list_delete_all_nodes(list) );
+		assert( dlist_list_delete_all_nodes(mapped) );
+		assert( 4 == ctx.bulk_dallocs );
+		assert( 1 == ctx.dallocs );
+		dlist_list_delete(list);
+		dlist_list_delete(mapped);
+
+		wmsg("[OK]\n");
+	}
+
 	{
 		wmsg("dlist_node_new");
 
@@ -89,8 +389,10 @@ int main(int argc, char **argv)
 		assert( 10 == *(int*)node->data );
 		assert( !node->next );
 		assert( !node->prev );
+#ifndef DLIST_COMPACT_NODE
 		assert( int_dalloc == node->data_dalloc );
-		assert( (node->data_dalloc(node->data), 1) );
+#endif
+		int_dalloc(node->data);
 		free(node);
 		free(list);
 
@@ -121,6 +423,7 @@ int main(int argc, char **argv)
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		assert( (node = dlist_node_new(list, int_copy(10), int_dalloc)) );
 		dlist_node_delete(list, node);
 		free(list);
@@ -145,6 +448,7 @@ int main(int argc, char **argv)
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(10), int_dalloc);
 
 		//test failures
@@ -174,6 +478,7 @@ int main(int argc, char **argv)
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(10), int_dalloc);
 
 		//test failures
@@ -211,6 +516,7 @@ int main(int argc, char **argv)
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(11), int_dalloc);
 
 		//test failures
@@ -238,6 +544,7 @@ int main(int argc, char **argv)
 		struct dlist_node *node;
 		void *key;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(9), int_dalloc);
 		key = int_copy(9);
 
@@ -302,6 +609,7 @@ int main(int argc, char **argv)
 		struct dlist_node *node;
 		void *key;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(9), int_dalloc);
 		key = int_copy(9);
 
@@ -366,6 +674,7 @@ int main(int argc, char **argv)
 		struct dlist_node *node;
 		void *key;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(10), int_dalloc);
 		key = int_copy(10);
 
@@ -418,6 +727,7 @@ int main(int argc, char **argv)
 		struct dlist_node *node;
 		void *key;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(10), int_dalloc);
 		key = int_copy(10);
 		//test failures
@@ -474,6 +784,7 @@ int main(int argc, char **argv)
 		dlist_node_delete(list, node);
 		node = dlist_node_pop(list);
 		dlist_node_delete(list, node);
+		dlist_list_delete(list);
 		int_dalloc(key);
 
 		wmsg("[OK]\n");
@@ -484,6 +795,7 @@ int main(int argc, char **argv)
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(10), int_dalloc);
 		//test failures
 		//no list and lower bounds
@@ -560,6 +872,7 @@ int main(int argc, char **argv)
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		//create some nodes to test
 		node = dlist_node_new(list, int_copy(10), int_dalloc);
 		dlist_node_push(list, node);
@@ -593,6 +906,7 @@ int main(int argc, char **argv)
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		//test failures
 		assert( NULL == dlist_list_delete_all_nodes(NULL) );
 		//test empty
@@ -617,11 +931,55 @@ int main(int argc, char **argv)
 		wmsg("[OK]\n");
 	}
 
+	{
+		wmsg("dlist_list_reset");
+		struct dlist_list *list;
+		struct dlist_node *node;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		int keep = 7;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_list_reset(NULL, false) );
+		//test empty
+		assert( list == dlist_list_reset(list, false) );
+		node = dlist_node_new(list, int_copy(10), int_dalloc);
+		dlist_node_push(list, node);
+		node = dlist_node_new(list, int_copy(9), int_dalloc);
+		dlist_node_push(list, node);
+		assert( list == dlist_list_reset(list, false) );
+		assert( NULL == list->head );
+		assert( NULL == list->tail );
+		assert( 0 == list->count );
+		//owned data is left alone
+		node = dlist_node_new(list, &keep, int_dalloc);
+		dlist_node_push(list, node);
+		assert( list == dlist_list_reset(list, true) );
+		assert( 7 == keep );
+		dlist_list_delete(list);
+		//without an arena nodes still go through the cache and bulk_dalloc
+		count_ctx_init(&allocator, &ctx);
+		list = dlist_list_new_allocator(&allocator);
+		dlist_cache_limit(list, 2);
+		for(int i = 0; i < 10; ++i)
+			dlist_node_push(list, dlist_node_new(list, &keep, NULL));
+		assert( list == dlist_list_reset(list, true) );
+		assert( 7 == keep );
+		assert( 2 == list->cache_count );
+		assert( 1 == ctx.bulk_dallocs && 0 == ctx.dallocs );
+
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
 	{
 		wmsg("dlist_list_reverse");
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		//test failures
 		assert( NULL == dlist_list_reverse(NULL) );
 		//test empty
@@ -648,6 +1006,7 @@ int main(int argc, char **argv)
 		struct dlist_list *list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(10), int_dalloc);
 		dlist_node_push(list, node);
 		assert( 1 == list->count && 1 == dlist_get_size(list) );
@@ -662,7 +1021,9 @@ int main(int argc, char **argv)
 		struct dlist_list *s_list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		s_list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(s_list, int_dalloc);
 		//test failures
 		assert( NULL == dlist_list_push(NULL, NULL) );
 		assert( NULL == dlist_list_push(list, NULL) );
@@ -712,7 +1073,9 @@ int main(int argc, char **argv)
 		struct dlist_list *s_list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		s_list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(s_list, int_dalloc);
 		//test failures
 		assert( NULL == dlist_list_append(NULL, NULL) );
 		assert( NULL == dlist_list_append(list, NULL) );
@@ -769,6 +1132,7 @@ int main(int argc, char **argv)
 		struct dlist_node *node;
 		void *key;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		key = int_copy(6);
 		//test failures
 		assert( NULL == dlist_list_split(NULL, NULL, NULL) );
@@ -838,6 +1202,12 @@ int main(int argc, char **argv)
 		assert( NULL == list->tail->next );
 		assert( NULL == n_list->head->prev );
 		assert( NULL == n_list->tail->next );
+
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete_all_nodes(n_list);
+		dlist_list_delete(list);
+		dlist_list_delete(n_list);
+		int_dalloc(key);
 		wmsg("[OK]\n");
 	}
 
@@ -847,6 +1217,7 @@ int main(int argc, char **argv)
 		struct dlist_list *n_list;
 		struct dlist_node *node;
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 		node = dlist_node_new(list, int_copy(6), int_dalloc);
 		//test failures
 		//no list and lower bounds
@@ -923,6 +1294,7 @@ int main(int argc, char **argv)
 		struct dlist_node *node;
 
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 
 		// Test failures
 		assert(NULL == dlist_map(NULL, NULL, NULL));
@@ -966,6 +1338,7 @@ int main(int argc, char **argv)
 		struct dlist_node *node;
 
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 
 		// Test failures
 		assert(NULL == dlist_filter(NULL, NULL));
@@ -1007,6 +1380,7 @@ int main(int argc, char **argv)
 		int sum = 0;
 
 		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
 
 		// Test failures
 		assert(NULL == dlist_fold(NULL, &sum, NULL));
@@ -1036,5 +1410,1199 @@ int main(int argc, char **argv)
 		wmsg("[OK]\n");
 	}
 
+	{
+		wmsg("dlist_link push/append/pop/unlink");
+
+		struct dlist_ilist list;
+		struct item items[4];
+		for(int i = 0; i < 4; ++i)
+			items[i].key = i;
+
+		assert( NULL == dlist_ilist_init(NULL) );
+		assert( &list == dlist_ilist_init(&list) );
+		//test failures
+		assert( NULL == dlist_link_push(NULL, &items[0].link) );
+		assert( NULL == dlist_link_append(&list, NULL) );
+		assert( NULL == dlist_link_pop(&list) );
+		//build 1, 0, 2, 3
+		assert( &items[0].link == dlist_link_push(&list, &items[0].link) );
+		assert( list.head == list.tail );
+		dlist_link_push(&list, &items[1].link);
+		dlist_link_append(&list, &items[2].link);
+		dlist_link_append(&list, &items[3].link);
+		assert( 4 == list.count );
+		assert( 1 == dlist_container_of(list.head, struct item, link)->key );
+		assert( 3 == dlist_container_of(list.tail, struct item, link)->key );
+		//unlink from the middle
+		assert( &items[0].link == dlist_link_unlink(&list, &items[0].link) );
+		assert( 3 == list.count );
+		assert( list.head->next == &items[2].link );
+		assert( items[2].link.prev == list.head );
+		//unlink the tail
+		dlist_link_unlink(&list, &items[3].link);
+		assert( list.tail == &items[2].link );
+		assert( NULL == list.tail->next );
+		assert( &items[1].link == dlist_link_pop(&list) );
+		assert( &items[2].link == dlist_link_pop(&list) );
+		assert( 0 == list.count );
+		assert( NULL == list.head );
+		assert( NULL == list.tail );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_link find/remove/foreach");
+
+		struct dlist_ilist list;
+		struct item items[4];
+		int key = 2;
+		int sum = 0;
+		dlist_ilist_init(&list);
+		for(int i = 0; i < 4; ++i)
+		{
+			items[i].key = i;
+			dlist_link_append(&list, &items[i].link);
+		}
+
+		assert( NULL == dlist_link_find(&list, &key, NULL) );
+		assert( &items[2].link == dlist_link_find(&list, &key, cmp_item) );
+		assert( &items[2].link == dlist_link_remove(&list, &key, cmp_item) );
+		assert( NULL == dlist_link_find(&list, &key, cmp_item) );
+		assert( NULL == dlist_link_remove(&list, &key, cmp_item) );
+		assert( 3 == list.count );
+		dlist_link_foreach(&list, sum_item, &sum);
+		assert( 4 == sum );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_ilist reverse/append/split");
+
+		struct dlist_ilist list;
+		struct dlist_ilist n_list;
+		struct item items[6];
+		int key = 4;
+		dlist_ilist_init(&list);
+		dlist_ilist_init(&n_list);
+		for(int i = 0; i < 6; ++i)
+		{
+			items[i].key = i;
+			dlist_link_append(&list, &items[i].link);
+		}
+
+		assert( NULL == dlist_ilist_reverse(NULL) );
+		assert( &list == dlist_ilist_reverse(&list) );
+		assert( 5 == dlist_container_of(list.head, struct item, link)->key );
+		assert( 0 == dlist_container_of(list.tail, struct item, link)->key );
+		dlist_ilist_reverse(&list);
+		//split at key 4 -> list 0..3, n_list 4..5
+		assert( NULL == dlist_ilist_split(&list, &key, cmp_item, NULL) );
+		assert( &n_list == dlist_ilist_split(&list, &key, cmp_item, &n_list) );
+		assert( 4 == list.count && 2 == n_list.count );
+		assert( list.tail == &items[3].link && NULL == list.tail->next );
+		assert( n_list.head == &items[4].link && NULL == n_list.head->prev );
+		//append it back
+		assert( NULL == dlist_ilist_append(&list, NULL) );
+		assert( &list == dlist_ilist_append(&list, &n_list) );
+		assert( 6 == list.count && 0 == n_list.count );
+		assert( NULL == n_list.head && NULL == n_list.tail );
+		assert( items[4].link.prev == &items[3].link );
+		//split_at, bounds and head
+		assert( NULL == dlist_ilist_split_at(&list, 0, &n_list) );
+		assert( NULL == dlist_ilist_split_at(&list, 7, &n_list) );
+		assert( &n_list == dlist_ilist_split_at(&list, 5, &n_list) );
+		assert( 4 == list.count && 2 == n_list.count );
+		assert( n_list.head == &items[4].link );
+		dlist_ilist_append(&list, &n_list);
+		assert( &n_list == dlist_ilist_split_at(&list, 1, &n_list) );
+		assert( 0 == list.count && NULL == list.head && NULL == list.tail );
+		assert( 6 == n_list.count && n_list.tail == &items[5].link );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_node_new_inline");
+
+		struct dlist_list *list;
+		int value = 10;
+		list = dlist_list_new(NULL, NULL);
+#ifdef DLIST_COMPACT_NODE
+		//compact nodes have no room to mark inline ones
+		assert( NULL == dlist_node_new_inline(list, &value, sizeof( int )) );
+#else
+		struct dlist_node *node;
+		//test failures
+		assert( NULL == dlist_node_new_inline(list, &value, 0) );
+		assert( NULL == dlist_node_new_inline(list, &value, DLIST_INLINE_MAX + 1) );
+		assert( (node = dlist_node_new_inline(list, &value, sizeof( int ))) );
+		//the payload is a copy living in the node
+		value = 11;
+		assert( 10 == *(int*)dlist_node_inline_data(node) );
+		assert( node->data == dlist_node_inline_data(node) );
+		//the mark, never called
+		assert( NULL != node->data_dalloc );
+		assert( NULL == node->next && NULL == node->prev );
+		//regular operations work on inline nodes
+		dlist_node_push(list, node);
+		assert( 10 == *(int*)list->head->data );
+		dlist_list_delete_all_nodes(list);
+#endif
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_node with data right past it");
+
+		struct dlist_list *list;
+		struct dlist_node *node;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, note_dalloc);
+		dlist_cache_limit(list, 1);
+		//where the payload would be, not an inline node for that
+		node = dlist_node_new(list, NULL, note_dalloc);
+		node->data = node->payload;
+		dlist_node_push(list, node);
+		dalloc_calls = 0;
+		dlist_node_delete(list, dlist_node_pop(list));
+		assert( 1 == dalloc_calls );
+		assert( dalloc_last == (void *)node->payload );
+		assert( node == list->cache );
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+#ifndef DLIST_COMPACT_NODE
+	{
+		wmsg("dlist_inline find/remove/map/fold");
+
+		struct dlist_list *list;
+		struct dlist_list *mapped;
+		struct dlist_node *node;
+		int key = 2;
+		int sum = 0;
+		list = dlist_list_new(NULL, NULL);
+		for(int i = 1; i <= 4; ++i)
+		{
+			node = dlist_node_new_inline(list, &i, sizeof( int ));
+			dlist_node_append(list, node);
+		}
+		//find
+		assert( NULL == dlist_inline_find(NULL, &key, cmp_int) );
+		assert( NULL == dlist_inline_find(list, &key, NULL) );
+		assert( (node = dlist_inline_find(list, &key, cmp_int)) );
+		assert( 2 == *(int*)node->payload );
+		//map
+		assert( NULL == dlist_inline_map(list, double_int_inline, 0) );
+		assert( (mapped = dlist_inline_map(list, double_int_inline, sizeof( int ))) );
+		assert( 4 == mapped->count );
+		assert( 2 == *(int*)dlist_node_inline_data(mapped->head) );
+		assert( 8 == *(int*)dlist_node_inline_data(mapped->tail) );
+		//fold
+		assert( &sum == dlist_inline_fold(mapped, &sum, add_int) );
+		assert( 20 == sum );
+		//remove @ head, middle and tail
+		key = 1;
+		assert( (node = dlist_inline_remove(list, &key, cmp_int)) );
+		dlist_node_delete(list, node);
+		assert( 2 == *(int*)list->head->payload );
+		assert( NULL == list->head->prev );
+		key = 4;
+		assert( (node = dlist_inline_remove(list, &key, cmp_int)) );
+		dlist_node_delete(list, node);
+		assert( 3 == *(int*)list->tail->payload );
+		assert( NULL == list->tail->next );
+		assert( NULL == dlist_inline_remove(list, &key, cmp_int) );
+		assert( 2 == list->count );
+
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+		dlist_list_delete_all_nodes(mapped);
+		dlist_list_delete(mapped);
+
+		wmsg("[OK]\n");
+	}
+#endif
+
+	{
+		wmsg("dlist_cache_limit/trim");
+
+		struct dlist_list *list;
+		struct dlist_node *node;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		count_ctx_init(&allocator, &ctx);
+		list = dlist_list_new_allocator(&allocator);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_cache_limit(NULL, 4) );
+		assert( 0 == dlist_cache_trim(NULL, 0) );
+		assert( list == dlist_cache_limit(list, 4) );
+		assert( 4 == list->cache_max );
+		//warm up the cache
+		for(int i = 0; i < 4; ++i)
+		{
+			node = dlist_node_new(list, int_copy(i), int_dalloc);
+			dlist_node_push(list, node);
+		}
+		while ( list->head )
+			dlist_node_delete(list, dlist_node_pop(list));
+		assert( 4 == ctx.allocs );
+		assert( 0 == ctx.dallocs );
+		assert( 4 == list->cache_count );
+		//steady state queue traffic makes no allocator calls
+		for(int i = 0; i < 1000; ++i)
+		{
+			node = dlist_node_new(list, int_copy(i), int_dalloc);
+			dlist_node_push(list, node);
+			dlist_node_delete(list, dlist_node_pop(list));
+		}
+		assert( 4 == ctx.allocs );
+		assert( 0 == ctx.dallocs );
+#ifndef DLIST_COMPACT_NODE
+		//inline nodes bypass the cache
+		node = dlist_node_new_inline(list, &ctx, sizeof( int ));
+		dlist_node_delete(list, node);
+		assert( 5 == ctx.allocs && 1 == ctx.dallocs );
+#endif
+		//bounding the cache frees the extra nodes
+		dlist_cache_limit(list, 1);
+		assert( 1 == list->cache_count );
+		assert( ctx.allocs - 1 == ctx.dallocs );
+		assert( 1 == dlist_cache_trim(list, 0) );
+		assert( NULL == list->cache );
+		dlist_cache_limit(list, 2);
+		node = dlist_node_new(list, NULL, NULL);
+		dlist_node_delete(list, node);
+		//the list takes its cache with it
+		dlist_list_delete(list);
+		assert( ctx.allocs == ctx.dallocs );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_data_dalloc");
+
+		struct dlist_list *list;
+		struct dlist_list *n_list;
+		struct dlist_list *mapped;
+#ifndef DLIST_COMPACT_NODE
+		int value = 1;
+#endif
+		list = dlist_list_new(NULL, NULL);
+		//test failures
+		assert( NULL == dlist_data_dalloc(NULL, count_dalloc) );
+		assert( NULL == list->data_dalloc );
+		assert( list == dlist_data_dalloc(list, count_dalloc) );
+		//nodes carry no destructor of their own
+		for(int i = 0; i < 6; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+#ifndef DLIST_COMPACT_NODE
+		//inline nodes are left alone
+		dlist_node_append(list, dlist_node_new_inline(list, &value, sizeof( int )));
+#endif
+		//the split off list takes the destructor along
+		assert( (n_list = dlist_list_split_at(list, 4)) );
+		assert( count_dalloc == n_list->data_dalloc );
+		dalloc_calls = 0;
+		dlist_node_delete(list, dlist_node_pop(list));
+		assert( 1 == dalloc_calls );
+		dlist_list_delete_all_nodes(n_list);
+		assert( 4 == dalloc_calls );
+		dlist_list_delete(n_list);
+		//map hands its 'dalloc' to the new list
+		assert( (mapped = dlist_map(list, double_int, count_dalloc)) );
+		assert( count_dalloc == mapped->data_dalloc );
+		dlist_list_delete_all_nodes(mapped);
+		assert( 6 == dalloc_calls );
+		dlist_list_delete(mapped);
+		//filter only shares the elements
+		assert( (mapped = dlist_filter(list, is_even)) );
+		assert( NULL == mapped->data_dalloc );
+		dlist_list_delete_all_nodes(mapped);
+		dlist_list_delete(mapped);
+		dlist_list_delete_all_nodes(list);
+		assert( 8 == dalloc_calls );
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_get_stats");
+
+		struct dlist_list *list;
+		struct dlist_list *n_list;
+		struct dlist_stats stats;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( false == dlist_get_stats(NULL, &stats) );
+		assert( false == dlist_get_stats(list, NULL) );
+		for(int i = 0; i < 10; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		//the split off nodes take their count along
+		assert( (n_list = dlist_list_split_at(list, 7)) );
+		assert( 6 == list->count && 4 == n_list->count );
+		assert( 5 == *(int*)list->tail->data );
+		dlist_node_delete(list, dlist_node_pop(list));
+		dlist_list_delete_all_nodes(n_list);
+#ifdef DLIST_STATS
+		assert( true == dlist_get_stats(list, &stats) );
+		assert( 10 == stats.allocs );
+		assert( 1 == stats.dallocs );
+		assert( 5 == stats.live );
+		assert( 10 == stats.peak );
+		assert( 10 * sizeof( struct dlist_node) == stats.bytes );
+		assert( 1 == stats.data_dallocs );
+		assert( true == dlist_get_stats(n_list, &stats) );
+		assert( 0 == stats.allocs );
+		assert( 4 == stats.dallocs && 4 == stats.data_dallocs );
+		assert( 0 == stats.live && 4 == stats.peak );
+#else
+		assert( false == dlist_get_stats(list, &stats) );
+#endif
+		dlist_list_delete(n_list);
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_skip_attach/get_at/index_of");
+
+		struct dlist_list *list;
+		struct dlist_list *n_list;
+		struct dlist_list *s_list;
+		struct dlist_node *node;
+		int expect[2000];
+		size_t n = 0;
+		size_t at;
+		int key;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_skip_attach(NULL) );
+		assert( NULL == dlist_node_get_at(NULL, 1) );
+		assert( NULL == dlist_node_get_at(list, 1) );
+		assert( 0 == dlist_node_index_of(NULL, NULL) );
+		assert( 0 == dlist_node_index_of(list, NULL) );
+		dlist_skip_detach(NULL);
+		dlist_skip_detach(list);
+		//plain lists answer the same, walking
+		for(int i = 0; i < 100; ++i)
+		{
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+			expect[n++] = i;
+		}
+		assert( list_is(list, expect, n) );
+		assert( list == dlist_skip_attach(list) );
+		assert( list_is(list, expect, n) );
+		assert( NULL == dlist_node_get_at(list, n + 1) );
+		//attaching twice rebuilds
+		assert( list == dlist_skip_attach(list) );
+		//push and append keep it current
+		for(int i = 100; i < 1000; ++i)
+		{
+			if ( i % 3 ) {
+				dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+				expect[n++] = i;
+			} else {
+				dlist_node_push(list, dlist_node_new(list, int_copy(i), NULL));
+				for(size_t idx = n++; idx; --idx)
+					expect[idx] = expect[idx - 1];
+				expect[0] = i;
+			}
+		}
+		assert( list_is(list, expect, n) );
+		//and so do pop, remove and remove_at
+		for(int i = 0; i < 300; ++i)
+		{
+			at = 1 + (size_t)(i * 37) % n;
+			if ( i % 3 == 0 ) {
+				node = dlist_node_remove_at(list, at);
+			} else if ( i % 3 == 1 ) {
+				key = expect[at - 1];
+				node = dlist_node_remove(list, &key, cmp_int);
+			} else {
+				at = 1;
+				node = dlist_node_pop(list);
+			}
+			assert( expect[at - 1] == *(int*)node->data );
+			dlist_node_delete(list, node);
+			for(--n; at <= n; ++at)
+				expect[at - 1] = expect[at];
+		}
+		assert( list_is(list, expect, n) );
+		//split_at hands each list its own part
+		assert( (n_list = dlist_list_split_at(list, 201)) );
+		assert( list_is(list, expect, 200) );
+		assert( list_is(n_list, expect + 200, n - 200) );
+		assert( (s_list = dlist_list_split_at(n_list, 250)) );
+		assert( list_is(n_list, expect + 200, 249) );
+		assert( list_is(s_list, expect + n - 251, 251) );
+		//split by key too
+		dlist_list_append(list, n_list);
+		dlist_list_append(list, s_list);
+		dlist_list_delete(n_list);
+		dlist_list_delete(s_list);
+		key = expect[10];
+		assert( (s_list = dlist_list_split(list, &key, cmp_int)) );
+		assert( list_is(list, expect, 10) );
+		assert( list_is(s_list, expect + 10, n - 10) );
+		//list append drops the index, it comes back on use
+		assert( list == dlist_list_append(list, s_list) );
+		assert( 0 == s_list->count && NULL == s_list->tail );
+		assert( list_is(list, expect, n) );
+		assert( list_is(s_list, expect, 0) );
+		//appending into an empty list sets its tail
+		assert( s_list == dlist_list_append(s_list, n_list = dlist_list_split_at(list, n - 4)) );
+		assert( list_is(s_list, expect + n - 5, 5) );
+		assert( list_is(list, expect, n - 5) );
+		dlist_list_delete(n_list);
+		dlist_list_delete_all_nodes(s_list);
+		dlist_list_delete(s_list);
+		n -= 5;
+		//reversing drops it as well
+		dlist_list_reverse(list);
+		for(size_t idx = 0; idx < n / 2; ++idx)
+		{
+			key = expect[idx];
+			expect[idx] = expect[n - 1 - idx];
+			expect[n - 1 - idx] = key;
+		}
+		assert( list_is(list, expect, n) );
+		assert( list == dlist_list_delete_all_nodes(list) );
+		assert( list_is(list, expect, 0) );
+		dlist_node_append(list, dlist_node_new(list, int_copy(7), NULL));
+		assert( 7 == *(int*)dlist_node_get_at(list, 1)->data );
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist cursor");
+
+		struct dlist_list *list;
+		struct dlist_list *n_list;
+		struct dlist_list *s_list;
+		struct dlist_node *node;
+		int key;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		s_list = dlist_list_new(NULL, NULL);
+		assert( NULL == list->cursor.node );
+		for(int i = 0; i < 100; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		//lookups leave it on the node found
+		node = dlist_node_get_at(list, 50);
+		assert( node == list->cursor.node && 50 == list->cursor.index );
+		assert( 50 == *(int*)dlist_node_get_at(list, 51)->data );
+		assert( 51 == list->cursor.index );
+		assert( 40 == *(int*)dlist_node_get_at(list, 41)->data );
+		assert( 50 == dlist_node_index_of(list, node) );
+		assert( node == list->cursor.node );
+		//removing scans from it: 50, 51, 52 go, the cursor stays on 49
+		for(int i = 0; i < 3; ++i)
+		{
+			node = dlist_node_remove_at(list, 51);
+			assert( 50 + i == *(int*)node->data );
+			dlist_node_delete(list, node);
+			assert( 49 == *(int*)list->cursor.node->data );
+			assert( 50 == list->cursor.index );
+		}
+		//every mutation keeps it right
+		dlist_node_push(list, dlist_node_new(list, int_copy(-1), NULL));
+		assert( 51 == list->cursor.index && cursor_ok(list) );
+		dlist_node_delete(list, dlist_node_pop(list));
+		dlist_node_delete(list, dlist_node_pop(list));
+		assert( 49 == list->cursor.index && cursor_ok(list) );
+		key = 10;
+		dlist_node_delete(list, dlist_node_remove(list, &key, cmp_int));
+		assert( 48 == list->cursor.index && cursor_ok(list) );
+		key = 49;
+		dlist_node_delete(list, dlist_node_remove(list, &key, cmp_int));
+		assert( 48 == *(int*)list->cursor.node->data && cursor_ok(list) );
+		dlist_list_reverse(list);
+		assert( cursor_ok(list) );
+		dlist_list_reverse(list);
+		//split before it hands it to the new list
+		assert( (n_list = dlist_list_split_at(list, 20)) );
+		assert( NULL != n_list->cursor.node && cursor_ok(n_list) );
+		assert( 19 == list->cursor.index && cursor_ok(list) );
+		dlist_node_get_at(n_list, 10);
+		for(int i = 0; i < 5; ++i)
+			dlist_node_append(s_list, dlist_node_new(s_list, int_copy(i), NULL));
+		dlist_node_get_at(s_list, 3);
+		assert( n_list == dlist_list_push(n_list, s_list) );
+		assert( NULL == s_list->cursor.node );
+		assert( 15 == n_list->cursor.index && cursor_ok(n_list) );
+		dlist_list_delete_all_nodes(n_list);
+		assert( NULL == n_list->cursor.node );
+		dlist_list_delete(n_list);
+		dlist_list_delete(s_list);
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_node_fast_find/_mt");
+
+		struct dlist_list *list;
+		struct dlist_node *node;
+		int key = 0;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_node_fast_find(list, &key, cmp_int) );
+		assert( NULL == dlist_node_fast_find_mt(NULL, &key, cmp_int, 0) );
+		assert( NULL == dlist_node_fast_find_mt(list, &key, cmp_int, 0) );
+		//odd and even lengths, every key and a missing one
+		for(int n = 1; n <= 8; ++n)
+		{
+			dlist_node_append(list, dlist_node_new(list, int_copy(n - 1), NULL));
+			for(key = 0; key < n; ++key)
+			{
+				assert( (node = dlist_node_fast_find(list, &key, cmp_int)) );
+				assert( key == *(int*)node->data );
+			}
+			assert( NULL == dlist_node_fast_find(list, &key, cmp_int) );
+		}
+		dlist_list_delete_all_nodes(list);
+		//two threads
+		for(int i = 0; i < 10001; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		for(key = 0; key < 10001; key += 997)
+		{
+			assert( (node = dlist_node_fast_find_mt(list, &key, cmp_int, 0)) );
+			assert( key == *(int*)node->data );
+		}
+		key = 10000;
+		assert( list->tail == dlist_node_fast_find_mt(list, &key, cmp_int, 0) );
+		key = -1;
+		assert( NULL == dlist_node_fast_find_mt(list, &key, cmp_int, 0) );
+		//a key in both halves may come from either
+		*(int*)list->tail->data = 0;
+		key = 0;
+		node = dlist_node_fast_find_mt(list, &key, cmp_int, 0);
+		assert( list->head == node || list->tail == node );
+		//under the threshold it stays on this thread
+		key = 5000;
+		assert( 5000 == *(int*)dlist_node_fast_find_mt(list, &key, cmp_int,
+							       DLIST_FIND_MT_THRESHOLD)->data );
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_hash_attach/find/remove/split");
+
+		struct dlist_list *list;
+		struct dlist_list *n_list;
+		struct dlist_list *s_list;
+		struct dlist_node *node;
+		int expect[1000];
+		int key = 0;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_hash_attach(NULL, hash_int, cmp_int) );
+		assert( NULL == dlist_hash_attach(list, NULL, cmp_int) );
+		assert( NULL == dlist_hash_attach(list, hash_int, NULL) );
+		assert( NULL == dlist_hash_find(NULL, &key) );
+		assert( NULL == dlist_hash_find(list, &key) );
+		assert( NULL == dlist_hash_remove(list, &key) );
+		assert( NULL == dlist_hash_split(list, &key) );
+		dlist_hash_detach(NULL);
+		dlist_hash_detach(list);
+		//empty and then built over existing nodes
+		assert( list == dlist_hash_attach(list, hash_int, cmp_int) );
+		assert( NULL == dlist_hash_find(list, &key) );
+		dlist_hash_detach(list);
+		for(int i = 0; i < 1000; ++i)
+		{
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+			expect[i] = i;
+		}
+		assert( list == dlist_hash_attach(list, hash_int, cmp_int) );
+		assert( hash_has(list, 0, 1000, 1) );
+		assert( hash_has(list, 1000, 1010, 0) );
+		//push and append add, pop, remove and remove_at drop
+		dlist_node_push(list, dlist_node_new(list, int_copy(-1), NULL));
+		dlist_node_append(list, dlist_node_new(list, int_copy(1000), NULL));
+		assert( hash_has(list, -1, 1001, 1) );
+		dlist_node_delete(list, dlist_node_pop(list));
+		key = 1000;
+		dlist_node_delete(list, dlist_node_remove(list, &key, cmp_int));
+		key = 500;
+		dlist_node_delete(list, dlist_node_remove(list, &key, cmp_int));
+		dlist_node_delete(list, dlist_node_remove_at(list, 501));
+		assert( hash_has(list, -1, 0, 0) && hash_has(list, 1000, 1001, 0) );
+		assert( hash_has(list, 500, 502, 0) );
+		assert( hash_has(list, 0, 500, 1) && hash_has(list, 502, 1000, 1) );
+		//remove by key, colliding neighbours stay reachable
+		for(key = 100; key < 110; key += 3)
+		{
+			assert( (node = dlist_hash_remove(list, &key)) );
+			assert( key == *(int*)node->data );
+			dlist_node_delete(list, node);
+			assert( NULL == dlist_hash_remove(list, &key) );
+		}
+		assert( hash_has(list, 101, 103, 1) && hash_has(list, 104, 106, 1) );
+		for(key = 100; key < 110; key += 3)
+			dlist_node_push(list, dlist_node_new(list, int_copy(key), NULL));
+		for(key = 500; key < 502; ++key)
+			dlist_node_append(list, dlist_node_new(list, int_copy(key), NULL));
+		assert( hash_has(list, 0, 1000, 1) );
+		//reordering keeps it as it is
+		dlist_list_reverse(list);
+		assert( hash_has(list, 0, 1000, 1) );
+		dlist_list_delete_all_nodes(list);
+		assert( hash_has(list, 0, 1000, 0) );
+		for(int i = 0; i < 1000; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		assert( hash_has(list, 0, 1000, 1) );
+		//split moving the short suffix, then the short prefix
+		key = 900;
+		assert( (n_list = dlist_hash_split(list, &key)) );
+		assert( list_is(list, expect, 900) && list_is(n_list, expect + 900, 100) );
+		assert( hash_has(list, 0, 900, 1) && hash_has(list, 900, 1000, 0) );
+		assert( hash_has(n_list, 900, 1000, 1) && hash_has(n_list, 0, 900, 0) );
+		assert( list == dlist_list_append(list, n_list) );
+		assert( hash_has(list, 0, 1000, 1) && hash_has(n_list, 0, 1000, 0) );
+		dlist_list_delete(n_list);
+		key = 100;
+		assert( (n_list = dlist_hash_split(list, &key)) );
+		assert( list_is(list, expect, 100) && list_is(n_list, expect + 100, 900) );
+		assert( hash_has(list, 0, 100, 1) && hash_has(list, 100, 1000, 0) );
+		assert( hash_has(n_list, 100, 1000, 1) && hash_has(n_list, 0, 100, 0) );
+		assert( n_list == dlist_list_push(n_list, list) );
+		assert( hash_has(n_list, 0, 1000, 1) && hash_has(list, 0, 1000, 0) );
+		//pushing into a list without index leaves it without one
+		dlist_hash_detach(list);
+		assert( list == dlist_list_push(list, n_list) );
+		assert( NULL == dlist_hash_find(list, &key) );
+		assert( hash_has(n_list, 0, 1000, 0) );
+		dlist_list_delete(n_list);
+		//with the position index it goes by rank, @ head too
+		assert( list == dlist_hash_attach(list, hash_int, cmp_int) );
+		assert( list == dlist_skip_attach(list) );
+		key = 300;
+		assert( (n_list = dlist_hash_split(list, &key)) );
+		assert( list_is(list, expect, 300) && list_is(n_list, expect + 300, 700) );
+		assert( hash_has(n_list, 300, 1000, 1) && hash_has(list, 0, 300, 1) );
+		key = 0;
+		node = list->head;
+		assert( (s_list = dlist_hash_split(list, &key)) );
+		assert( 0 == list->count && NULL == dlist_hash_find(list, &key) );
+		dlist_list_append(n_list, s_list);
+		dlist_list_delete(s_list);
+		assert( node == dlist_hash_find(n_list, &key) );
+		assert( hash_has(n_list, 0, 1000, 1) );
+#ifndef DLIST_COMPACT_NODE
+		//inline nodes are indexed through their payload
+		key = 2000;
+		dlist_node_append(n_list, dlist_node_new_inline(n_list, &key, sizeof( int)));
+		assert( (node = dlist_hash_find(n_list, &key)) );
+		assert( node == dlist_hash_remove(n_list, &key) );
+		assert( NULL == dlist_hash_find(n_list, &key) );
+		dlist_node_delete(n_list, node);
+#endif
+		dlist_list_delete_all_nodes(n_list);
+		dlist_list_delete(n_list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist sorted insert/find/bounds/merge");
+
+		struct dlist_list *list;
+		struct dlist_list *s_list;
+		struct dlist_node *node;
+		int expect[200];
+		int key = 0;
+		list = dlist_list_new(NULL, NULL);
+		s_list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		dlist_data_dalloc(s_list, int_dalloc);
+		node = dlist_node_new(list, int_copy(0), NULL);
+		//test failures
+		assert( NULL == dlist_node_insert_sorted(NULL, node, cmp3_int) );
+		assert( NULL == dlist_node_insert_sorted(list, NULL, cmp3_int) );
+		assert( NULL == dlist_node_insert_sorted(list, node, NULL) );
+		assert( NULL == dlist_node_find_sorted(list, &key, cmp3_int) );
+		assert( NULL == dlist_node_lower_bound(list, &key, cmp3_int) );
+		assert( NULL == dlist_node_upper_bound(list, &key, cmp3_int) );
+		assert( NULL == dlist_list_merge_sorted(list, s_list, cmp3_int) );
+		dlist_node_delete(list, node);
+		//equal keys keep insertion order, indexes follow every insert
+		dlist_skip_attach(list);
+		dlist_hash_attach(list, hash_int, cmp_int);
+		for(int units = 0; units < 10; ++units)
+			for(int i = 0; i < 10; ++i)
+			{
+				key = (i * 7 % 10) * 10 + units;
+				node = dlist_node_new(list, int_copy(key), NULL);
+				assert( node == dlist_node_insert_sorted(list, node, cmp3_tens) );
+				assert( cursor_ok(list) );
+			}
+		for(int i = 0; i < 100; ++i)
+			expect[i] = i;
+		assert( list_is(list, expect, 100) && hash_has(list, 0, 100, 1) );
+		//find gives up once past the key
+		key = 55;
+		cmp3_calls = 0;
+		list->cursor.node = NULL;
+		assert( 55 == *(int*)dlist_node_find_sorted(list, &key, cmp3_count)->data );
+		assert( 58 == cmp3_calls );
+		key = 100;
+		cmp3_calls = 0;
+		assert( NULL == dlist_node_find_sorted(list, &key, cmp3_count) );
+		assert( 1 == cmp3_calls );
+		key = -1;
+		assert( NULL == dlist_node_find_sorted(list, &key, cmp3_int) );
+		//bounds over a run of equal keys
+		key = 42;
+		node = dlist_node_lower_bound(list, &key, cmp3_tens);
+		assert( 40 == *(int*)node->data );
+		assert( node == list->cursor.node && 41 == list->cursor.index );
+		node = dlist_node_upper_bound(list, &key, cmp3_tens);
+		assert( 50 == *(int*)node->data && 51 == dlist_node_index_of(list, node) );
+		//from a cursor already past the key it starts over
+		key = 12;
+		assert( 10 == *(int*)dlist_node_lower_bound(list, &key, cmp3_tens)->data );
+		key = 99;
+		assert( NULL == dlist_node_upper_bound(list, &key, cmp3_tens) );
+		assert( list->tail == dlist_node_lower_bound(list, &key, cmp3_int) );
+		assert( NULL == dlist_node_upper_bound(list, &key, cmp3_int) );
+		//merge the odd numbers into the even ones
+		dlist_list_delete_all_nodes(list);
+		for(int i = 0; i < 200; ++i)
+		{
+			expect[i] = i;
+			if ( i % 2 )
+				dlist_node_append(s_list, dlist_node_new(s_list, int_copy(i), NULL));
+			else
+				dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		}
+		assert( NULL == dlist_list_merge_sorted(list, NULL, cmp3_int) );
+		assert( NULL == dlist_list_merge_sorted(list, s_list, NULL) );
+		assert( list == dlist_list_merge_sorted(list, s_list, cmp3_int) );
+		assert( 0 == s_list->count && NULL == s_list->head && NULL == s_list->tail );
+		assert( list_is(list, expect, 200) && hash_has(list, 0, 200, 1) );
+		//on ties the nodes already in 'list' go first
+		node = dlist_node_append(s_list, dlist_node_new(s_list, int_copy(199), NULL));
+		dlist_node_push(s_list, dlist_node_new(s_list, int_copy(-1), NULL));
+		assert( list == dlist_list_merge_sorted(list, s_list, cmp3_int) );
+		assert( node == list->tail && 199 == *(int*)node->prev->data );
+		assert( -1 == *(int*)list->head->data && 202 == list->count );
+		//and already ordered lists are just appended
+		dlist_node_append(s_list, dlist_node_new(s_list, int_copy(500), NULL));
+		assert( list == dlist_list_merge_sorted(list, s_list, cmp3_int) );
+		assert( 500 == *(int*)list->tail->data && 203 == list->count );
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+		dlist_list_delete(s_list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_list_sort");
+
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		struct dlist_list *list;
+		int expect[1000];
+		int n = 0;
+		count_ctx_init(&allocator, &ctx);
+		list = dlist_list_new_allocator(&allocator);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_list_sort(NULL, cmp3_int) );
+		assert( NULL == dlist_list_sort(list, cmp3_int) );
+		dlist_node_append(list, dlist_node_new(list, int_copy(0), NULL));
+		assert( NULL == dlist_list_sort(list, NULL) );
+		//every length up to a few runs, against a sorted array
+		for(int len = 1; len <= 40; ++len)
+		{
+			dlist_list_delete_all_nodes(list);
+			for(int i = 0; i < len; ++i)
+			{
+				expect[i] = i;
+				dlist_node_push(list, dlist_node_new(list, int_copy(i), NULL));
+			}
+			assert( list == dlist_list_sort(list, cmp3_int) );
+			assert( list_is(list, expect, len) );
+		}
+		//stable: by tens, the units keep the order they had
+		dlist_list_delete_all_nodes(list);
+		for(int tens = 0; tens < 100; ++tens)
+			for(int units = 0; units < 10; ++units)
+				expect[n++] = tens * 10 + units;
+		for(int i = 0; i < 1000; ++i)
+			dlist_node_append(list, dlist_node_new(list,
+				int_copy((i * 7 % 100) * 10 + i / 100), NULL));
+		assert( list == dlist_hash_attach(list, hash_int, cmp_int) );
+		assert( list == dlist_skip_attach(list) );
+		ctx.allocs = 0;
+		assert( list == dlist_list_sort(list, cmp3_tens) );
+		assert( 0 == ctx.allocs );
+		assert( list_is(list, expect, 1000) );
+		assert( hash_has(list, 0, 1000, 1) );
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_list_radix_sort");
+
+		struct dlist_list *list;
+		int expect[1000];
+		int n = 0;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_list_radix_sort(NULL, key_int, 4) );
+		assert( NULL == dlist_list_radix_sort(list, key_int, 4) );
+		dlist_node_append(list, dlist_node_new(list, int_copy(0), NULL));
+		assert( NULL == dlist_list_radix_sort(list, NULL, 4) );
+		assert( NULL == dlist_list_radix_sort(list, key_int, 0) );
+		assert( NULL == dlist_list_radix_sort(list, key_int, 9) );
+		assert( list == dlist_list_radix_sort(list, key_int, 8) );
+		dlist_list_delete_all_nodes(list);
+		//stable: by tens, the units keep the order they had
+		for(int tens = 0; tens < 100; ++tens)
+			for(int units = 0; units < 10; ++units)
+				expect[n++] = tens * 10 + units;
+		for(int i = 0; i < 1000; ++i)
+			dlist_node_append(list, dlist_node_new(list,
+				int_copy((i * 7 % 100) * 10 + i / 100), NULL));
+		dlist_skip_attach(list);
+		assert( list == dlist_list_radix_sort(list, key_tens, 1) );
+		assert( list_is(list, expect, 1000) );
+		assert( NULL == list->head->prev );
+		dlist_list_delete_all_nodes(list);
+		//keys over several bytes, a constant one in the middle skipped
+		for(int i = 0; i < 1000; ++i)
+			expect[i] = 0x30000 + i % 256 + (i / 256) * 0x1000000;
+		for(int i = 0; i < 1000; ++i)
+			dlist_node_push(list, dlist_node_new(list, int_copy(expect[i * 7 % 1000]), NULL));
+		assert( list == dlist_list_radix_sort(list, key_int, 4) );
+		assert( list_is(list, expect, 1000) );
+		assert( NULL == list->head->prev );
+		//only the low byte taken, the rest stays in order
+		assert( list == dlist_list_radix_sort(list, key_int, 1) );
+		assert( 0x30000 == *(int*)list->head->data );
+		assert( 0x30000 + 0x1000000 == *(int*)dlist_node_get_at(list, 2)->data );
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_list_merge_k");
+
+		struct dlist_list *list;
+		struct dlist_list *lists[40];
+		int expect[1000];
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		for(int i = 0; i < 40; ++i)
+			lists[i] = dlist_list_new(NULL, NULL);
+		//test failures
+		assert( NULL == dlist_list_merge_k(NULL, lists, 40, cmp3_int) );
+		assert( NULL == dlist_list_merge_k(list, NULL, 40, cmp3_int) );
+		assert( NULL == dlist_list_merge_k(list, lists, 40, NULL) );
+		//nothing to merge
+		assert( list == dlist_list_merge_k(list, lists, 0, cmp3_int) );
+		assert( list == dlist_list_merge_k(list, lists, 40, cmp3_int) );
+		assert( 0 == list->count && NULL == list->head && NULL == list->tail );
+		//the units tell the inputs apart: 0 in 'list', the rest in 'lists'
+		for(int i = 0; i < 1000; ++i)
+		{
+			expect[i] = i;
+			if ( 0 == i % 10 )
+				dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+			else
+				dlist_node_append(lists[i % 10 - 1],
+					dlist_node_new(lists[i % 10 - 1], int_copy(i), NULL));
+		}
+		dlist_list_delete(lists[9]);
+		lists[9] = NULL;
+		dlist_hash_attach(list, hash_int, cmp_int);
+		dlist_hash_attach(lists[3], hash_int, cmp_int);
+		//equal tens, so ties are settled by where each node came from
+		assert( list == dlist_list_merge_k(list, lists, 40, cmp3_tens) );
+		assert( list_is(list, expect, 1000) );
+		assert( hash_has(list, 0, 1000, 1) && hash_has(lists[3], 0, 1000, 0) );
+		for(int i = 0; i < 40; ++i)
+			assert( 9 == i || (0 == lists[i]->count && NULL == lists[i]->head
+					   && NULL == lists[i]->tail) );
+		//and with a single input left it is linked as it is
+		dlist_node_append(lists[0], dlist_node_new(lists[0], int_copy(1000), NULL));
+		dlist_node_append(lists[0], dlist_node_new(lists[0], int_copy(1001), NULL));
+		assert( list == dlist_list_merge_k(list, lists, 1, cmp3_int) );
+		assert( 1002 == list->count && 1001 == *(int*)list->tail->data );
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+		for(int i = 0; i < 40; ++i)
+			dlist_list_delete(lists[i]);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_map_inplace/filter_inplace");
+
+		struct dlist_list *list;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		size_t allocs;
+		int expect[100];
+		int key;
+		count_ctx_init(&allocator, &ctx);
+		list = dlist_list_new_allocator(&allocator);
+		dlist_data_dalloc(list, count_dalloc);
+		//test failures
+		assert( NULL == dlist_map_inplace(NULL, double_int, true) );
+		assert( NULL == dlist_map_inplace(list, double_int, true) );
+		assert( NULL == dlist_filter_inplace(NULL, is_even) );
+		assert( NULL == dlist_filter_inplace(list, is_even) );
+		for(int i = 0; i < 100; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		assert( NULL == dlist_map_inplace(list, NULL, true) );
+		assert( NULL == dlist_filter_inplace(list, NULL) );
+		//both indexes and the cursor are kept in step
+		assert( list == dlist_skip_attach(list) );
+		assert( list == dlist_hash_attach(list, hash_int, cmp_int) );
+		dlist_node_get_at(list, 61);
+		dalloc_calls = 0;
+		allocs = ctx.allocs;
+		assert( list == dlist_filter_inplace(list, is_even) );
+		assert( allocs == ctx.allocs );
+		assert( 50 == dalloc_calls );
+		assert( 50 == ctx.dallocs );
+		for(int i = 0; i < 50; ++i)
+			expect[i] = i * 2;
+		assert( cursor_ok(list) );
+		assert( 60 == *(int*)list->cursor.node->data );
+		assert( list_is(list, expect, 50) );
+		for(int i = 0; i < 100; i += 2)
+			assert( hash_has(list, i, i + 1, 1) && hash_has(list, i + 1, i + 2, 0) );
+		//new payloads, the old ones deleted
+		dalloc_calls = 0;
+		allocs = ctx.allocs;
+		assert( list == dlist_map_inplace(list, double_int, true) );
+		assert( allocs == ctx.allocs );
+		assert( 50 == dalloc_calls );
+		for(int i = 0; i < 50; ++i)
+			expect[i] = i * 4;
+		assert( list_is(list, expect, 50) );
+		key = 8;
+		assert( 8 == *(int*)dlist_hash_find(list, &key)->data );
+		key = 2;
+		assert( NULL == dlist_hash_find(list, &key) );
+		//the same payload handed back is never deleted
+		dalloc_calls = 0;
+		assert( list == dlist_map_inplace(list, inc_int, true) );
+		assert( 0 == dalloc_calls );
+		assert( 1 == *(int*)list->head->data && 197 == *(int*)list->tail->data );
+		//rejecting everything leaves it empty
+		assert( list == dlist_filter_inplace(list, is_even) );
+		assert( 50 == dalloc_calls );
+		assert( 0 == list->count && NULL == list->head && NULL == list->tail );
+		assert( NULL == list->cursor.node );
+		key = 1;
+		assert( NULL == dlist_hash_find(list, &key) );
+		dlist_hash_detach(list);
+		dlist_skip_detach(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_node_foreach_batch/map_batch/fold_batch");
+
+		struct dlist_list *list;
+		struct dlist_list *mapped;
+		struct dlist_node *node;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		int sum = 0;
+		int idx = 0;
+		count_ctx_init(&allocator, &ctx);
+		list = dlist_list_new_allocator(&allocator);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		batch_calls = 0;
+		dlist_node_foreach_batch(NULL, sum_batch, &sum);
+		dlist_node_foreach_batch(list, sum_batch, &sum);
+		assert( NULL == dlist_map_batch(NULL, double_batch, int_dalloc) );
+		assert( NULL == dlist_map_batch(list, double_batch, int_dalloc) );
+		assert( NULL == dlist_fold_batch(NULL, &sum, add_batch) );
+		assert( &sum == dlist_fold_batch(list, &sum, add_batch) );
+		assert( 0 == batch_calls );
+		for(int i = 0; i < 3 * DLIST_BATCH_SIZE + 8; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		dlist_node_foreach_batch(list, NULL, &sum);
+		assert( NULL == dlist_map_batch(list, NULL, int_dalloc) );
+		assert( &sum == dlist_fold_batch(list, &sum, NULL) );
+		//full batches, the remainder in the last one
+		dlist_node_foreach_batch(list, sum_batch, &sum);
+		assert( 4 == batch_calls && 8 == batch_last );
+		assert( (3 * DLIST_BATCH_SIZE + 8) * (3 * DLIST_BATCH_SIZE + 7) / 2 == sum );
+		batch_calls = 0;
+		sum = 0;
+		assert( &sum == dlist_fold_batch(list, &sum, add_batch) );
+		assert( 4 == batch_calls );
+		assert( (3 * DLIST_BATCH_SIZE + 8) * (3 * DLIST_BATCH_SIZE + 7) / 2 == sum );
+		//map takes its nodes a batch at a time too
+		count_ctx_init(&allocator, &ctx);
+		batch_calls = 0;
+		assert( (mapped = dlist_map_batch(list, double_batch, int_dalloc)) );
+		assert( 4 == batch_calls );
+		assert( 4 == ctx.bulk_allocs && 0 == ctx.allocs );
+		assert( int_dalloc == mapped->data_dalloc );
+		assert( 3 * DLIST_BATCH_SIZE + 8 == mapped->count );
+		for(node = mapped->head; node; node = node->next, ++idx)
+			assert( idx * 2 == *(int*)node->data && (!node->next || node == node->next->prev) );
+		assert( 2 * (idx - 1) == *(int*)mapped->tail->data );
+		dlist_list_delete_all_nodes(mapped);
+		dlist_list_delete(mapped);
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_fold_parallel");
+
+		struct dlist_list *list;
+		struct run run;
+		int sum = 0;
+		int n = 20 * 1024 + 7;
+		size_t threads[] = { 0, 1, 2, 4, 7, 20, 100 };
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_fold_parallel(NULL, &sum, add_int, combine_int,
+						    int_zero, 4) );
+		assert( &sum == dlist_fold_parallel(list, &sum, NULL, combine_int,
+						    int_zero, 4) );
+		assert( NULL == dlist_fold_parallel(list, &sum, add_int, NULL,
+						    int_zero, 4) );
+		assert( NULL == dlist_fold_parallel(list, &sum, add_int, combine_int,
+						    NULL, 4) );
+		//empty, and too short to be worth a thread
+		assert( &sum == dlist_fold_parallel(list, &sum, add_int, combine_int,
+						    int_zero, 4) );
+		for(int i = 0; i < 100; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		assert( &sum == dlist_fold_parallel(list, &sum, add_int, combine_int,
+						    int_zero, 4) );
+		assert( 4950 == sum );
+		for(int i = 100; i < n; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		//the plain dlist_fold callback works whatever the length, the
+		//first segment folding into 'initial', the rest into 'identity' ones
+		for(size_t t = 0; t < sizeof( threads) / sizeof( *threads); ++t)
+		{
+			sum = 0;
+			assert( &sum == dlist_fold_parallel(list, &sum, add_int,
+							    combine_int, int_zero,
+							    threads[t]) );
+			assert( (long)n * (n - 1) / 2 == sum );
+			//partial results come back in list order
+			run = (struct run){ -1, -1, 1 };
+			assert( &run == dlist_fold_parallel(list, &run, run_fold,
+							    run_combine, run_new,
+							    threads[t]) );
+			assert( run.ok && 0 == run.first && n - 1 == run.last );
+		}
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("dlist_map_parallel/filter_parallel");
+
+		struct dlist_list *list;
+		struct dlist_list *serial;
+		struct dlist_list *parallel;
+		size_t threads[] = { 0, 1, 3, 8, 20 };
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == dlist_map_parallel(NULL, double_int, int_dalloc, 4) );
+		assert( NULL == dlist_map_parallel(list, double_int, int_dalloc, 4) );
+		assert( NULL == dlist_filter_parallel(NULL, is_even, 4) );
+		assert( NULL == dlist_filter_parallel(list, is_even, 4) );
+		for(int i = 0; i < 20 * 1024 + 5; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		assert( NULL == dlist_map_parallel(list, NULL, int_dalloc, 4) );
+		assert( NULL == dlist_filter_parallel(list, NULL, 4) );
+		//results match the serial ones exactly
+		for(size_t t = 0; t < sizeof( threads) / sizeof( *threads); ++t)
+		{
+			serial = dlist_map(list, double_int, int_dalloc);
+			assert( (parallel = dlist_map_parallel(list, double_int,
+							       int_dalloc, threads[t])) );
+			assert( same_ints(serial, parallel) );
+			assert( int_dalloc == parallel->data_dalloc );
+			dlist_list_delete_all_nodes(serial);
+			dlist_list_delete(serial);
+			dlist_list_delete_all_nodes(parallel);
+			dlist_list_delete(parallel);
+			//elements are shared, not copied
+			serial = dlist_filter(list, is_even);
+			assert( (parallel = dlist_filter_parallel(list, is_even, threads[t])) );
+			assert( same_ints(serial, parallel) );
+			assert( NULL == parallel->data_dalloc );
+			assert( list->tail->data == parallel->tail->data );
+			dlist_list_delete_all_nodes(serial);
+			dlist_list_delete(serial);
+			dlist_list_delete_all_nodes(parallel);
+			dlist_list_delete(parallel);
+			//segments left with nothing
+			serial = dlist_filter(list, under_1500);
+			assert( (parallel = dlist_filter_parallel(list, under_1500, threads[t])) );
+			assert( same_ints(serial, parallel) );
+			dlist_list_delete_all_nodes(serial);
+			dlist_list_delete(serial);
+			dlist_list_delete_all_nodes(parallel);
+			dlist_list_delete(parallel);
+			assert( (parallel = dlist_filter_parallel(list, is_negative, threads[t])) );
+			assert( 0 == parallel->count && NULL == parallel->head );
+			dlist_list_delete(parallel);
+		}
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
 	return 0;
 }
@@ -0,0 +1,333 @@
+/*
+ * magazine.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "magazine.h"
+
+/****************************************************************************
+ * internal helpers
+ ****************************************************************************/
+
+//takes an empty magazine from 'depot', 'lock' must be held
+static struct magazine *magazine_take_empty(struct magazine_depot *depot)
+{
+	struct magazine *mag = depot->empty;
+
+	if ( mag ) {
+		depot->empty = mag->next;
+		return mag;
+	}
+
+	if ( NULL == (mag = malloc( sizeof( struct magazine))) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	mag->next = NULL;
+	mag->rounds = 0;
+	return mag;
+}/* magazine_take_empty */
+
+
+//hands 'mag' to 'depot' full or empty stack, 'lock' must be held
+static void magazine_give(struct magazine_depot *depot, struct magazine *mag)
+{
+	if ( mag->rounds ) {
+		mag->next = depot->full;
+		depot->full = mag;
+	} else {
+		mag->next = depot->empty;
+		depot->empty = mag;
+	}
+}/* magazine_give */
+
+
+static void magazine_cache_destroy(void *ptr)
+{
+	struct magazine_cache *cache = ptr;
+	struct magazine_depot *depot = cache->depot;
+
+	pthread_mutex_lock(&depot->lock);
+	magazine_give(depot, cache->loaded);
+	magazine_give(depot, cache->previous);
+	pthread_mutex_unlock(&depot->lock);
+
+	free(cache);
+}/* magazine_cache_destroy */
+
+
+static struct magazine_cache *magazine_cache_get(struct magazine_depot *depot)
+{
+	struct magazine_cache *cache = pthread_getspecific(depot->key);
+
+	if ( cache )
+		return cache;
+
+	if ( NULL == (cache = malloc( sizeof( struct magazine_cache))) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	cache->depot = depot;
+	pthread_mutex_lock(&depot->lock);
+	cache->loaded = magazine_take_empty(depot);
+	cache->previous = magazine_take_empty(depot);
+
+	if ( !cache->loaded || !cache->previous ) {
+		if ( cache->loaded )
+			magazine_give(depot, cache->loaded);
+		if ( cache->previous )
+			magazine_give(depot, cache->previous);
+
+		pthread_mutex_unlock(&depot->lock);
+		free(cache);
+		return NULL;
+	}
+
+	pthread_mutex_unlock(&depot->lock);
+	pthread_setspecific(depot->key, cache);
+
+	return cache;
+}/* magazine_cache_get */
+
+
+static void *magazine_vt_alloc(void *ctx, size_t size)
+{
+	struct magazine_depot *depot = ctx;
+
+	if ( size > depot->slab.slot_size )
+		return NULL;
+
+	return magazine_alloc(depot);
+}/* magazine_vt_alloc */
+
+
+static void magazine_vt_dalloc(void *ctx, void *ptr)
+{
+	magazine_dalloc(ctx, ptr);
+}/* magazine_vt_dalloc */
+
+
+static size_t magazine_vt_bulk_alloc(void *ctx, size_t size, void **ptrs,
+				     size_t n)
+{
+	size_t idx;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+		if ( NULL == (ptrs[idx] = magazine_vt_alloc(ctx, size)) )
+			break;
+	}
+
+	return idx;
+}/* magazine_vt_bulk_alloc */
+
+
+static void magazine_vt_bulk_dalloc(void *ctx, void **ptrs, size_t n)
+{
+	for(size_t idx = 0; idx < n; ++idx)
+		magazine_dalloc(ctx, ptrs[idx]);
+}/* magazine_vt_bulk_dalloc */
+
+
+/****************************************************************************
+ * magazine library interface implementation
+ ****************************************************************************/
+
+struct magazine_depot *magazine_depot_init(struct magazine_depot *depot,
+					   size_t slot_size)
+{
+	if ( !depot || !slot_size )
+		return NULL;
+
+	if ( !slab_init(&depot->slab, slot_size, 0) )
+		return NULL;
+
+	if ( pthread_mutex_init(&depot->lock, NULL) )
+		return NULL;
+
+	if ( pthread_key_create(&depot->key, magazine_cache_destroy) ) {
+		pthread_mutex_destroy(&depot->lock);
+		return NULL;
+	}
+
+	depot->full = NULL;
+	depot->empty = NULL;
+
+	depot->allocator.ctx = depot;
+	depot->allocator.alloc = magazine_vt_alloc;
+	depot->allocator.dalloc = magazine_vt_dalloc;
+	depot->allocator.bulk_alloc = magazine_vt_bulk_alloc;
+	depot->allocator.bulk_dalloc = magazine_vt_bulk_dalloc;
+	depot->allocator.reset = NULL;
+
+	return depot;
+}/* magazine_depot_init */
+
+
+void *magazine_alloc(struct magazine_depot *depot)
+{
+	if ( !depot )
+		return NULL;
+
+	struct magazine_cache *cache = magazine_cache_get(depot);
+	struct magazine *mag = NULL;
+
+	if ( !cache )
+		return NULL;
+
+	//fast path, no locking
+	if ( cache->loaded->rounds )
+		return cache->loaded->slots[--cache->loaded->rounds];
+
+	if ( cache->previous->rounds ) {
+		mag = cache->loaded;
+		cache->loaded = cache->previous;
+		cache->previous = mag;
+		return cache->loaded->slots[--cache->loaded->rounds];
+	}
+
+	pthread_mutex_lock(&depot->lock);
+
+	//swap an empty magazine for a full one
+	if ( depot->full ) {
+		mag = depot->full;
+		depot->full = mag->next;
+		magazine_give(depot, cache->previous);
+		cache->previous = cache->loaded;
+		cache->loaded = mag;
+		pthread_mutex_unlock(&depot->lock);
+
+		return cache->loaded->slots[--cache->loaded->rounds];
+	}
+
+	//nothing to exchange, load half a magazine straight from the slab
+	mag = cache->loaded;
+	while ( mag->rounds < MAGAZINE_ROUNDS / 2 )
+	{
+		void *slot = slab_alloc(&depot->slab);
+		if ( !slot )
+			break;
+
+		mag->slots[mag->rounds++] = slot;
+	}
+
+	pthread_mutex_unlock(&depot->lock);
+
+	if ( !mag->rounds )
+		return NULL;
+
+	return mag->slots[--mag->rounds];
+}/* magazine_alloc */
+
+
+void magazine_dalloc(struct magazine_depot *depot, void *ptr)
+{
+	if ( !depot || !ptr )
+		return;
+
+	struct magazine_cache *cache = magazine_cache_get(depot);
+	struct magazine *mag = NULL;
+
+	//no cache to hold it, straight back to the slab
+	if ( !cache ) {
+		pthread_mutex_lock(&depot->lock);
+		slab_dalloc(&depot->slab, ptr);
+		pthread_mutex_unlock(&depot->lock);
+		return;
+	}
+
+	//fast path, no locking
+	if ( MAGAZINE_ROUNDS > cache->loaded->rounds ) {
+		cache->loaded->slots[cache->loaded->rounds++] = ptr;
+		return;
+	}
+
+	if ( MAGAZINE_ROUNDS > cache->previous->rounds ) {
+		mag = cache->loaded;
+		cache->loaded = cache->previous;
+		cache->previous = mag;
+		cache->loaded->slots[cache->loaded->rounds++] = ptr;
+		return;
+	}
+
+	//both full, hand one to the depot as a whole batch
+	pthread_mutex_lock(&depot->lock);
+	mag = magazine_take_empty(depot);
+	if ( !mag ) {
+		slab_dalloc(&depot->slab, ptr);
+		pthread_mutex_unlock(&depot->lock);
+		return;
+	}
+
+	magazine_give(depot, cache->previous);
+	pthread_mutex_unlock(&depot->lock);
+
+	cache->previous = cache->loaded;
+	cache->loaded = mag;
+	cache->loaded->slots[cache->loaded->rounds++] = ptr;
+}/* magazine_dalloc */
+
+
+void magazine_flush(struct magazine_depot *depot)
+{
+	if ( !depot )
+		return;
+
+	struct magazine_cache *cache = pthread_getspecific(depot->key);
+
+	if ( !cache )
+		return;
+
+	pthread_setspecific(depot->key, NULL);
+	magazine_cache_destroy(cache);
+}/* magazine_flush */
+
+
+void magazine_depot_release(struct magazine_depot *depot)
+{
+	if ( !depot )
+		return;
+
+	struct magazine *mag = NULL;
+
+	magazine_flush(depot);
+	pthread_key_delete(depot->key);
+
+	//slots all live in the slab, only the magazines need freeing
+	while ( NULL != (mag = depot->full) )
+	{
+		depot->full = mag->next;
+		free(mag);
+	}
+
+	while ( NULL != (mag = depot->empty) )
+	{
+		depot->empty = mag->next;
+		free(mag);
+	}
+
+	slab_release(&depot->slab);
+	pthread_mutex_destroy(&depot->lock);
+}/* magazine_depot_release */
@@ -0,0 +1,149 @@
+/*
+ * magazine.h
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#ifndef DUTILS_MAGAZINE_H_
+#define DUTILS_MAGAZINE_H_
+
+/****************************************************************************
+ * standard libraries
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "allocator.h"
+#include "slab.h"
+
+//slots held by a single magazine
+#define MAGAZINE_ROUNDS 64
+
+
+/****************************************************************************
+ * base data structures
+ ****************************************************************************/
+
+struct magazine
+{
+	struct magazine *next;
+	size_t rounds;
+	void *slots[MAGAZINE_ROUNDS];
+};
+
+struct magazine_depot;
+
+//per thread cache, one per thread and depot
+struct magazine_cache
+{
+	struct magazine_depot *depot;
+	struct magazine *loaded;
+	struct magazine *previous;
+};
+
+/* shared by every thread. threads allocate from and free into their own
+ * magazines, only going to the depot, under 'lock', to exchange a whole
+ * magazine at a time.
+ */
+struct magazine_depot
+{
+	pthread_mutex_t lock;
+	pthread_key_t key;
+	struct slab slab;
+	struct magazine *full;
+	struct magazine *empty;
+	struct dutils_allocator allocator;
+};
+
+
+/****************************************************************************
+ * convinience data types for library consumers/users
+ ****************************************************************************/
+
+typedef struct magazine_depot magazine_depot_t;
+
+
+/****************************************************************************
+ * library interface and _base_ documentation
+ ****************************************************************************/
+
+/* returns 'depot' initialized to hand out 'slot_size' bytes slots
+ * returns NULL if 'depot' is NULL
+ * returns NULL if 'slot_size' is 0
+ * returns NULL if the thread specific key or the lock can't be created
+ *
+ * ABOUT ['allocator']: ready to be used with dlist_init_allocator and
+ * ------- friends. it is thread safe, nodes may be created by one thread
+ * ------- and deleted by another. requests bigger then 'slot_size' fail.
+ * ABOUT [backing]: slots come from a slab (see slab.h) guarded by 'lock',
+ * ------- they are only given back to the system by magazine_depot_release
+ *
+ * passing invalid ['depot']
+ * ------- results in undefined behavior
+ */
+struct magazine_depot *magazine_depot_init(struct magazine_depot *depot,
+					   size_t slot_size);
+
+
+/* returns a slot from the calling thread magazines
+ * returns NULL if 'depot' is NULL
+ * returns NULL if memory can't be allocated
+ *
+ * passing invalid ['depot']
+ * ------- results in undefined behavior
+ */
+void *magazine_alloc(struct magazine_depot *depot);
+
+
+/* gives 'ptr' back to the calling thread magazines, full magazines are
+ * ------- handed to the depot as a whole.
+ * passing NULL in 'depot' returns with no operation executed
+ * passing NULL in 'ptr' returns with no operation executed
+ *
+ * ABOUT [threads]: 'ptr' may have been allocated by any thread.
+ *
+ * passing a 'ptr' not returned by magazine_alloc on the same 'depot'
+ * ------- results in undefined behavior
+ */
+void magazine_dalloc(struct magazine_depot *depot, void *ptr);
+
+
+/* hands the calling thread magazines back to 'depot'
+ * passing NULL in 'depot' returns with no operation executed
+ *
+ * NOTE: done on its own when a thread exits.
+ *
+ * passing invalid ['depot']
+ * ------- results in undefined behavior
+ */
+void magazine_flush(struct magazine_depot *depot);
+
+
+/* frees every slot and magazine of 'depot'
+ * passing NULL in 'depot' returns with no operation executed
+ *
+ * NOTE: the calling thread is flushed first, every other thread using
+ * ------- 'depot' needs to have exited or called magazine_flush.
+ * ------- slots still in use become invalid.
+ *
+ * passing invalid ['depot']
+ * ------- results in undefined behavior
+ */
+void magazine_depot_release(struct magazine_depot *depot);
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * magazine.t.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "magazine.h"
+#include "dlist.h"
+#include <stdio.h>
+
+#include <assert.h>
+
+#define LOUD
+#include "common.h"
+
+#define NODES 10000
+
+//builds a list of NODES nodes out of the depot in its own thread
+void *producer(void *arg)
+{
+	struct dlist_list *list = arg;
+	struct dlist_node *node;
+
+	for(int i = 0; i < NODES; ++i)
+	{
+		node = dlist_node_new(list, NULL, NULL);
+		assert( node );
+		dlist_node_append(list, node);
+	}
+
+	return NULL;
+}
+
+int main(int argc, char **argv)
+{
+	wmsg("testing magazine lib interface\n");
+
+	{
+		wmsg("magazine_depot_init");
+
+		struct magazine_depot depot;
+		assert( NULL == magazine_depot_init(NULL, 32) );
+		assert( NULL == magazine_depot_init(&depot, 0) );
+		assert( magazine_depot_init(&depot, sizeof( struct dlist_node)) );
+		assert( NULL == depot.full );
+		assert( NULL == depot.empty );
+		assert( &depot == depot.allocator.ctx );
+		magazine_depot_release(&depot);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("magazine_alloc/dalloc");
+
+		struct magazine_depot depot;
+		void *slots[MAGAZINE_ROUNDS * 3];
+		void *a;
+		magazine_depot_init(&depot, sizeof( struct dlist_node));
+		assert( NULL == magazine_alloc(NULL) );
+		magazine_dalloc(NULL, NULL);
+		magazine_dalloc(&depot, NULL);
+		//last freed is first reused, straight from the thread magazine
+		assert( (a = magazine_alloc(&depot)) );
+		magazine_dalloc(&depot, a);
+		assert( a == magazine_alloc(&depot) );
+		magazine_dalloc(&depot, a);
+		//overflow both thread magazines so one goes to the depot
+		for(int i = 0; i < MAGAZINE_ROUNDS * 3; ++i)
+			assert( (slots[i] = magazine_alloc(&depot)) );
+		for(int i = 0; i < MAGAZINE_ROUNDS * 3; ++i)
+			magazine_dalloc(&depot, slots[i]);
+		assert( NULL != depot.full );
+		//and back again
+		for(int i = 0; i < MAGAZINE_ROUNDS * 3; ++i)
+			assert( (slots[i] = magazine_alloc(&depot)) );
+		assert( NULL == depot.full );
+		for(int i = 0; i < MAGAZINE_ROUNDS * 3; ++i)
+			magazine_dalloc(&depot, slots[i]);
+		//flushing hands both thread magazines back
+		magazine_flush(&depot);
+		assert( NULL != depot.full );
+		magazine_depot_release(&depot);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("magazine across threads");
+
+		struct magazine_depot depot;
+		struct dlist_list list;
+		pthread_t thread;
+		size_t pages;
+		magazine_depot_init(&depot, sizeof( struct dlist_node));
+		dlist_init_allocator(&list, &depot.allocator);
+		//nodes created in another thread
+		assert( 0 == pthread_create(&thread, NULL, producer, &list) );
+		assert( 0 == pthread_join(thread, NULL) );
+		assert( NODES == list.count );
+		//the producer magazines went back to the depot on exit
+		assert( NULL != depot.full );
+		//and deleted here
+		dlist_list_delete_all_nodes(&list);
+		assert( 0 == list.count );
+		//a second round reuses the freed slots, once this thread
+		//hands its own magazines back
+		magazine_flush(&depot);
+		pages = depot.slab.page_count;
+		assert( 0 == pthread_create(&thread, NULL, producer, &list) );
+		assert( 0 == pthread_join(thread, NULL) );
+		dlist_list_delete_all_nodes(&list);
+		assert( pages == depot.slab.page_count );
+		magazine_depot_release(&depot);
+
+		wmsg("[OK]\n");
+	}
+
+	return 0;
+}
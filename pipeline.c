@@ -0,0 +1,302 @@
+/*
+ * pipeline.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "pipeline.h"
+
+/****************************************************************************
+ * internal helpers
+ ****************************************************************************/
+
+/* takes whatever comes out of the stages, 'dalloc' being what deletes it.
+ * returns false to stop the walk.
+ */
+typedef bool (*pipeline_sink_func)(void *ctx, void *data,
+				   void (*dalloc)(void *));
+
+
+static struct pipeline *pipeline_over(struct pipeline *pipe,
+				      const struct dlist_list *dlist,
+				      const struct slist_list *slist)
+{
+	pipe->dlist = dlist;
+	pipe->slist = slist;
+	pipe->count = 0;
+
+	return pipe;
+}/* pipeline_over */
+
+
+static struct pipeline *pipeline_add(struct pipeline *pipe,
+				     enum pipeline_kind kind,
+				     pipeline_map_func map,
+				     pipeline_filter_func filter,
+				     void (*dalloc)(void *))
+{
+	struct pipeline_stage *stage;
+
+	if ( PIPELINE_STAGES == pipe->count )
+		return NULL;
+
+	stage = &pipe->stages[pipe->count++];
+	stage->kind = kind;
+	stage->map = map;
+	stage->filter = filter;
+	stage->dalloc = dalloc;
+
+	return pipe;
+}/* pipeline_add */
+
+
+//runs 'data' through every stage, handing what survives to 'sink'
+static bool pipeline_push(const struct pipeline *pipe, void *data,
+			  pipeline_sink_func sink, void *ctx)
+{
+	const struct pipeline_stage *stage = pipe->stages;
+	const struct pipeline_stage *end = stage + pipe->count;
+	//source elements belong to the list, only mapped ones get deleted
+	void (*dalloc)(void *) = NULL;
+	void *next;
+
+	for(; stage < end; ++stage)
+	{
+		if ( PIPELINE_FILTER == stage->kind ) {
+			if ( stage->filter(data) )
+				continue;
+
+			if ( dalloc )
+				dalloc(data);
+
+			return true;
+		}
+
+		next = stage->map(data);
+		if ( dalloc && next != data )
+			dalloc(data);
+
+		data = next;
+		dalloc = stage->dalloc;
+	}
+
+	return sink(ctx, data, dalloc);
+}/* pipeline_push */
+
+
+//the single pass over the source list every terminal shares
+static void pipeline_run(const struct pipeline *pipe,
+			 pipeline_sink_func sink, void *ctx)
+{
+	if ( pipe->dlist ) {
+		for(struct dlist_node *iter = pipe->dlist->head; iter;
+		    iter = iter->next)
+			if ( !pipeline_push(pipe, iter->data, sink, ctx) )
+				return;
+
+		return;
+	}
+
+	for(struct slist_node *iter = pipe->slist->head; iter; iter = iter->next)
+		if ( !pipeline_push(pipe, iter->data, sink, ctx) )
+			return;
+}/* pipeline_run */
+
+
+struct pipeline_fold_ctx
+{
+	pipeline_fold_func func;
+	void *acc;
+};
+
+
+static bool pipeline_fold_sink(void *ctx, void *data, void (*dalloc)(void *))
+{
+	struct pipeline_fold_ctx *fold = ctx;
+
+	fold->acc = fold->func(fold->acc, data);
+	if ( dalloc )
+		dalloc(data);
+
+	return true;
+}/* pipeline_fold_sink */
+
+
+struct pipeline_collect_ctx
+{
+	struct dlist_list *dlist;
+	struct slist_list *slist;
+	bool failed;
+};
+
+
+static bool pipeline_collect_sink(void *ctx, void *data,
+				  void (*dalloc)(void *))
+{
+	struct pipeline_collect_ctx *collect = ctx;
+	struct dlist_node *d_node;
+	struct slist_node *s_node;
+
+	if ( collect->dlist ) {
+		if ( (d_node = dlist_node_new(collect->dlist, data, NULL)) ) {
+			dlist_node_append(collect->dlist, d_node);
+			return true;
+		}
+	} else if ( (s_node = slist_node_new(collect->slist, data, NULL)) ) {
+		slist_node_append(collect->slist, s_node);
+		return true;
+	}
+
+	//nowhere to put it
+	if ( dalloc )
+		dalloc(data);
+
+	collect->failed = true;
+	return false;
+}/* pipeline_collect_sink */
+
+
+static bool pipeline_count_sink(void *ctx, void *data, void (*dalloc)(void *))
+{
+	++*(size_t *)ctx;
+	if ( dalloc )
+		dalloc(data);
+
+	return true;
+}/* pipeline_count_sink */
+
+
+static bool pipeline_first_sink(void *ctx, void *data, void (*dalloc)(void *))
+{
+	*(void **)ctx = data;
+
+	return false;
+}/* pipeline_first_sink */
+
+
+/****************************************************************************
+ * library interface implementation
+ ****************************************************************************/
+
+struct pipeline *pipeline_over_dlist(struct pipeline *pipe,
+				     const struct dlist_list *list)
+{
+	if ( !pipe || !list )
+		return NULL;
+
+	return pipeline_over(pipe, list, NULL);
+}/* pipeline_over_dlist */
+
+
+struct pipeline *pipeline_over_slist(struct pipeline *pipe,
+				     const struct slist_list *list)
+{
+	if ( !pipe || !list )
+		return NULL;
+
+	return pipeline_over(pipe, NULL, list);
+}/* pipeline_over_slist */
+
+
+struct pipeline *pipeline_map(struct pipeline *pipe, pipeline_map_func func,
+			      void (*dalloc)(void *))
+{
+	if ( !pipe || !func )
+		return NULL;
+
+	return pipeline_add(pipe, PIPELINE_MAP, func, NULL, dalloc);
+}/* pipeline_map */
+
+
+struct pipeline *pipeline_filter(struct pipeline *pipe,
+				 pipeline_filter_func func)
+{
+	if ( !pipe || !func )
+		return NULL;
+
+	return pipeline_add(pipe, PIPELINE_FILTER, NULL, func, NULL);
+}/* pipeline_filter */
+
+
+void *pipeline_fold(const struct pipeline *pipe, void *initial,
+		    pipeline_fold_func func)
+{
+	struct pipeline_fold_ctx fold = { func, initial };
+
+	if ( !pipe )
+		return NULL;
+
+	if ( !func )
+		return initial;
+
+	pipeline_run(pipe, pipeline_fold_sink, &fold);
+
+	return fold.acc;
+}/* pipeline_fold */
+
+
+struct dlist_list *pipeline_collect_dlist(const struct pipeline *pipe,
+					  struct dlist_list *out)
+{
+	struct pipeline_collect_ctx collect = { out, NULL, false };
+
+	if ( !pipe || !out )
+		return NULL;
+
+	pipeline_run(pipe, pipeline_collect_sink, &collect);
+
+	return collect.failed ? NULL : out;
+}/* pipeline_collect_dlist */
+
+
+struct slist_list *pipeline_collect_slist(const struct pipeline *pipe,
+					  struct slist_list *out)
+{
+	struct pipeline_collect_ctx collect = { NULL, out, false };
+
+	if ( !pipe || !out )
+		return NULL;
+
+	pipeline_run(pipe, pipeline_collect_sink, &collect);
+
+	return collect.failed ? NULL : out;
+}/* pipeline_collect_slist */
+
+
+size_t pipeline_count(const struct pipeline *pipe)
+{
+	size_t count = 0;
+
+	if ( !pipe )
+		return 0;
+
+	pipeline_run(pipe, pipeline_count_sink, &count);
+
+	return count;
+}/* pipeline_count */
+
+
+void *pipeline_first(const struct pipeline *pipe)
+{
+	void *first = NULL;
+
+	if ( !pipe )
+		return NULL;
+
+	pipeline_run(pipe, pipeline_first_sink, &first);
+
+	return first;
+}/* pipeline_first */
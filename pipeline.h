@@ -0,0 +1,196 @@
+/*
+ * pipeline.h
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#ifndef DUTILS_PIPELINE_H_
+#define DUTILS_PIPELINE_H_
+
+/****************************************************************************
+ * standard libraries
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "dlist.h"
+#include "slist.h"
+
+//stages a single pipeline can record
+#define PIPELINE_STAGES 8
+
+
+/****************************************************************************
+ * functional operations typedefs
+ ****************************************************************************/
+
+typedef void *(*pipeline_map_func)(void *data);
+typedef bool (*pipeline_filter_func)(void *data);
+typedef void *(*pipeline_fold_func)(void *acc, void *data);
+
+
+/****************************************************************************
+ * base data structures
+ ****************************************************************************/
+
+enum pipeline_kind
+{
+	PIPELINE_MAP,
+	PIPELINE_FILTER
+};
+
+struct pipeline_stage
+{
+	enum pipeline_kind kind;
+	pipeline_map_func map;
+	pipeline_filter_func filter;
+	//deletes what 'map' returns once later stages are done with it
+	void (*dalloc)(void *);
+};
+
+/* stages recorded over a source list, nothing runs until a terminal
+ * operation does, then every element goes through all stages before the
+ * next one is looked at. only one of 'dlist' and 'slist' is set.
+ */
+struct pipeline
+{
+	const struct dlist_list *dlist;
+	const struct slist_list *slist;
+	size_t count;
+	struct pipeline_stage stages[PIPELINE_STAGES];
+};
+
+
+/****************************************************************************
+ * convinience data types for library consumers/users
+ ****************************************************************************/
+
+typedef struct pipeline pipeline_t;
+
+
+/****************************************************************************
+ * library interface and _base_ documentation
+ ****************************************************************************/
+
+/* returns 'pipe' initialized over 'list', with no stages
+ * returns NULL if 'pipe' or 'list' are NULL
+ *
+ * NOTE: 'list' is only read, and only when a terminal operation runs.
+ * ------- it must not change while the 'pipe' is in use.
+ *
+ * passing invalid ['pipe' or 'list']
+ * ------- results in undefined behavior
+ */
+struct pipeline *pipeline_over_dlist(struct pipeline *pipe,
+				     const struct dlist_list *list);
+
+
+/* same as pipeline_over_dlist, over a slist 'list'
+ */
+struct pipeline *pipeline_over_slist(struct pipeline *pipe,
+				     const struct slist_list *list);
+
+
+/* returns 'pipe' after recording a stage replacing each element
+ * ------- with what 'func' returns for it.
+ * returns NULL if 'pipe' or 'func' are NULL
+ * returns NULL if 'pipe' already holds PIPELINE_STAGES stages
+ *
+ * ABOUT ['dalloc']: deletes what 'func' returns once the next stage is
+ * ------- done with it. terminals that hand elements out, see
+ * ------- pipeline_collect_dlist and pipeline_first, leave it to the caller.
+ * ------- passing NULL leaves the values alone.
+ *
+ * passing invalid ['pipe' or 'func' or 'dalloc']
+ * ------- results in undefined behavior
+ */
+struct pipeline *pipeline_map(struct pipeline *pipe, pipeline_map_func func,
+			      void (*dalloc)(void *));
+
+
+/* returns 'pipe' after recording a stage dropping each element
+ * ------- failing the 'func' predicate.
+ * returns NULL if 'pipe' or 'func' are NULL
+ * returns NULL if 'pipe' already holds PIPELINE_STAGES stages
+ *
+ * passing invalid ['pipe' or 'func']
+ * ------- results in undefined behavior
+ */
+struct pipeline *pipeline_filter(struct pipeline *pipe,
+				 pipeline_filter_func func);
+
+
+/* folds every element out of 'pipe' from left to right using 'func',
+ * ------- starting with 'initial', in a single pass over the source list.
+ * returns the final accumulator value
+ * returns NULL if 'pipe' is NULL
+ * returns 'initial' if 'func' is NULL or no element comes out of 'pipe'
+ *
+ * NOTE: mapped elements are deleted as soon as 'func' returns, 'func'
+ * ------- must not keep them.
+ *
+ * passing invalid ['pipe' or 'func']
+ * ------- results in undefined behavior
+ */
+void *pipeline_fold(const struct pipeline *pipe, void *initial,
+		    pipeline_fold_func func);
+
+
+/* returns 'out' after appending every element out of 'pipe' to it,
+ * ------- in a single pass over the source list.
+ * returns NULL if 'pipe' or 'out' are NULL
+ * returns NULL if a node can't be allocated, elements collected until
+ * ------- then are kept in 'out'.
+ *
+ * ABOUT [nodes]: the only allocations made are the 'out' nodes. elements
+ * ------- are linked as they are, set 'out' data_dalloc if it owns them.
+ *
+ * passing invalid ['pipe' or 'out']
+ * ------- results in undefined behavior
+ */
+struct dlist_list *pipeline_collect_dlist(const struct pipeline *pipe,
+					  struct dlist_list *out);
+
+
+/* same as pipeline_collect_dlist, into a slist 'out'
+ */
+struct slist_list *pipeline_collect_slist(const struct pipeline *pipe,
+					  struct slist_list *out);
+
+
+/* returns how many elements come out of 'pipe'
+ * returns 0 if 'pipe' is NULL
+ *
+ * passing invalid ['pipe']
+ * ------- results in undefined behavior
+ */
+size_t pipeline_count(const struct pipeline *pipe);
+
+
+/* returns the first element out of 'pipe', the source list is not
+ * ------- walked any further.
+ * returns NULL if 'pipe' is NULL or no element comes out of it
+ *
+ * NOTE: if the element was mapped the caller deletes it, see pipeline_map
+ *
+ * passing invalid ['pipe']
+ * ------- results in undefined behavior
+ */
+void *pipeline_first(const struct pipeline *pipe);
+
+#endif
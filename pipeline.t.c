@@ -0,0 +1,233 @@
+/*
+ * pipeline.t.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "pipeline.h"
+#include <stdio.h>
+
+#include <assert.h>
+
+#define LOUD
+#include "common.h"
+
+// counts the mapped elements the pipeline deletes, and the filter calls
+static int dalloc_calls = 0;
+static int filter_calls = 0;
+
+void count_dalloc(void *data)
+{
+	++dalloc_calls;
+	free(data);
+}
+
+void *double_int(void *data)
+{
+	return int_copy(*(int*)data * 2);
+}
+
+void *same_int(void *data)
+{
+	return data;
+}
+
+bool is_even(void *data)
+{
+	++filter_calls;
+	return 0 == *(int*)data % 2;
+}
+
+bool over_ten(void *data)
+{
+	++filter_calls;
+	return *(int*)data > 10;
+}
+
+void *add_int(void *acc, void *data)
+{
+	*(int*)acc += *(int*)data;
+	return acc;
+}
+
+int main(int argc, char **argv)
+{
+	wmsg("testing pipeline lib interface\n");
+
+	{
+		wmsg("pipeline_over/map/filter");
+
+		struct pipeline pipe;
+		struct dlist_list d_list;
+		struct slist_list s_list;
+		dlist_init(&d_list, NULL, NULL);
+		slist_init(&s_list, NULL, NULL);
+		//test failures
+		assert( NULL == pipeline_over_dlist(NULL, &d_list) );
+		assert( NULL == pipeline_over_dlist(&pipe, NULL) );
+		assert( NULL == pipeline_over_slist(NULL, &s_list) );
+		assert( NULL == pipeline_over_slist(&pipe, NULL) );
+		assert( &pipe == pipeline_over_slist(&pipe, &s_list) );
+		assert( NULL == pipe.dlist && &s_list == pipe.slist );
+		assert( &pipe == pipeline_over_dlist(&pipe, &d_list) );
+		assert( &d_list == pipe.dlist && NULL == pipe.slist );
+		assert( 0 == pipe.count );
+		assert( NULL == pipeline_map(NULL, double_int, NULL) );
+		assert( NULL == pipeline_map(&pipe, NULL, NULL) );
+		assert( NULL == pipeline_filter(NULL, is_even) );
+		assert( NULL == pipeline_filter(&pipe, NULL) );
+		//stages are bounded
+		for(int i = 0; i < PIPELINE_STAGES; ++i)
+			assert( &pipe == pipeline_filter(&pipe, is_even) );
+		assert( NULL == pipeline_filter(&pipe, is_even) );
+		assert( NULL == pipeline_map(&pipe, same_int, NULL) );
+		assert( PIPELINE_STAGES == pipe.count );
+		//and start over
+		assert( &pipe == pipeline_over_dlist(&pipe, &d_list) );
+		assert( 0 == pipe.count );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("pipeline_fold/count/first");
+
+		struct pipeline pipe;
+		struct dlist_list *list;
+		int acc = 0;
+		int *first;
+		list = dlist_list_new(NULL, NULL);
+		dlist_data_dalloc(list, int_dalloc);
+		pipeline_over_dlist(&pipe, list);
+		//test failures
+		assert( NULL == pipeline_fold(NULL, &acc, add_int) );
+		assert( &acc == pipeline_fold(&pipe, &acc, NULL) );
+		assert( 0 == pipeline_count(NULL) );
+		assert( NULL == pipeline_first(NULL) );
+		//empty source
+		assert( &acc == pipeline_fold(&pipe, &acc, add_int) );
+		assert( 0 == pipeline_count(&pipe) );
+		assert( NULL == pipeline_first(&pipe) );
+		//no stages at all
+		for(int i = 1; i <= 20; ++i)
+			dlist_node_append(list, dlist_node_new(list, int_copy(i), NULL));
+		assert( 20 == pipeline_count(&pipe) );
+		pipeline_fold(&pipe, &acc, add_int);
+		assert( 210 == acc );
+		//evens doubled, those over ten, doubled again: 24 32 ... 80
+		pipeline_filter(&pipe, is_even);
+		pipeline_map(&pipe, double_int, count_dalloc);
+		pipeline_filter(&pipe, over_ten);
+		pipeline_map(&pipe, double_int, count_dalloc);
+		dalloc_calls = 0;
+		filter_calls = 0;
+		assert( 8 == pipeline_count(&pipe) );
+		//one walk, each filter sees each element reaching it once
+		assert( 30 == filter_calls );
+		//every mapped element is gone, the 2 rejected ones included
+		assert( 18 == dalloc_calls );
+		acc = 0;
+		dalloc_calls = 0;
+		assert( &acc == pipeline_fold(&pipe, &acc, add_int) );
+		assert( 416 == acc );
+		assert( 18 == dalloc_calls );
+		//first stops the walk and hands the element out
+		dalloc_calls = 0;
+		filter_calls = 0;
+		first = pipeline_first(&pipe);
+		assert( 24 == *first );
+		assert( 6 + 3 == filter_calls );
+		assert( 3 == dalloc_calls );
+		free(first);
+		//a map handing its input back deletes nothing
+		pipeline_over_dlist(&pipe, list);
+		pipeline_map(&pipe, same_int, count_dalloc);
+		pipeline_map(&pipe, same_int, NULL);
+		dalloc_calls = 0;
+		assert( 20 == pipeline_count(&pipe) );
+		assert( 0 == dalloc_calls );
+		dlist_list_delete_all_nodes(list);
+		dlist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("pipeline_collect_dlist/slist");
+
+		struct pipeline pipe;
+		struct slist_list *list;
+		struct dlist_list *d_out;
+		struct slist_list *s_out;
+		struct dlist_node *d_node;
+		struct slist_node *s_node;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		int expect = 24;
+		count_ctx_init(&allocator, &ctx);
+		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		d_out = dlist_list_new_allocator(&allocator);
+		dlist_data_dalloc(d_out, int_dalloc);
+		s_out = slist_list_new(NULL, NULL);
+		pipeline_over_slist(&pipe, list);
+		//test failures
+		assert( NULL == pipeline_collect_dlist(NULL, d_out) );
+		assert( NULL == pipeline_collect_dlist(&pipe, NULL) );
+		assert( NULL == pipeline_collect_slist(NULL, s_out) );
+		assert( NULL == pipeline_collect_slist(&pipe, NULL) );
+		//nothing to collect
+		assert( d_out == pipeline_collect_dlist(&pipe, d_out) );
+		assert( 0 == d_out->count );
+		for(int i = 1; i <= 20; ++i)
+			slist_node_append(list, slist_node_new(list, int_copy(i), NULL));
+		pipeline_filter(&pipe, is_even);
+		pipeline_map(&pipe, double_int, count_dalloc);
+		pipeline_filter(&pipe, over_ten);
+		pipeline_map(&pipe, double_int, count_dalloc);
+		//only the collected nodes are allocated, elements are handed over
+		dalloc_calls = 0;
+		assert( d_out == pipeline_collect_dlist(&pipe, d_out) );
+		assert( 8 == ctx.allocs );
+		assert( 10 == dalloc_calls );
+		assert( 8 == d_out->count );
+		for(d_node = d_out->head; d_node; d_node = d_node->next, expect += 8)
+			assert( expect == *(int*)d_node->data );
+		assert( 80 == *(int*)d_out->tail->data );
+		//no map stage, the source elements themselves are collected
+		pipeline_over_slist(&pipe, list);
+		pipeline_filter(&pipe, over_ten);
+		assert( s_out == pipeline_collect_slist(&pipe, s_out) );
+		assert( 10 == s_out->count );
+		s_node = s_out->head;
+		for(struct slist_node *iter = list->head; iter; iter = iter->next)
+			if ( *(int*)iter->data > 10 ) {
+				assert( iter->data == s_node->data );
+				s_node = s_node->next;
+			}
+		assert( NULL == s_node );
+		dlist_list_delete_all_nodes(d_out);
+		dlist_list_delete(d_out);
+		slist_list_delete_all_nodes(s_out);
+		slist_list_delete(s_out);
+		slist_list_delete_all_nodes(list);
+		slist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	return 0;
+}
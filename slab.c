@@ -0,0 +1,238 @@
+/*
+ * slab.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+//posix_memalign, page sized pages aligned to their size
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdint.h>
+
+#include "slab.h"
+
+/****************************************************************************
+ * internal helpers
+ ****************************************************************************/
+
+//offset of the first slot inside a page
+#define SLAB_PAGE_HEADER \
+	((sizeof( struct slab_page) + 15) & ~(size_t)15)
+
+
+static inline struct slab_page *slab_page_of(const struct slab *slab,
+					     const void *ptr)
+{
+	return (struct slab_page *)((uintptr_t)ptr &
+				    ~(uintptr_t)(slab->page_size - 1));
+}/* slab_page_of */
+
+
+static int slab_grow(struct slab *slab)
+{
+	void *page_mem = NULL;
+	struct slab_page *page = NULL;
+	char *base = NULL;
+
+	if ( posix_memalign(&page_mem, slab->page_size, slab->page_size) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return 0;
+	}
+
+	page = page_mem;
+	page->used = 0;
+	page->next = slab->pages;
+	slab->pages = page;
+	++slab->page_count;
+
+	//carve backwards so slots are handed out in address order
+	base = (char *)page + SLAB_PAGE_HEADER;
+	for(size_t idx = slab->slots_per_page; idx; --idx)
+	{
+		void *slot = base + (idx - 1) * slab->slot_size;
+		*(void **)slot = slab->free_slots;
+		slab->free_slots = slot;
+	}
+
+	return 1;
+}/* slab_grow */
+
+
+static void *slab_vt_alloc(void *ctx, size_t size)
+{
+	struct slab *slab = ctx;
+
+	if ( size > slab->slot_size )
+		return NULL;
+
+	return slab_alloc(slab);
+}/* slab_vt_alloc */
+
+
+static void slab_vt_dalloc(void *ctx, void *ptr)
+{
+	slab_dalloc(ctx, ptr);
+}/* slab_vt_dalloc */
+
+
+static size_t slab_vt_bulk_alloc(void *ctx, size_t size, void **ptrs, size_t n)
+{
+	struct slab *slab = ctx;
+	size_t idx;
+
+	if ( size > slab->slot_size )
+		return 0;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+		if ( NULL == (ptrs[idx] = slab_alloc(slab)) )
+			break;
+	}
+
+	return idx;
+}/* slab_vt_bulk_alloc */
+
+
+static void slab_vt_bulk_dalloc(void *ctx, void **ptrs, size_t n)
+{
+	for(size_t idx = 0; idx < n; ++idx)
+		slab_dalloc(ctx, ptrs[idx]);
+}/* slab_vt_bulk_dalloc */
+
+
+/****************************************************************************
+ * slab library interface implementation
+ ****************************************************************************/
+
+struct slab *slab_init(struct slab *slab, size_t slot_size, size_t page_size)
+{
+	if ( !slab || !slot_size )
+		return NULL;
+
+	page_size = (page_size ? page_size : SLAB_DEF_PAGE_SIZE);
+	//slots double as free list links, so they hold at least a pointer
+	slot_size = (slot_size + sizeof( void *) - 1) & ~(sizeof( void *) - 1);
+
+	if ( page_size & (page_size - 1) )
+		return NULL;
+
+	if ( page_size < SLAB_PAGE_HEADER + slot_size )
+		return NULL;
+
+	slab->slot_size = slot_size;
+	slab->page_size = page_size;
+	slab->slots_per_page = (page_size - SLAB_PAGE_HEADER) / slot_size;
+	slab->page_count = 0;
+	slab->free_slots = NULL;
+	slab->pages = NULL;
+
+	slab->allocator.ctx = slab;
+	slab->allocator.alloc = slab_vt_alloc;
+	slab->allocator.dalloc = slab_vt_dalloc;
+	slab->allocator.bulk_alloc = slab_vt_bulk_alloc;
+	slab->allocator.bulk_dalloc = slab_vt_bulk_dalloc;
+	//a slab may serve several lists, so it can't be reset on their behalf
+	slab->allocator.reset = NULL;
+
+	return slab;
+}/* slab_init */
+
+
+void *slab_alloc(struct slab *slab)
+{
+	if ( !slab )
+		return NULL;
+
+	void *slot = NULL;
+
+	if ( !slab->free_slots && !slab_grow(slab) )
+		return NULL;
+
+	slot = slab->free_slots;
+	slab->free_slots = *(void **)slot;
+	++slab_page_of(slab, slot)->used;
+
+	return slot;
+}/* slab_alloc */
+
+
+void slab_dalloc(struct slab *slab, void *ptr)
+{
+	if ( !slab || !ptr )
+		return;
+
+	--slab_page_of(slab, ptr)->used;
+	*(void **)ptr = slab->free_slots;
+	slab->free_slots = ptr;
+}/* slab_dalloc */
+
+
+size_t slab_trim(struct slab *slab)
+{
+	if ( !slab )
+		return 0;
+
+	void **link = &slab->free_slots;
+	struct slab_page **page = &slab->pages;
+	struct slab_page *empty = NULL;
+	size_t released = 0;
+
+	//drop free slots living in empty pages
+	while ( *link )
+	{
+		if ( 0 == slab_page_of(slab, *link)->used )
+			*link = *(void **)*link;
+		else
+			link = (void **)*link;
+	}
+
+	while ( *page )
+	{
+		if ( (*page)->used ) {
+			page = &(*page)->next;
+			continue;
+		}
+
+		empty = *page;
+		*page = empty->next;
+		free(empty);
+		++released;
+	}
+
+	slab->page_count -= released;
+	return released;
+}/* slab_trim */
+
+
+void slab_release(struct slab *slab)
+{
+	if ( !slab )
+		return;
+
+	struct slab_page *page = NULL;
+
+	while ( NULL != (page = slab->pages) )
+	{
+		slab->pages = page->next;
+		free(page);
+	}
+
+	slab->page_count = 0;
+	slab->free_slots = NULL;
+}/* slab_release */
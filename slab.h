@@ -0,0 +1,136 @@
+/*
+ * slab.h
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#ifndef DUTILS_SLAB_H_
+#define DUTILS_SLAB_H_
+
+/****************************************************************************
+ * standard libraries
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+
+//must be a power of two, pages are aligned to their own size
+#define SLAB_DEF_PAGE_SIZE 4096
+
+
+/****************************************************************************
+ * base data structures
+ ****************************************************************************/
+
+//lives at the start of every page, slots follow it
+struct slab_page
+{
+	struct slab_page *next;
+	size_t used;
+};
+
+struct slab
+{
+	size_t slot_size;
+	size_t page_size;
+	size_t slots_per_page;
+	size_t page_count;
+	void *free_slots;
+	struct slab_page *pages;
+	struct dutils_allocator allocator;
+};
+
+
+/****************************************************************************
+ * convinience data types for library consumers/users
+ ****************************************************************************/
+
+typedef struct slab slab_t;
+
+
+/****************************************************************************
+ * library interface and _base_ documentation
+ ****************************************************************************/
+
+/* returns 'slab' initialized to hand out 'slot_size' bytes slots
+ * ------- carved out of 'page_size' bytes pages.
+ * returns NULL if 'slab' is NULL
+ * returns NULL if 'slot_size' is 0
+ * returns NULL if 'page_size' is not a power of two
+ * returns NULL if 'page_size' can't hold a single slot
+ * passing 0 to 'page_size' sets it to SLAB_DEF_PAGE_SIZE
+ *
+ * ABOUT ['slot_size']: rounded up to a multiple of a pointer size. node
+ * ------- sizes such as sizeof(struct dlist_node) are used as they are,
+ * ------- so every node takes exactly its own size.
+ * ABOUT ['allocator']: ready to be used with dlist_init_allocator and
+ * ------- friends. requests bigger then 'slot_size' fail with NULL.
+ *
+ * NOTE: no memory is taken until the first slot is requested.
+ *
+ * passing invalid ['slab']
+ * ------- results in undefined behavior
+ */
+struct slab *slab_init(struct slab *slab, size_t slot_size, size_t page_size);
+
+
+/* returns a free slot of 'slab' slot_size bytes
+ * returns NULL if 'slab' is NULL
+ * returns NULL if a new page is required and can't be allocated
+ *
+ * passing invalid ['slab']
+ * ------- results in undefined behavior
+ */
+void *slab_alloc(struct slab *slab);
+
+
+/* gives 'ptr' slot back to 'slab'
+ * passing NULL in 'slab' returns with no operation executed
+ * passing NULL in 'ptr' returns with no operation executed
+ *
+ * passing a 'ptr' not returned by slab_alloc on the same 'slab'
+ * ------- results in undefined behavior
+ */
+void slab_dalloc(struct slab *slab, void *ptr);
+
+
+/* returns the number of pages released by freeing every page of 'slab'
+ * ------- with no slot in use.
+ * returns 0 if 'slab' is NULL
+ *
+ * NOTE: this walks every free slot, it is meant to be called once in a
+ * ------- while, e.g after a burst of node deletion.
+ *
+ * passing invalid ['slab']
+ * ------- results in undefined behavior
+ */
+size_t slab_trim(struct slab *slab);
+
+
+/* frees every page of 'slab', leaving it as slab_init left it
+ * passing NULL in 'slab' returns with no operation executed
+ *
+ * NOTE: slots still in use become invalid. empty or delete the lists
+ * ------- using 'slab' first.
+ *
+ * passing invalid ['slab']
+ * ------- results in undefined behavior
+ */
+void slab_release(struct slab *slab);
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * slab.t.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "slab.h"
+#include "dlist.h"
+#include "slist.h"
+#include <stdio.h>
+
+#include <assert.h>
+
+#define LOUD
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+	wmsg("testing slab lib interface\n");
+
+	{
+		wmsg("slab_init");
+
+		struct slab slab;
+		//test failures
+		assert( NULL == slab_init(NULL, 32, 0) );
+		assert( NULL == slab_init(&slab, 0, 0) );
+		assert( NULL == slab_init(&slab, 32, 1000) );
+		assert( NULL == slab_init(&slab, 4096, 4096) );
+		//test defaults
+		assert( slab_init(&slab, sizeof( struct dlist_node), 0) );
+		assert( SLAB_DEF_PAGE_SIZE == slab.page_size );
+		assert( sizeof( struct dlist_node) == slab.slot_size );
+		assert( 0 == slab.page_count );
+		assert( NULL == slab.pages );
+		assert( &slab == slab.allocator.ctx );
+		//slot sizes are rounded to hold a pointer
+		assert( slab_init(&slab, 1, 0) );
+		assert( sizeof( void *) == slab.slot_size );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slab_alloc");
+
+		struct slab slab;
+		char *a;
+		char *b;
+		slab_init(&slab, sizeof( struct slist_node), 0);
+		assert( NULL == slab_alloc(NULL) );
+		assert( (a = slab_alloc(&slab)) );
+		assert( (b = slab_alloc(&slab)) );
+		//slots are packed, no per slot header
+		assert( b == a + sizeof( struct slist_node) );
+		assert( 1 == slab.page_count );
+		assert( 2 == slab.pages->used );
+		//fill the page to force a new one
+		for(size_t idx = 2; idx <= slab.slots_per_page; ++idx)
+			assert( slab_alloc(&slab) );
+		assert( 2 == slab.page_count );
+		slab_release(&slab);
+		assert( 0 == slab.page_count );
+		assert( NULL == slab.free_slots );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slab_dalloc");
+
+		struct slab slab;
+		void *a;
+		slab_init(&slab, sizeof( struct dlist_node), 0);
+		//test failures
+		slab_dalloc(NULL, NULL);
+		slab_dalloc(&slab, NULL);
+		a = slab_alloc(&slab);
+		slab_dalloc(&slab, a);
+		assert( 0 == slab.pages->used );
+		//last freed is first reused
+		assert( a == slab_alloc(&slab) );
+		slab_release(&slab);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slab_trim");
+
+		struct slab slab;
+		void *slots[1000];
+		slab_init(&slab, sizeof( struct dlist_node), 0);
+		assert( 0 == slab_trim(NULL) );
+		assert( 0 == slab_trim(&slab) );
+		for(int i = 0; i < 1000; ++i)
+			slots[i] = slab_alloc(&slab);
+		assert( 1 < slab.page_count );
+		//keep only the first slot alive
+		for(int i = 1; i < 1000; ++i)
+			slab_dalloc(&slab, slots[i]);
+		assert( slab.page_count - 1 == slab_trim(&slab) );
+		assert( 1 == slab.page_count );
+		//the surviving page still hands out slots
+		assert( slab_alloc(&slab) );
+		slab_dalloc(&slab, slots[0]);
+		slab_release(&slab);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slab as dlist allocator");
+
+		struct slab slab;
+		struct dlist_list list;
+		struct dlist_node *node;
+		slab_init(&slab, sizeof( struct dlist_node), 0);
+		dlist_init_allocator(&list, &slab.allocator);
+		dlist_data_dalloc(&list, int_dalloc);
+		for(int i = 0; i < 1000; ++i)
+		{
+			node = dlist_node_new(&list, int_copy(i), int_dalloc);
+			dlist_node_append(&list, node);
+		}
+		assert( 1000 == list.count );
+		assert( 999 == *(int*)list.tail->data );
+		//anything bigger then a node is refused
+		assert( NULL == slab.allocator.alloc(slab.allocator.ctx, 64) );
+		dlist_list_delete_all_nodes(&list);
+		assert( slab.page_count == slab_trim(&slab) );
+		slab_release(&slab);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slab as slist allocator");
+
+		struct slab slab;
+		struct slist_list list;
+		struct slist_node *node;
+		slab_init(&slab, sizeof( struct slist_node), 0);
+		slist_init_allocator(&list, &slab.allocator);
+		slist_data_dalloc(&list, int_dalloc);
+		for(int i = 0; i < 1000; ++i)
+		{
+			node = slist_node_new(&list, int_copy(i), int_dalloc);
+			slist_node_push(&list, node);
+		}
+		assert( 1000 == list.count );
+		assert( 999 == *(int*)list.head->data );
+		slist_list_delete_all_nodes(&list);
+		slab_release(&slab);
+
+		wmsg("[OK]\n");
+	}
+
+	return 0;
+}
@@ -17,8 +17,441 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/
  */
 
+#include <string.h>
+
 #include "slist.h"
 
+/****************************************************************************
+ * internal helpers
+ ****************************************************************************/
+
+//how many nodes are handed to 'bulk_dalloc' at once
+#define SLIST_BULK_BATCH 32
+
+//inputs slist_list_merge_k keeps on the stack before allocating its heap
+#define SLIST_MERGE_K_STACK 32
+
+#ifdef SLIST_STATS
+static inline void slist_stats_alloc(struct slist_list *list, size_t size)
+{
+	++list->stats.allocs;
+	list->stats.bytes += size;
+
+	if ( ++list->stats.live > list->stats.peak )
+		list->stats.peak = list->stats.live;
+}/* slist_stats_alloc */
+
+static inline void slist_stats_dalloc(struct slist_list *list, size_t n)
+{
+	list->stats.dallocs += n;
+	list->stats.live = (list->stats.live > n ? list->stats.live - n : 0);
+}/* slist_stats_dalloc */
+
+//'n' nodes changed hands from 'list' to 'n_list'
+static inline void slist_stats_move(struct slist_list *list,
+				    struct slist_list *n_list, size_t n)
+{
+	list->stats.live = (list->stats.live > n ? list->stats.live - n : 0);
+	n_list->stats.live += n;
+
+	if ( n_list->stats.live > n_list->stats.peak )
+		n_list->stats.peak = n_list->stats.live;
+}/* slist_stats_move */
+
+#define slist_stats_data(list) (++(list)->stats.data_dallocs)
+#else
+#define slist_stats_alloc(list, size) ((void)0)
+#define slist_stats_dalloc(list, n) ((void)0)
+#define slist_stats_move(list, n_list, n) ((void)0)
+#define slist_stats_data(list) ((void)0)
+#endif
+
+static inline void *slist_alloc(struct slist_list *list, size_t size)
+{
+	void *ptr = NULL;
+
+	if ( list->allocator )
+		ptr = list->allocator->alloc(list->allocator->ctx, size);
+	else
+		ptr = list->node_alloc(size);
+
+	if ( ptr )
+		slist_stats_alloc(list, size);
+
+	return ptr;
+}/* slist_alloc */
+
+static inline void slist_dalloc(struct slist_list *list, void *ptr)
+{
+	if ( list->allocator )
+		list->allocator->dalloc(list->allocator->ctx, ptr);
+	else
+		list->node_dalloc(ptr);
+
+	slist_stats_dalloc(list, 1);
+}/* slist_dalloc */
+
+static inline void slist_cursor_set(struct slist_list *list,
+				    struct slist_node *node, size_t index)
+{
+	list->cursor.node = node;
+	list->cursor.index = index;
+}/* slist_cursor_set */
+
+//'node' at 'rank' is about to be unlinked, 'prev' being the one before it
+static inline void slist_cursor_remove(struct slist_list *list,
+				       const struct slist_node *node,
+				       struct slist_node *prev, size_t rank)
+{
+	if ( !list->cursor.node )
+		return;
+
+	if ( node == list->cursor.node )
+		slist_cursor_set(list, prev, rank - 1);
+	else if ( rank < list->cursor.index )
+		--list->cursor.index;
+}/* slist_cursor_remove */
+
+//hands the cursor to 'n_list' when it lies at 'index' or past it
+static inline void slist_cursor_cut(struct slist_list *list,
+				    struct slist_list *n_list, size_t index)
+{
+	if ( !list->cursor.node || list->cursor.index < index )
+		return;
+
+	slist_cursor_set(n_list, list->cursor.node, list->cursor.index - index + 1);
+	list->cursor.node = NULL;
+}/* slist_cursor_cut */
+
+//returns the node at 'index', from the cursor when it is not past it
+static struct slist_node *slist_node_walk(struct slist_list *list,
+					  size_t index)
+{
+	struct slist_node *node = list->head;
+	size_t idx = 1;
+
+	if ( list->count == index )
+		return list->tail;
+
+	if ( list->cursor.node && list->cursor.index <= index ) {
+		node = list->cursor.node;
+		idx = list->cursor.index;
+	}
+
+	for( ; idx < index; ++idx)
+		node = node->next;
+
+	return node;
+}/* slist_node_walk */
+
+/* returns the first node for which 'cmp' is at least 'past', 1 for the
+ * upper bound and 0 for the lower one, NULL when there is none. 'prev'
+ * gets the node before it and 'index' its position. starts from the
+ * cursor when it is still short of the bound.
+ */
+static struct slist_node *slist_node_bound(struct slist_list *list, void *key,
+					   slist_cmp3_func cmp, int past,
+					   struct slist_node **prev,
+					   size_t *index)
+{
+	struct slist_node *iter = list->head;
+	size_t idx = 1;
+
+	*prev = NULL;
+	if ( list->cursor.node && cmp(list->cursor.node->data, key) < past ) {
+		*prev = list->cursor.node;
+		iter = list->cursor.node->next;
+		idx = list->cursor.index + 1;
+	}
+
+	for( ; iter && cmp(iter->data, key) < past; ++idx)
+	{
+		*prev = iter;
+		iter = iter->next;
+	}
+
+	*index = idx;
+	return iter;
+}/* slist_node_bound */
+
+//same as slist_node_bound, from the public side, leaving the cursor on it
+static struct slist_node *slist_node_bound_at(struct slist_list *list,
+					      void *key, slist_cmp3_func cmp,
+					      int past)
+{
+	struct slist_node *prev = NULL;
+	struct slist_node *node = NULL;
+	size_t idx;
+
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	if ( cmp(list->tail->data, key) < past )
+		return NULL;
+
+	node = slist_node_bound(list, key, cmp, past, &prev, &idx);
+	slist_cursor_set(list, node, idx);
+
+	return node;
+}/* slist_node_bound_at */
+
+//merges the sorted 'next' chains 'a' and 'b', ties going to 'a'
+static struct slist_node *slist_sort_merge(struct slist_node *a,
+					   struct slist_node *b,
+					   slist_cmp3_func cmp)
+{
+	struct slist_node *head = NULL;
+	struct slist_node **link = &head;
+
+	while ( a && b )
+	{
+		if ( cmp(a->data, b->data) <= 0 ) {
+			*link = a;
+			a = a->next;
+		} else {
+			*link = b;
+			b = b->next;
+		}
+
+		link = &(*link)->next;
+	}
+
+	*link = (a ? a : b);
+	return head;
+}/* slist_sort_merge */
+
+
+/* bottom-up merge sort of the 'next' chain from 'head', returns the new head.
+ * 'runs[i]' holds a sorted run of 2^i nodes, or none, like the bits of a
+ * counter: each node carries into it and equal sized runs merge while
+ * they are still in cache. earlier nodes always sit in the higher runs.
+ */
+static struct slist_node *slist_sort_chain(struct slist_node *head,
+					   slist_cmp3_func cmp)
+{
+	struct slist_node *runs[sizeof( size_t) * 8] = { NULL };
+	struct slist_node *carry = NULL;
+	size_t top = 0;
+	size_t i;
+
+	while ( head )
+	{
+		carry = head;
+		head = head->next;
+		carry->next = NULL;
+
+		for(i = 0; runs[i]; ++i)
+		{
+			carry = slist_sort_merge(runs[i], carry, cmp);
+			runs[i] = NULL;
+		}
+
+		runs[i] = carry;
+		if ( i >= top )
+			top = i + 1;
+	}
+
+	for(i = 0, carry = NULL; i < top; ++i)
+	{
+		if ( runs[i] )
+			carry = slist_sort_merge(runs[i], carry, cmp);
+	}
+
+	return carry;
+}/* slist_sort_chain */
+
+/* LSD radix sort of 'list' nodes by the low 'width' bytes of 'key',
+ * relinking 'next' only. sets 'head' and 'tail' when anything moves.
+ */
+static void slist_radix_chain(struct slist_list *list, slist_key_func key,
+			      size_t width)
+{
+	struct slist_node *heads[256];
+	struct slist_node *tails[256];
+	struct slist_node *node = NULL;
+	struct slist_node *next = NULL;
+	struct slist_node *prev = NULL;
+	uint64_t first = key(list->head->data);
+	uint64_t varying = 0;
+	uint64_t k;
+	unsigned int b;
+
+	for(unsigned int shift = 0; shift < width * 8; shift += 8)
+	{
+		//bytes every key shares would only copy the order over,
+		//the first pass finds them out
+		if ( shift && !((varying >> shift) & 0xff) )
+			continue;
+
+		for(b = 0; b < 256; ++b)
+			heads[b] = NULL;
+
+		//appending to the buckets keeps every pass stable
+		for(node = list->head; NULL != node; node = next)
+		{
+			next = node->next;
+			k = key(node->data);
+			if ( !shift )
+				varying |= k ^ first;
+
+			b = (k >> shift) & 0xff;
+			if ( heads[b] )
+				tails[b]->next = node;
+			else
+				heads[b] = node;
+
+			tails[b] = node;
+		}
+
+		for(b = 0, prev = NULL; b < 256; ++b)
+		{
+			if ( !heads[b] )
+				continue;
+
+			if ( prev )
+				prev->next = heads[b];
+			else
+				list->head = heads[b];
+
+			prev = tails[b];
+		}
+
+		prev->next = NULL;
+		list->tail = prev;
+	}
+}/* slist_radix_chain */
+
+//a sorted input of slist_list_merge_k, 'order' breaks ties
+struct slist_merge_src
+{
+	struct slist_node *node;
+	struct slist_node *tail;
+	size_t order;
+};
+
+static inline int slist_merge_before(const struct slist_merge_src *a,
+				     const struct slist_merge_src *b,
+				     slist_cmp3_func cmp)
+{
+	int c = cmp(a->node->data, b->node->data);
+
+	return c < 0 || (0 == c && a->order < b->order);
+}/* slist_merge_before */
+
+//moves 'heap[i]' down to its place in the min heap of 'n' inputs
+static void slist_merge_sift(struct slist_merge_src *heap, size_t n, size_t i,
+			     slist_cmp3_func cmp)
+{
+	struct slist_merge_src top = heap[i];
+	size_t child;
+
+	while ( (child = 2 * i + 1) < n )
+	{
+		if ( child + 1 < n &&
+		     slist_merge_before(&heap[child + 1], &heap[child], cmp) )
+			++child;
+
+		if ( !slist_merge_before(&heap[child], &top, cmp) )
+			break;
+
+		heap[i] = heap[child];
+		i = child;
+	}
+
+	heap[i] = top;
+}/* slist_merge_sift */
+
+#ifndef SLIST_COMPACT_NODE
+//marks inline nodes, never called: their 'data' goes with the node
+static void slist_inline_dalloc(void *data)
+{
+}/* slist_inline_dalloc */
+#endif
+
+static inline int slist_node_is_inline(const struct slist_node *node)
+{
+#ifdef SLIST_COMPACT_NODE
+	//no room for the mark, slist_node_new_inline makes none
+	return 0;
+#else
+	return ( slist_inline_dalloc == node->data_dalloc );
+#endif
+}/* slist_node_is_inline */
+
+//deletes 'node' 'data' with its own dalloc, or else the 'list' one
+static inline void slist_node_data_dalloc(struct slist_list *list,
+					  struct slist_node *node)
+{
+	if ( !node->data || slist_node_is_inline(node) )
+		return;
+
+#ifndef SLIST_COMPACT_NODE
+	if ( node->data_dalloc ) {
+		slist_stats_data(list);
+		node->data_dalloc( node->data );
+		return;
+	}
+#endif
+
+	if ( list->data_dalloc ) {
+		slist_stats_data(list);
+		list->data_dalloc( node->data );
+	}
+}/* slist_node_data_dalloc */
+
+//gives a node, whose 'data' is already taken care of, back
+static inline void slist_node_release(struct slist_list *list,
+				      struct slist_node *node)
+{
+	if ( list->cache_count < list->cache_max && !slist_node_is_inline(node) ) {
+		node->next = list->cache;
+		list->cache = node;
+		++list->cache_count;
+		return;
+	}
+
+	slist_dalloc(list, node);
+}/* slist_node_release */
+
+static struct slist_list *slist_setup(struct slist_list *list,
+				      void *(*node_alloc)(size_t),
+				      void (*node_dalloc)(void *),
+				      const struct dutils_allocator *allocator)
+{
+	list->count = 0;
+	list->head = NULL;
+	list->tail = NULL;
+	list->allocator = allocator;
+	list->data_dalloc = NULL;
+	list->cache = NULL;
+	list->cache_count = 0;
+	list->cache_max = 0;
+	list->cursor.node = NULL;
+	list->cursor.index = 0;
+#ifdef SLIST_STATS
+	memset(&list->stats, 0, sizeof( struct slist_stats));
+#endif
+
+	if ( allocator ) {
+		list->node_alloc = NULL;
+		list->node_dalloc = NULL;
+	} else {
+		list->node_alloc = (node_alloc ? node_alloc : SLIST_DEF_ALLOC);
+		list->node_dalloc = (node_dalloc ? node_dalloc : SLIST_DEF_DALLOC);
+	}
+
+	return list;
+}/* slist_setup */
+
+//returns a new empty list allocating nodes the same way 'list' does
+static struct slist_list *slist_list_new_from(const struct slist_list *list)
+{
+	if ( list->allocator )
+		return slist_list_new_allocator(list->allocator);
+
+	return slist_list_new(list->node_alloc, list->node_dalloc);
+}/* slist_list_new_from */
+
 /****************************************************************************
  * library interface implementation
  ****************************************************************************/
@@ -27,12 +460,10 @@ struct slist_list *slist_init(struct slist_list *list,
 			      void *(*node_alloc)(size_t),
 			      void (*node_dalloc)(void *))
 {
-	list->count = 0;
-	list->node_alloc = (node_alloc ? node_alloc : SLIST_DEF_ALLOC);
-	list->node_dalloc = (node_dalloc ? node_dalloc : SLIST_DEF_DALLOC);
+	if ( !list )
+		return NULL;
 
-	list->head = NULL;
-	return list;
+	return slist_setup(list, node_alloc, node_dalloc, NULL);
 }/* slist_init */
 
 struct slist_list *slist_list_new(void *(*node_alloc)(size_t),
@@ -51,21 +482,57 @@ struct slist_list *slist_list_new(void *(*node_alloc)(size_t),
 		return NULL;
 	}
 
-	list->node_alloc = node_alloc;
-	list->node_dalloc = node_dalloc;
-	list->count = 0;
-	list->head = NULL;
+	return slist_setup(list, node_alloc, node_dalloc, NULL);
+}/* slist_list_new */
+
+struct slist_list *slist_init_allocator(struct slist_list *list,
+					const struct dutils_allocator *allocator)
+{
+	if ( !list )
+		return NULL;
+
+	return slist_setup(list, NULL, NULL, allocator);
+}/* slist_init_allocator */
+
+struct slist_list *slist_list_new_allocator(const struct dutils_allocator *allocator)
+{
+	if ( !allocator )
+		return slist_list_new(NULL, NULL);
+
+	struct slist_list *list = NULL;
+
+	if ( NULL == (list = SLIST_DEF_ALLOC( sizeof( struct slist_list))) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	return slist_setup(list, NULL, NULL, allocator);
+}/* slist_list_new_allocator */
+
+struct slist_list *slist_data_dalloc(struct slist_list *list,
+				     void (*data_dalloc)(void *))
+{
+	if ( !list )
+		return NULL;
+
+	list->data_dalloc = data_dalloc;
 
 	return list;
-}/* slist_list_new */
+}/* slist_data_dalloc */
 
 struct slist_node *slist_node_new(struct slist_list *list,
 				  void *data, void (*dalloc)(void *))
 {
 
-	struct slist_node *node = NULL;
+	struct slist_node *node = list->cache;
 
-	if ( NULL == (node = list->node_alloc( sizeof( struct slist_node))) ) {
+	if ( node ) {
+		list->cache = node->next;
+		--list->cache_count;
+	} else if ( NULL == (node = slist_alloc(list, sizeof( struct slist_node))) ) {
 		//FIXME: add support for custom error loggin and msg
 		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
 			__LINE__,__func__);
@@ -74,7 +541,9 @@ struct slist_node *slist_node_new(struct slist_list *list,
 	}
 
 	node->data = data;
+#ifndef SLIST_COMPACT_NODE
 	node->data_dalloc = dalloc;
+#endif
 	node->next = NULL;
 
 	return node;
@@ -96,10 +565,9 @@ void slist_node_delete(struct slist_list *list,
 
 	//FIXME: add debug warning for existing 'node->data
 	//------ without _node_dalloc
-	if ( node->data && node->data_dalloc )
-		node->data_dalloc( node->data );
+	slist_node_data_dalloc(list, node);
 
-	list->node_dalloc(node);
+	slist_node_release(list, node);
 	node = NULL;
 }/* slist_node_delete */
 
@@ -108,6 +576,14 @@ void slist_list_delete(struct slist_list *list)
 	if (!list)
 		return;
 
+	slist_cache_trim(list, 0);
+
+	//lists using an allocator always come from SLIST_DEF_ALLOC
+	if ( list->allocator ) {
+		SLIST_DEF_DALLOC(list);
+		return;
+	}
+
 	void (*node_dalloc)(void *) = list->node_dalloc;
 	node_dalloc(list);
 }/* slist_list_delete */
@@ -120,7 +596,12 @@ struct slist_node *slist_node_push(struct slist_list *list,
 
 	node->next = list->head;
 	list->head = node;
+
+	if ( !list->tail )
+		list->tail = node;
+
 	++list->count;
+	++list->cursor.index;
 
 	return node;
 }/* slist_node_push */
@@ -131,23 +612,18 @@ struct slist_node *slist_node_append(struct slist_list *list,
 	if ( !list || !node )
 		return NULL;
 
-	struct slist_node *pnode = NULL;
+	//ensure a node is a working tail
+	node->next = NULL;
+
 	//check add @ head
-	if ( !list->head ) {
+	if ( !list->tail )
 		list->head = node;
-		++list->count;
-		return node;
-	}
+	else
+		list->tail->next = node;
 
-	pnode = list->head;
-	while( NULL != pnode->next )
-		pnode = pnode->next;
-
-	pnode->next = node;
-	//ensure a node is a working tail
-	node->next = NULL;
+	list->tail = node;
 	++list->count;
-	return pnode;
+	return node;
 }/* slist_node_append */
 
 struct slist_node *slist_node_pop(struct slist_list *list)
@@ -157,8 +633,13 @@ struct slist_node *slist_node_pop(struct slist_list *list)
 
 	struct slist_node *node = list->head;
 
+	slist_cursor_remove(list, node, NULL, 1);
 	list->head = list->head->next;
 	--list->count;
+
+	if ( !list->head )
+		list->tail = NULL;
+
 	return node;
 }/* slist_node_pop */
 
@@ -213,15 +694,14 @@ struct slist_node *slist_node_remove(struct slist_list *list, void *key,
 	struct slist_node *iter;
 	struct slist_node *pnode;
 
+	//rank of iter->next, kept for the cursor
+	size_t idx = 2;
+
 	//check found @ head
-	if ( 0 == cmp(list->head->data, key) ) {
-		pnode = list->head;
-		list->head = list->head->next;
-		--list->count;
-		return pnode;
-	}
+	if ( 0 == cmp(list->head->data, key) )
+		return slist_node_pop(list);
 
-	for(iter = list->head; NULL != iter->next; iter = iter->next)
+	for(iter = list->head; NULL != iter->next; iter = iter->next, ++idx)
 	{
 		if ( 0 == cmp(iter->next->data, key) )
 			break;
@@ -231,9 +711,14 @@ struct slist_node *slist_node_remove(struct slist_list *list, void *key,
 	if ( !iter->next )
 		return NULL;
 
+	slist_cursor_remove(list, iter->next, iter, idx);
 	pnode = iter->next;
 	iter->next = pnode->next;
 	--list->count;
+
+	if ( list->tail == pnode )
+		list->tail = iter;
+
 	return pnode;
 
 }/* slist_node_remove */
@@ -244,26 +729,40 @@ struct slist_node *slist_node_remove_at(struct slist_list *list,
 	if ( !list || !list->head || index == 0 || index > list->count )
 		return NULL;
 
-	struct slist_node *head = list->head;
+	struct slist_node *head = NULL;
 	struct slist_node *prev = NULL;
 
-	size_t idx = 1;
-
 	if ( 1 == index )
 		return slist_node_pop(list);
 
-	do{
-		prev = head;
-		head = head->next;
-	}while( index > ++idx );
+	prev = slist_node_walk(list, index - 1);
+	head = prev->next;
 
 	prev->next = head->next;
 	--list->count;
 
+	if ( list->tail == head )
+		list->tail = prev;
+
+	//whatever it pointed at, the node before is a good next start
+	slist_cursor_set(list, prev, index - 1);
+
 	return head;
 
 }/* slist_node_remove_at */
 
+struct slist_node *slist_node_get_at(struct slist_list *list,
+				     const size_t index)
+{
+	if ( !list || !list->head || 0 == index || index > list->count )
+		return NULL;
+
+	struct slist_node *node = slist_node_walk(list, index);
+
+	slist_cursor_set(list, node, index);
+	return node;
+}/* slist_node_get_at */
+
 void slist_node_foreach(struct slist_list *list,
 			void *(*action)(void *carry, void *data, void *param),
 			void *param)
@@ -281,20 +780,112 @@ void slist_node_foreach(struct slist_list *list,
 
 }/* slist_node_foreach */
 
-struct slist_list *slist_list_delete_all_nodes(struct slist_list *list)
+void slist_node_foreach_batch(struct slist_list *list,
+			      slist_batch_action_func action, void *param)
 {
-	if ( !list || !list->head )
-		return NULL;
+	if ( !list || !list->head || !action )
+		return;
+
+	struct slist_node *iter = list->head;
+	void *data[SLIST_BATCH_SIZE];
+	void *carry = NULL;
+	size_t n;
+
+	while ( iter ) {
+		for(n = 0; iter && n < SLIST_BATCH_SIZE; iter = iter->next)
+			data[n++] = iter->data;
+
+		carry = action(carry, data, n, param);
+	}
+}/* slist_node_foreach_batch */
+
+//empties 'list' through its cache and bulk_dalloc, 'data' left alone if owned
+static void slist_nodes_drop(struct slist_list *list, int data_owned)
+{
+	list->cursor.node = NULL;
+
+	if ( !list->allocator || !list->allocator->bulk_dalloc ) {
+		while( NULL != list->head )
+		{
+			struct slist_node *node = slist_node_pop(list);
+			if ( !data_owned )
+				slist_node_data_dalloc(list, node);
+
+			slist_node_release(list, node);
+		}
+
+		return;
+	}
+
+	void *batch[SLIST_BULK_BATCH];
+	size_t n = 0;
+	struct slist_node *node = NULL;
 
 	while( NULL != list->head )
 	{
-		slist_node_delete(list, slist_node_pop(list));
+		node = slist_node_pop(list);
+		if ( !data_owned )
+			slist_node_data_dalloc(list, node);
+
+		//fill the cache first
+		if ( list->cache_count < list->cache_max ) {
+			slist_node_release(list, node);
+			continue;
+		}
+
+		batch[n++] = node;
+		if ( SLIST_BULK_BATCH == n ) {
+			list->allocator->bulk_dalloc(list->allocator->ctx, batch, n);
+			slist_stats_dalloc(list, n);
+			n = 0;
+		}
 	}
 
-	return list;
+	if ( n ) {
+		list->allocator->bulk_dalloc(list->allocator->ctx, batch, n);
+		slist_stats_dalloc(list, n);
+	}
+}/* slist_nodes_drop */
+
+struct slist_list *slist_list_delete_all_nodes(struct slist_list *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	slist_nodes_drop(list, 0);
 
+	return list;
 }/* slist_list_delete_all_nodes */
 
+struct slist_list *slist_list_reset(struct slist_list *list, int data_owned)
+{
+	if ( !list )
+		return NULL;
+
+	if ( !list->allocator || !list->allocator->reset ) {
+		slist_nodes_drop(list, data_owned);
+		return list;
+	}
+
+	//with an arena owning everything there is nothing to visit
+	if ( !data_owned )
+		for(struct slist_node *iter = list->head; iter; iter = iter->next)
+			slist_node_data_dalloc(list, iter);
+
+	//cached nodes come from the arena as well
+	slist_stats_dalloc(list, list->count + list->cache_count);
+	list->allocator->reset(list->allocator->ctx);
+	list->cache = NULL;
+	list->cache_count = 0;
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->count = 0;
+	list->cursor.node = NULL;
+
+	return list;
+}/* slist_list_reset */
+
 struct slist_list *slist_list_reverse(struct slist_list *list)
 {
 	if ( !list || !list->head )
@@ -304,6 +895,9 @@ struct slist_list *slist_list_reverse(struct slist_list *list)
 	struct slist_node *prev = NULL;
 	struct slist_node *next = NULL;
 
+	//old head is the new tail
+	list->tail = head;
+
 	while ( head )
 	{
 		//set the head as last node
@@ -321,6 +915,7 @@ struct slist_list *slist_list_reverse(struct slist_list *list)
 	//set new head and return
 	next = list->head;
 	list->head = next;
+	list->cursor.index = list->count + 1 - list->cursor.index;
 
 	return list;
 }/* slist_list_reverse */
@@ -330,34 +925,40 @@ inline size_t slist_get_size(struct slist_list *list)
 	return list->count;
 }/* slist_get_size */
 
+int slist_get_stats(const struct slist_list *list, struct slist_stats *stats)
+{
+#ifdef SLIST_STATS
+	if ( !list || !stats )
+		return 0;
+
+	*stats = list->stats;
+
+	return 1;
+#else
+	return 0;
+#endif
+}/* slist_get_stats */
+
 struct slist_list *slist_list_push(struct slist_list *list,
 				   struct slist_list *s_list)
 {
 	if ( !list || !s_list || !s_list->head )
 		return NULL;
 
-	struct slist_node *iter = s_list->head;
-	struct slist_node *head = list->head;
+	slist_stats_move(s_list, list, s_list->count);
 
-	if ( !list->head ) {
-		list->head = s_list->head;
-		list->count = s_list->count;
-		//empty s_list
-		s_list->head = NULL;
-		s_list->count = 0;
-		return list;
-	}
-
-	//skip to end of s_list
-	while( NULL != iter->next )
-		iter = iter->next;
+	s_list->tail->next = list->head;
+	if ( !list->tail )
+		list->tail = s_list->tail;
 
 	list->head = s_list->head;
-	iter->next = head;
 	list->count += s_list->count;
+	list->cursor.index += s_list->count;
 	//empty s_list
 	s_list->head = NULL;
+	s_list->tail = NULL;
 	s_list->count = 0;
+	s_list->cursor.node = NULL;
 
 	return list;
 
@@ -369,26 +970,20 @@ struct slist_list *slist_list_append(struct slist_list *list,
 	if ( !list || !s_list || !s_list->head )
 		return NULL;
 
-	struct slist_node *iter = list->head;
+	slist_stats_move(s_list, list, s_list->count);
 
-	if ( !list->head ) {
+	if ( list->tail )
+		list->tail->next = s_list->head;
+	else
 		list->head = s_list->head;
-		list->count = s_list->count;
-		//empty s_list
-		s_list->head = NULL;
-		s_list->count = 0;
-		return list;
-	}
 
-	//slip to end of list
-	while( NULL != iter->next )
-		iter = iter->next;
-
-	iter->next = s_list->head;
+	list->tail = s_list->tail;
 	list->count += s_list->count;
 	//empty s_list
 	s_list->head = NULL;
+	s_list->tail = NULL;
 	s_list->count = 0;
+	s_list->cursor.node = NULL;
 
 	return list;
 
@@ -405,14 +1000,19 @@ struct slist_list *slist_list_split(struct slist_list *list, void *key,
 
 	//check key @ head
 	if ( 0 == cmp(list->head->data, key) ) {
-		n_list = slist_list_new(list->node_alloc, list->node_dalloc);
+		n_list = slist_list_new_from(list);
 		if ( NULL == n_list )
 			return NULL;
 
+		n_list->data_dalloc = list->data_dalloc;
+		slist_cursor_cut(list, n_list, 1);
+		slist_stats_move(list, n_list, list->count);
 		n_list->head = list->head;
+		n_list->tail = list->tail;
 		n_list->count = list->count;
 		//make list empty
 		list->head = NULL;
+		list->tail = NULL;
 		list->count = 0;
 		return n_list;
 	}
@@ -431,14 +1031,19 @@ struct slist_list *slist_list_split(struct slist_list *list, void *key,
 	if ( NULL == iter->next )
 		return NULL;
 
-	n_list = slist_list_new(list->node_alloc, list->node_dalloc);
+	n_list = slist_list_new_from(list);
 
 	if ( NULL == n_list )
 		return NULL;
 
 	//keep in mind we are one node behind so we can remove/trim
+	n_list->data_dalloc = list->data_dalloc;
+	slist_cursor_cut(list, n_list, idx + 2);
 	n_list->head = iter->next;
+	n_list->tail = list->tail;
+	list->tail = iter;
 	n_list->count = list->count - idx - 1;
+	slist_stats_move(list, n_list, n_list->count);
 	list->count = idx + 1;
 	iter->next = NULL;
 
@@ -457,44 +1062,667 @@ struct slist_list *slist_list_split_at(struct slist_list *list,
 	struct slist_node *head = NULL;
 	struct slist_node *prev = NULL;
 
-	size_t idx = 1;
-
 	//create our slist
-	n_list = slist_list_new(list->node_alloc, list->node_dalloc);
+	n_list = slist_list_new_from(list);
 
 	if ( !n_list )
 		return NULL;
 
+	n_list->data_dalloc = list->data_dalloc;
+
 	//remove at head
 	if ( 1 == index ) {
+		slist_cursor_cut(list, n_list, 1);
+		slist_stats_move(list, n_list, list->count);
 		n_list->head = list->head;
+		n_list->tail = list->tail;
 		n_list->count = list->count;
 		list->head = NULL;
+		list->tail = NULL;
 		list->count = 0;
 		return n_list;
 	}
 
-	prev = head = list->head;
+	prev = slist_node_walk(list, index - 1);
+	head = prev->next;
+
+	slist_cursor_cut(list, n_list, index);
+	slist_cursor_set(list, prev, index - 1);
+
+	prev->next = NULL;
+	n_list->head = head;
+	n_list->tail = list->tail;
+	list->tail = prev;
+
+	//nodes from 'index' to the tail move
+	n_list->count = list->count - index + 1;
+	list->count = index - 1;
+	slist_stats_move(list, n_list, n_list->count);
+
+	return n_list;
+
+}/* slist_list_split_at */
+
+struct slist_list *slist_filter_inplace(struct slist_list *list,
+					slist_filter_func func)
+{
+	if ( !list || !list->head || !func )
+		return NULL;
+
+	struct slist_node *iter = list->head;
+	struct slist_node *prev = NULL;
+	struct slist_node *next = NULL;
+	size_t rank = 1;
+
+	while ( iter ) {
+		next = iter->next;
+
+		if ( func(iter->data) ) {
+			prev = iter;
+			++rank;
+			iter = next;
+			continue;
+		}
+
+		slist_cursor_remove(list, iter, prev, rank);
+
+		if ( prev )
+			prev->next = next;
+		else
+			list->head = next;
+
+		if ( list->tail == iter )
+			list->tail = prev;
+
+		--list->count;
+		iter->next = NULL;
+		slist_node_delete(list, iter);
+		iter = next;
+	}
+
+	return list;
+}/* slist_filter_inplace */
+
+/****************************************************************************
+ * node cache interface implementation
+ ****************************************************************************/
 
-	for(idx = index - 1; idx; --idx)
+struct slist_list *slist_cache_limit(struct slist_list *list, size_t max)
+{
+	if ( !list )
+		return NULL;
+
+	list->cache_max = max;
+	slist_cache_trim(list, max);
+
+	return list;
+}/* slist_cache_limit */
+
+size_t slist_cache_trim(struct slist_list *list, size_t keep)
+{
+	if ( !list )
+		return 0;
+
+	struct slist_node *node = NULL;
+	size_t freed = 0;
+
+	while ( list->cache_count > keep )
 	{
-		prev = head;
-		head = head->next;
+		node = list->cache;
+		list->cache = node->next;
+		--list->cache_count;
+		slist_dalloc(list, node);
+		++freed;
 	}
 
+	return freed;
+}/* slist_cache_trim */
 
-	prev->next = NULL;
-	n_list->head = head;
 
-	//remove at tail ?
-	if (list->count == index ) {
-		n_list->count = list->count - index + 1;
-	} else {
-		n_list->count = index;
+/****************************************************************************
+ * sorted list interface implementation
+ ****************************************************************************/
+
+struct slist_list *slist_list_sort(struct slist_list *list,
+				   slist_cmp3_func cmp)
+{
+	if ( !list || !list->head || !cmp )
+		return NULL;
+
+	struct slist_node *iter = NULL;
+
+	list->head = slist_sort_chain(list->head, cmp);
+
+	for(iter = list->head; NULL != iter->next; iter = iter->next)
+		;
+
+	list->tail = iter;
+	list->cursor.node = NULL;
+
+	return list;
+}/* slist_list_sort */
+
+struct slist_list *slist_list_radix_sort(struct slist_list *list,
+					 slist_key_func key, size_t width)
+{
+	if ( !list || !list->head || !key || 0 == width || 8 < width )
+		return NULL;
+
+	slist_radix_chain(list, key, width);
+	list->cursor.node = NULL;
+
+	return list;
+}/* slist_list_radix_sort */
+
+struct slist_node *slist_node_insert_sorted(struct slist_list *list,
+					    struct slist_node *node,
+					    slist_cmp3_func cmp)
+{
+	if ( !list || !node || !cmp )
+		return NULL;
+
+	struct slist_node *prev = NULL;
+	size_t idx;
+
+	//in order input only ever looks at the tail
+	if ( !list->tail || cmp(list->tail->data, node->data) <= 0 )
+		return slist_node_append(list, node);
+
+	slist_node_bound(list, node->data, cmp, 1, &prev, &idx);
+	if ( !prev )
+		return slist_node_push(list, node);
+
+	node->next = prev->next;
+	prev->next = node;
+	++list->count;
+
+	if ( list->cursor.node && list->cursor.index >= idx )
+		++list->cursor.index;
+
+	return node;
+}/* slist_node_insert_sorted */
+
+struct slist_node *slist_node_find_sorted(struct slist_list *list, void *key,
+					  slist_cmp3_func cmp)
+{
+	struct slist_node *node = slist_node_bound_at(list, key, cmp, 0);
+
+	if ( !node || 0 != cmp(node->data, key) )
+		return NULL;
+
+	return node;
+}/* slist_node_find_sorted */
+
+struct slist_node *slist_node_lower_bound(struct slist_list *list, void *key,
+					  slist_cmp3_func cmp)
+{
+	return slist_node_bound_at(list, key, cmp, 0);
+}/* slist_node_lower_bound */
+
+struct slist_node *slist_node_upper_bound(struct slist_list *list, void *key,
+					  slist_cmp3_func cmp)
+{
+	return slist_node_bound_at(list, key, cmp, 1);
+}/* slist_node_upper_bound */
+
+struct slist_list *slist_list_merge_sorted(struct slist_list *list,
+					   struct slist_list *s_list,
+					   slist_cmp3_func cmp)
+{
+	if ( !list || !s_list || !s_list->head || !cmp )
+		return NULL;
+
+	//nothing to interleave
+	if ( !list->head || cmp(list->tail->data, s_list->head->data) <= 0 )
+		return slist_list_append(list, s_list);
+
+	slist_stats_move(s_list, list, s_list->count);
+
+	//ties go to 'list', so its tail only stays last when it sorts after
+	if ( cmp(list->tail->data, s_list->tail->data) <= 0 )
+		list->tail = s_list->tail;
+
+	list->head = slist_sort_merge(list->head, s_list->head, cmp);
+
+	list->count += s_list->count;
+	list->cursor.node = NULL;
+	//empty s_list
+	s_list->head = NULL;
+	s_list->tail = NULL;
+	s_list->count = 0;
+	s_list->cursor.node = NULL;
+
+	return list;
+}/* slist_list_merge_sorted */
+
+struct slist_list *slist_list_merge_k(struct slist_list *list,
+				      struct slist_list **lists, size_t k,
+				      slist_cmp3_func cmp)
+{
+	if ( !list || !lists || !cmp )
+		return NULL;
+
+	struct slist_merge_src stack[SLIST_MERGE_K_STACK];
+	struct slist_merge_src *heap = stack;
+	struct slist_list *s_list = NULL;
+	struct slist_node *node = NULL;
+	struct slist_node **link = &list->head;
+	size_t n = 0;
+
+	if ( SLIST_MERGE_K_STACK < k + 1 &&
+	     NULL == (heap = SLIST_DEF_ALLOC((k + 1) * sizeof( *heap))) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
 	}
 
+	if ( list->head )
+		heap[n++] = (struct slist_merge_src){ list->head, list->tail, 0 };
+
+	for(size_t i = 0; i < k; ++i)
+	{
+		if ( NULL == (s_list = lists[i]) || !s_list->head || list == s_list )
+			continue;
+
+		heap[n++] = (struct slist_merge_src){ s_list->head, s_list->tail,
+							i + 1 };
+		slist_stats_move(s_list, list, s_list->count);
+		list->count += s_list->count;
+
+		s_list->head = NULL;
+		s_list->tail = NULL;
+		s_list->count = 0;
+		s_list->cursor.node = NULL;
+	}
+
+	for(size_t i = n / 2; i--; )
+		slist_merge_sift(heap, n, i, cmp);
+
+	//the last input left is linked whole
+	while ( 1 < n )
+	{
+		node = heap[0].node;
+		*link = node;
+		link = &node->next;
+
+		if ( node->next )
+			heap[0].node = node->next;
+		else
+			heap[0] = heap[--n];
+
+		slist_merge_sift(heap, n, 0, cmp);
+	}
+
+	if ( n ) {
+		*link = heap[0].node;
+		list->tail = heap[0].tail;
+	}
+
+	list->cursor.node = NULL;
+
+	if ( heap != stack )
+		SLIST_DEF_DALLOC(heap);
+
+	return list;
+}/* slist_list_merge_k */
+
+/****************************************************************************
+ * inline payload interface implementation
+ ****************************************************************************/
+
+struct slist_node *slist_node_new_inline(struct slist_list *list,
+					 const void *data, size_t size)
+{
+#ifdef SLIST_COMPACT_NODE
+	return NULL;
+#else
+	if ( 0 == size || SLIST_INLINE_MAX < size )
+		return NULL;
+
+	struct slist_node *node = NULL;
+
+	if ( NULL == (node = slist_alloc(list, sizeof( struct slist_node) + size)) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	if ( data )
+		memcpy(node->payload, data, size);
+
+	node->data = node->payload;
+	node->data_dalloc = slist_inline_dalloc;
+	node->next = NULL;
+
+	return node;
+#endif
+}/* slist_node_new_inline */
+
+struct slist_node *slist_inline_find(struct slist_list *list, void *key,
+				     int (*cmp)(void *a, void *b))
+{
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	struct slist_node *iter;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+	{
+		if ( 0 == cmp(iter->payload, key) )
+			break;
+	}
+
+	return iter;
+}/* slist_inline_find */
+
+struct slist_node *slist_inline_remove(struct slist_list *list, void *key,
+				       int (*cmp)(void *a, void *b))
+{
+	if ( !list || !list->head || !key || !cmp )
+		return NULL;
+
+	struct slist_node *iter = NULL;
+	struct slist_node *prev = NULL;
+	size_t idx = 1;
+
+	for(iter = list->head; NULL != iter; prev = iter, iter = iter->next, ++idx)
+	{
+		if ( 0 == cmp(iter->payload, key) )
+			break;
+	}
+
+	//see if found a node
+	if ( !iter )
+		return NULL;
+
+	slist_cursor_remove(list, iter, prev, idx);
+
+	if ( prev )
+		prev->next = iter->next;
+	else
+		list->head = iter->next;
+
+	if ( list->tail == iter )
+		list->tail = prev;
+
+	--list->count;
+	return iter;
+}/* slist_inline_remove */
+
+void slist_inline_foreach(struct slist_list *list,
+			  void *(*action)(void *carry, void *data, void *param),
+			  void *param)
+{
+	if ( !list || !list->head || !action )
+		return;
+
+	struct slist_node *iter = NULL;
+	void *carry = NULL;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+	{
+		carry = action(carry, iter->payload, param);
+	}
+
+}/* slist_inline_foreach */
+
+/****************************************************************************
+ * intrusive interface implementation
+ ****************************************************************************/
+
+struct slist_ilist *slist_ilist_init(struct slist_ilist *list)
+{
+	if ( !list )
+		return NULL;
+
+	list->count = 0;
+	list->head = NULL;
+	list->tail = NULL;
+
+	return list;
+}/* slist_ilist_init */
+
+struct slist_link *slist_link_push(struct slist_ilist *list,
+				   struct slist_link *link)
+{
+	if ( !list || !link )
+		return NULL;
+
+	link->next = list->head;
+	if ( !list->head )
+		list->tail = link;
+
+	list->head = link;
+	++list->count;
+
+	return link;
+}/* slist_link_push */
+
+struct slist_link *slist_link_append(struct slist_ilist *list,
+				     struct slist_link *link)
+{
+	if ( !list || !link )
+		return NULL;
+
+	link->next = NULL;
+	if ( !list->tail )
+		list->head = link;
+	else
+		list->tail->next = link;
+
+	list->tail = link;
+	++list->count;
+
+	return link;
+}/* slist_link_append */
+
+struct slist_link *slist_link_pop(struct slist_ilist *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	struct slist_link *link = list->head;
+
+	list->head = link->next;
+	if ( !list->head )
+		list->tail = NULL;
+
+	link->next = NULL;
+	--list->count;
+	return link;
+}/* slist_link_pop */
+
+//unlinks the link following 'prev', or head when 'prev' is NULL
+static struct slist_link *slist_link_unlink_after(struct slist_ilist *list,
+						  struct slist_link *prev)
+{
+	struct slist_link *link = (prev ? prev->next : list->head);
+
+	if ( prev )
+		prev->next = link->next;
+	else
+		list->head = link->next;
+
+	if ( list->tail == link )
+		list->tail = prev;
+
+	link->next = NULL;
+	--list->count;
+	return link;
+}/* slist_link_unlink_after */
+
+struct slist_link *slist_link_unlink(struct slist_ilist *list,
+				     struct slist_link *link)
+{
+	if ( !list || !list->head || !link )
+		return NULL;
+
+	struct slist_link *prev = NULL;
+	struct slist_link *iter = NULL;
+
+	for(iter = list->head; NULL != iter; prev = iter, iter = iter->next)
+	{
+		if ( iter == link )
+			return slist_link_unlink_after(list, prev);
+	}
+
+	return NULL;
+}/* slist_link_unlink */
+
+struct slist_link *slist_link_find(struct slist_ilist *list, void *key,
+				   slist_link_cmp_func cmp)
+{
+	if ( !list || !list->head || !cmp )
+		return NULL;
+
+	struct slist_link *iter;
+
+	for(iter = list->head; NULL != iter; iter = iter->next)
+	{
+		if ( 0 == cmp(iter, key) )
+			break;
+	}
+
+	return iter;
+}/* slist_link_find */
+
+struct slist_link *slist_link_remove(struct slist_ilist *list, void *key,
+				     slist_link_cmp_func cmp)
+{
+	if ( !list || !list->head || !cmp )
+		return NULL;
+
+	struct slist_link *prev = NULL;
+	struct slist_link *iter = NULL;
+
+	for(iter = list->head; NULL != iter; prev = iter, iter = iter->next)
+	{
+		if ( 0 == cmp(iter, key) )
+			return slist_link_unlink_after(list, prev);
+	}
+
+	return NULL;
+}/* slist_link_remove */
+
+void slist_link_foreach(struct slist_ilist *list,
+			slist_link_action_func action, void *param)
+{
+	if ( !list || !list->head || !action )
+		return;
+
+	struct slist_link *iter = NULL;
+	struct slist_link *next = NULL;
+	void *carry = NULL;
+
+	for(iter = list->head; NULL != iter; iter = next)
+	{
+		next = iter->next;
+		carry = action(carry, iter, param);
+	}
+
+}/* slist_link_foreach */
+
+struct slist_ilist *slist_ilist_reverse(struct slist_ilist *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	struct slist_link *head = list->head;
+	struct slist_link *prev = NULL;
+	struct slist_link *next = NULL;
+
+	list->tail = head;
+	while ( head )
+	{
+		next = head->next;
+		head->next = prev;
+		prev = head;
+		head = next;
+	}
+
+	list->head = prev;
+	return list;
+}/* slist_ilist_reverse */
+
+struct slist_ilist *slist_ilist_append(struct slist_ilist *list,
+				       struct slist_ilist *s_list)
+{
+	if ( !list || !s_list || !s_list->head )
+		return NULL;
+
+	if ( !list->head )
+		list->head = s_list->head;
+	else
+		list->tail->next = s_list->head;
+
+	list->tail = s_list->tail;
+	list->count += s_list->count;
+
+	slist_ilist_init(s_list);
+	return list;
+}/* slist_ilist_append */
+
+//moves everything after 'prev' (or all when 'prev' is NULL) into 'n_list',
+//'index' being the position of the first moved link
+static struct slist_ilist *slist_ilist_cut(struct slist_ilist *list,
+					   struct slist_link *prev,
+					   size_t index,
+					   struct slist_ilist *n_list)
+{
+	n_list->head = (prev ? prev->next : list->head);
+	n_list->tail = list->tail;
+	n_list->count = list->count - index + 1;
+
 	list->count = index - 1;
+	list->tail = prev;
+	if ( prev )
+		prev->next = NULL;
+	else
+		list->head = NULL;
 
 	return n_list;
+}/* slist_ilist_cut */
 
-}/* slist_list_split_at */
+struct slist_ilist *slist_ilist_split(struct slist_ilist *list, void *key,
+				      slist_link_cmp_func cmp,
+				      struct slist_ilist *n_list)
+{
+	if ( !list || !list->head || !cmp || !n_list )
+		return NULL;
+
+	struct slist_link *prev = NULL;
+	struct slist_link *iter = NULL;
+	size_t idx = 1;
+
+	for(iter = list->head; NULL != iter; prev = iter, iter = iter->next, ++idx)
+	{
+		if ( 0 == cmp(iter, key) )
+			return slist_ilist_cut(list, prev, idx, n_list);
+	}
+
+	return NULL;
+}/* slist_ilist_split */
+
+struct slist_ilist *slist_ilist_split_at(struct slist_ilist *list,
+					 const size_t index,
+					 struct slist_ilist *n_list)
+{
+	if ( !list || !list->head || 0 == index || index > list->count ||
+	     !n_list )
+		return NULL;
+
+	struct slist_link *prev = NULL;
+	size_t idx;
+
+	if ( 1 < index ) {
+		prev = list->head;
+		for(idx = 2; idx < index; ++idx)
+			prev = prev->next;
+	}
+
+	return slist_ilist_cut(list, prev, index, n_list);
+}/* slist_ilist_split_at */
@@ -25,10 +25,34 @@
  ****************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "allocator.h"
 
 #define SLIST_DEF_ALLOC malloc
 #define SLIST_DEF_DALLOC free
 
+//biggest payload slist_node_new_inline copies into a node
+#define SLIST_INLINE_MAX 64
+
+/* data pointers slist_node_foreach_batch gathers on the stack before
+ * each call. may be defined before including
+ */
+#ifndef SLIST_BATCH_SIZE
+#define SLIST_BATCH_SIZE 64
+#endif
+
+/* define SLIST_COMPACT_NODE to drop 'data_dalloc' from every node.
+ * 'data' is then deleted by the 'list' wide 'data_dalloc' alone,
+ * see slist_data_dalloc. saves a pointer per node.
+ * inline nodes need that pointer, see slist_node_new_inline
+ */
+
+/* define SLIST_STATS to have every list count the node traffic going
+ * through its allocator, see slist_get_stats.
+ */
+
 /****************************************************************************
  * base data structures
  ****************************************************************************/
@@ -36,8 +60,37 @@
 struct slist_node
 {
 	void *data;
+#ifndef SLIST_COMPACT_NODE
 	void (*data_dalloc)(void *);
+#endif
 	struct slist_node *next;
+	//only used by inline nodes, see slist_node_new_inline
+	unsigned char payload[];
+};
+
+//node traffic of a list, only kept with SLIST_STATS defined
+struct slist_stats
+{
+	size_t allocs;
+	size_t dallocs;
+	//nodes taken and not given back yet, cached ones included
+	size_t live;
+	size_t peak;
+	//node bytes requested from the allocator, list itself excluded
+	size_t bytes;
+	//'data' handed to a 'data_dalloc'
+	size_t data_dallocs;
+};
+
+/* last position looked up. positional calls walk from it instead of the
+ * head when it is not past the wanted 'index'. every operation keeps it
+ * pointing at the right place, or clears it.
+ */
+struct slist_cursor
+{
+	//NULL when there is no position to start from
+	struct slist_node *node;
+	size_t index;
 };
 
 struct slist_list
@@ -46,14 +99,70 @@ struct slist_list
 	void *(*node_alloc)(size_t);
 	void (*node_dalloc)(void *);
 	struct slist_node *head;
+	//keeps appending O(1)
+	struct slist_node *tail;
+	const struct dutils_allocator *allocator;
+	//deletes 'data' of nodes without their own, see slist_data_dalloc
+	void (*data_dalloc)(void *);
+	//recycled nodes, see slist_cache_limit
+	struct slist_node *cache;
+	size_t cache_count;
+	size_t cache_max;
+	struct slist_cursor cursor;
+#ifdef SLIST_STATS
+	struct slist_stats stats;
+#endif
 };
 
+/* intrusive variant: 'slist_link' is embedded in the user structure, so a
+ * single allocation holds both the element and its link.
+ * see slist_container_of to get back to the embedding structure.
+ */
+struct slist_link
+{
+	struct slist_link *next;
+};
+
+struct slist_ilist
+{
+	size_t count;
+	struct slist_link *head;
+	struct slist_link *tail;
+};
+
+/* returns a pointer to the 'type' structure embedding 'ptr' as 'member'
+ * example: *****************************************************************
+ * ------- struct item { int key; struct slist_link link; };
+ * ------- struct item *it = slist_container_of(link, struct item, link);
+ * **************************************************************************
+ */
+#define slist_container_of(ptr, type, member) \
+	((type *)((char *)(ptr) - offsetof(type, member)))
+
 /****************************************************************************
  * convinience data types for library consumers/users
  ****************************************************************************/
 
 typedef struct slist_node slist_node_t;
 typedef struct slist_list slist_list_t;
+typedef struct slist_stats slist_stats_t;
+typedef struct slist_cursor slist_cursor_t;
+typedef struct slist_link slist_link_t;
+typedef struct slist_ilist slist_ilist_t;
+
+//needs to return 0 when the element embedding 'link' matches 'key'
+typedef int (*slist_link_cmp_func)(struct slist_link *link, void *key);
+typedef void *(*slist_link_action_func)(void *carry, struct slist_link *link,
+					void *param);
+//needs to return <0, 0 or >0 when 'a' sorts before, with or after 'b'
+typedef int (*slist_cmp3_func)(void *a, void *b);
+//returns the unsigned integer 'data' sorts by, see slist_list_radix_sort
+typedef uint64_t (*slist_key_func)(void *data);
+//needs to return non 0 for the 'data' to keep
+typedef int (*slist_filter_func)(void *data);
+//batched form of the foreach 'action', 'n' consecutive 'data' at a time
+typedef void *(*slist_batch_action_func)(void *carry, void **data, size_t n,
+					 void *param);
 
 
 /****************************************************************************
@@ -93,12 +202,58 @@ struct slist_list *slist_list_new(void *(*node_alloc)(size_t),
 				  void (*node_dalloc)(void *));
 
 
+/* returns 'list' initialized to allocate its 'nodes' through 'allocator'
+ * NULL is returned if 'list' is NULL
+ * passing NULL to 'allocator' behaves like slist_init(list, NULL, NULL)
+ *
+ * ABOUT 'allocator': only a pointer is kept, see allocator.h.
+ * ------- 'node_alloc' and 'node_dalloc' are set to NULL and ignored.
+ *
+ * passing invalid ['list' or 'allocator' ]
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_init_allocator(struct slist_list *list,
+					const struct dutils_allocator *allocator);
+
+
+/* returns a new allocated 'list' that allocates its 'nodes' through
+ * ------- 'allocator'. 'list' has to be freed
+ * passing NULL to 'allocator' behaves like slist_list_new(NULL, NULL)
+ * NULL is returned if SLIST_DEF_ALLOC fails
+ *
+ * ABOUT 'list' _memory_ : the 'list' itself always comes from
+ * ------- SLIST_DEF_ALLOC, so 'allocator' only ever sees node sized
+ * ------- requests. slist_list_delete knows how to release it.
+ *
+ * passing invalid ['allocator' ]
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_list_new_allocator(const struct dutils_allocator *allocator);
+
+
+/* returns 'list' after setting 'data_dalloc' to delete the 'data' of
+ * ------- every 'node' that has no 'dalloc' of its own.
+ * returns NULL if 'list' is NULL
+ * passing NULL in 'data_dalloc' unsets it, which is the default.
+ *
+ * NOTE: set it right after creating the 'list'. it is all there is with
+ * ------- SLIST_COMPACT_NODE defined. split functions copy it over.
+ *
+ * passing invalid ['list' or 'data_dalloc' ]
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_data_dalloc(struct slist_list *list,
+				     void (*data_dalloc)(void *));
+
+
 /* returns a new allocated 'node' initialized with 'data' and 'dalloc'
  * ------- returned 'node' needs to be freed
  * passing NULL in 'data' sets 'node' 'data' to NULL
  * passing NULL in 'dalloc' sets 'node' 'dalloc' to NULL
  * ------- if 'dalloc' is set, _delete_ functions attemp to delete 'data'
  *
+ * NOTE: 'dalloc' is ignored with SLIST_COMPACT_NODE, see slist_data_dalloc
+ *
  * passing invalid ['list' or 'data' or 'dalloc' ]
  * ------- results in undefined behavior
  */
@@ -120,7 +275,9 @@ void slist_node_print(const struct slist_node *node,
 
 
 /* deletes 'node'
- * attempts to delete 'data' when 'data_dalloc' is set.
+ * attempts to delete 'data' when 'data_dalloc' is set, or else
+ * ------- with the 'list' one, see slist_data_dalloc.
+ * keeps 'node' in the 'list' cache when it has room, see slist_cache_limit
  * passing NULL in 'list' returns with no operation executed
  * passing NULL in 'node' returns with no operation executed
  *
@@ -136,6 +293,7 @@ void slist_node_delete(struct slist_list *list,
  *
  * NOTE: deleting the 'list0 won't free the nodes contained in it.
  * ------- see slist_list_delete_all_nodes for that.
+ * ------- nodes held by the 'list' cache are freed.
  *
  * passing invalid ['list']
  * ------- results in undefined behavior
@@ -154,7 +312,7 @@ struct slist_node *slist_node_push(struct slist_list *list,
 				   struct slist_node *node);
 
 
-/* adds 'node' to the end of 'list', returning it.
+/* adds 'node' to the end of 'list', returning it. O(1), 'list' keeps a 'tail'
  * passing NULL in 'list' returns NULL
  * passing NULL in 'node' returns NULL
  *
@@ -230,7 +388,9 @@ struct slist_node *slist_node_remove(struct slist_list *list, void *key,
  * returns NULL if 'list' is empty
  * returns NULL if 'index' is out of bounds
  *
- * ABOUT 'index' : starts counting at 1
+ * ABOUT 'index' : starts counting at 1. walks from the cursor when it is
+ * -------- not past 'index', from the head otherwise. the cursor is left
+ * -------- on the 'node' before the removed one.
  *
  * passing invalid ['list' or 'index']
  * ------- results in undefined behavior
@@ -239,6 +399,23 @@ struct slist_node *slist_node_remove_at(struct slist_list *list,
 					const size_t index);
 
 
+/* returns the 'node' stored in 'index' position
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'list' is empty
+ * returns NULL if 'index' is out of bounds
+ *
+ * ABOUT 'index' : starts counting at 1. walks from the cursor when it is
+ * -------- not past 'index', from the head otherwise, the tail is O(1).
+ * -------- the cursor is left on the 'node' returned, so near-sequential
+ * -------- access costs O(1) per call.
+ *
+ * passing invalid ['list' or 'index']
+ * ------- results in undefined behavior
+ */
+struct slist_node *slist_node_get_at(struct slist_list *list,
+				     const size_t index);
+
+
 /* executes 'action' in each 'node' contained in 'list'
  * returns without any action performed if 'list' is NULL
  * returns without any action performed if 'list' is empty
@@ -264,9 +441,24 @@ void slist_node_foreach(struct slist_list *list,
 			void *param);
 
 
+/* same as slist_node_foreach, 'action' being called once for every
+ * ------- SLIST_BATCH_SIZE 'nodes', or less for the last call.
+ *
+ * ABOUT 'action': receives the 'data' of 'n' consecutive 'nodes' in
+ * -------- order, 'data' is only valid until 'action' returns.
+ *
+ * passing invalid ['list' or 'action' or 'param']
+ * ------- results in undefined behavior
+ */
+void slist_node_foreach_batch(struct slist_list *list,
+			      slist_batch_action_func action, void *param);
+
+
 /* returns 'list' empty deleting all 'nodes' contained in 'list'
  * returns NULL if 'list' is NULL
  * returns NULL if 'list' is empty
+ * NOTE: when 'list' allocator provides 'bulk_dalloc' the 'nodes' are
+ * ------- released in batches instead of one at a time.
  * ABOUT 'list' _status_ : still needs to be freed. see slist_list_delete
  *
  * passing invalid ['list']
@@ -275,6 +467,29 @@ void slist_node_foreach(struct slist_list *list,
 struct slist_list *slist_list_delete_all_nodes(struct slist_list *list);
 
 
+/* returns 'list' empty releasing all 'nodes' contained in 'list'
+ * returns NULL if 'list' is NULL
+ *
+ * ABOUT 'data_owned': when non zero the 'data' of each 'node' is known to
+ * ------- live in the same arena as the 'nodes' (or to be owned elsewhere)
+ * ------- and 'data_dalloc' is not called.
+ * ABOUT arena mode: when 'list' allocator provides 'reset' (see arena.h)
+ * ------- the 'nodes' are not freed one by one, the allocator is reset
+ * ------- instead. with 'data_owned' set this takes O(1) node visits.
+ * ------- otherwise it behaves like slist_list_delete_all_nodes, node
+ * ------- cache and bulk_dalloc included, 'data_owned' still honored.
+ *
+ * NOTE: lists split off an arena backed 'list' share its arena,
+ * ------- resetting one of them drops the 'nodes' of every one.
+ * ------- the others are left dangling and have to be reset as well,
+ * ------- with 'data_owned' set, before the arena hands out new blocks.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_list_reset(struct slist_list *list, int data_owned);
+
+
 /* returns 'list' reversed
  * example:******************************************************************
  * -------- if your list configuration looks like the following
@@ -304,6 +519,20 @@ struct slist_list *slist_list_reverse(struct slist_list *list);
 size_t slist_get_size(struct slist_list *list);
 
 
+/* returns 1 after copying the 'list' counters into 'stats'
+ * returns 0 if 'list' or 'stats' are NULL
+ * returns 0 if built without SLIST_STATS, 'stats' is left untouched
+ *
+ * ABOUT [counters]: kept since 'list' was set up. split and list
+ * ------- push/append move the 'live' count along with the nodes, nodes
+ * ------- moved by hand count against the list that frees them.
+ *
+ * passing invalid ['list' or 'stats' ]
+ * ------- results in undefined behavior
+ */
+int slist_get_stats(const struct slist_list *list, struct slist_stats *stats);
+
+
 /* returns 'list' after merging 's_list' into 'list' head.
  * returns NULL if 'list' is NULL
  * returns NULL if 's_list' is NULL
@@ -372,6 +601,8 @@ struct slist_list *slist_list_append(struct slist_list *list,
  *
  * ---info makes 'list' empty if 'key' matches @ head
  * ---info the newly allocated list has to be freed. see slist_list_delete
+ * ---info the new list allocates as 'list' does, arena included.
+ * ------- see slist_list_reset
  *
  * ABOUT cmp: function needs to return 0 when 'a' and 'b' match
  * example: *****************************************************************
@@ -398,6 +629,8 @@ struct slist_list *slist_list_split(struct slist_list *list, void *key,
  *
  * ---info makes 'list' empty if 'index' is 1/head
  * ---info the newly allocated list has to be freed. see slist_list_delete
+ * ---info the new list allocates as 'list' does, arena included.
+ * ------- see slist_list_reset
  *
  * ABOUT cmp: function needs to return 0 when 'a' and 'b' match
  * example: *****************************************************************
@@ -416,4 +649,415 @@ struct slist_list *slist_list_split_at(struct slist_list *list,
 				       const size_t index);
 
 
+/* returns 'list' after deleting, see slist_node_delete, every 'node'
+ * ------- whose 'data' fails the 'func' predicate. single pass, no allocation.
+ * returns NULL if 'list' is NULL or empty
+ * returns NULL if 'func' is NULL
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_filter_inplace(struct slist_list *list,
+					slist_filter_func func);
+
+
+/****************************************************************************
+ * node cache interface and _base_ documentation
+ *
+ * a 'list' may keep up to 'cache_max' deleted 'nodes' around, and hand
+ * them back on slist_node_new before asking its allocator. push/pop work
+ * queues then reach a steady state with no allocator calls at all.
+ * inline nodes are never cached, their size varies.
+ ****************************************************************************/
+
+/* returns 'list' after bounding its node cache to 'max' nodes
+ * returns NULL if 'list' is NULL
+ * passing 0 in 'max' disables the cache, which is the default
+ *
+ * NOTE: cached nodes above 'max' are freed
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_cache_limit(struct slist_list *list, size_t max);
+
+
+/* returns the number of cached nodes freed to leave at most 'keep'
+ * ------- in the 'list' cache
+ * returns 0 if 'list' is NULL
+ *
+ * NOTE: 'lists' set up with slist_init need slist_cache_trim(list, 0)
+ * ------- before going away, slist_list_delete does it on its own.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+size_t slist_cache_trim(struct slist_list *list, size_t keep);
+
+
+/****************************************************************************
+ * sorted list interface and _base_ documentation
+ *
+ * same as the dlist sorted list interface, see dlist.h. 'cmp' always gets
+ * a 'node' 'data' as 'a'. using an unsorted 'list', or a 'cmp' other than
+ * the one it was sorted with, results in undefined behavior.
+ ****************************************************************************/
+
+/* returns 'list' after sorting its 'nodes' by 'cmp'
+ * returns NULL if 'list' or 'cmp' are NULL
+ * returns NULL if 'list' is empty
+ *
+ * ABOUT [sorting]: bottom-up merge sort relinking the 'nodes' in place,
+ * ------- O(n log n) time and no allocation at all. it is stable, equal
+ * ------- 'nodes' keep their order.
+ *
+ * passing invalid ['list' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_list_sort(struct slist_list *list,
+				   slist_cmp3_func cmp);
+
+
+/* returns 'list' after sorting its 'nodes' by the integer 'key' gives
+ * ------- for their 'data', smallest first.
+ * returns NULL if 'list' or 'key' are NULL
+ * returns NULL if 'list' is empty
+ * returns NULL if 'width' is 0 or bigger than 8
+ *
+ * ABOUT ['width']: the number of low bytes of each key that take part,
+ * ------- 4 for 32-bit keys. higher bytes are ignored.
+ * ABOUT [sorting]: LSD radix sort relinking the 'nodes' through 256
+ * ------- buckets, one pass per key byte, O(n * 'width') and no allocation.
+ * ------- the first pass also finds the bytes equal on every key, the
+ * ------- passes for those are skipped. it is stable. 'key' runs once per
+ * ------- 'node' on each pass, so it should be cheap.
+ *
+ * NOTE: keys compare as unsigned. for signed keys flip the sign bit
+ * ------- in 'key', ('value' ^ (1ULL << 63)) for 64-bit ones.
+ *
+ * passing invalid ['list' or 'key']
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_list_radix_sort(struct slist_list *list,
+					 slist_key_func key, size_t width);
+
+
+/* returns 'node' after linking it into 'list' after every 'node' that
+ * ------- sorts before or with it, so equal 'nodes' keep insertion order.
+ * returns NULL if 'list', 'node' or 'cmp' are NULL
+ *
+ * NOTE: 'nodes' sorting after the tail take O(1). the rest walk from the
+ * ------- cursor when it sorts before 'node', from the head otherwise.
+ *
+ * passing invalid ['list' or 'node' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct slist_node *slist_node_insert_sorted(struct slist_list *list,
+					    struct slist_node *node,
+					    slist_cmp3_func cmp);
+
+
+/* returns the first 'node' matching 'key'
+ * returns NULL if 'key' is not found
+ * returns NULL if 'list', 'key' or 'cmp' are NULL
+ *
+ * NOTE: gives up at the first 'node' sorting after 'key', and right
+ * ------- away when the tail sorts before it.
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct slist_node *slist_node_find_sorted(struct slist_list *list, void *key,
+					  slist_cmp3_func cmp);
+
+
+/* returns the first 'node' not sorting before 'key'
+ * returns NULL if every 'node' sorts before 'key'
+ * returns NULL if 'list', 'key' or 'cmp' are NULL
+ *
+ * NOTE: the 'list' cursor is left on the returned 'node', so lookups for
+ * ------- growing keys carry on from there instead of the head.
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct slist_node *slist_node_lower_bound(struct slist_list *list, void *key,
+					  slist_cmp3_func cmp);
+
+
+/* returns the first 'node' sorting after 'key'
+ * returns NULL if no 'node' sorts after 'key'
+ * returns NULL if 'list', 'key' or 'cmp' are NULL
+ *
+ * NOTE: same as slist_node_lower_bound
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct slist_node *slist_node_upper_bound(struct slist_list *list, void *key,
+					  slist_cmp3_func cmp);
+
+
+/* returns 'list' after merging the 'nodes' of 's_list' into it, in order.
+ * returns NULL if 'list', 's_list' or 'cmp' are NULL
+ * returns NULL if 's_list' is empty.
+ *
+ * ABOUT [merging]: same as slist_list_append, 's_list' becomes empty.
+ * ------- on equal 'nodes' the ones from 'list' come first.
+ * ------- takes O(n + m), no 'node' is allocated or copied.
+ *
+ * passing invalid ['list' or 's_list' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct slist_list *slist_list_merge_sorted(struct slist_list *list,
+					   struct slist_list *s_list,
+					   slist_cmp3_func cmp);
+
+
+/* returns 'list' after merging the 'nodes' of the 'k' sorted 'lists'
+ * ------- into it, in order, 'list' counting as one more sorted input.
+ * returns NULL if 'list', 'lists' or 'cmp' are NULL
+ * returns NULL if allocation fails, every list is then left as it was.
+ * entries of 'lists' that are NULL, empty or 'list' itself are skipped.
+ *
+ * ABOUT [merging]: same as slist_list_append, every entry of 'lists'
+ * ------- becomes empty. a heap over the heads picks each 'node' in
+ * ------- O(log k), so it all takes a single O(n log k) pass, no 'node'
+ * ------- is allocated or copied. on equal 'nodes' the ones from 'list'
+ * ------- come first, then those of the lower entries of 'lists'.
+ *
+ * passing invalid ['list' or 'lists' or 'cmp']
+ * ------- results in undefined behavior
+ * ------- passing the same 'list' twice in 'lists'
+ */
+struct slist_list *slist_list_merge_k(struct slist_list *list,
+				     struct slist_list **lists, size_t k,
+				     slist_cmp3_func cmp);
+
+
+/****************************************************************************
+ * inline payload interface and _base_ documentation
+ *
+ * inline nodes carry their 'data' in the 'payload' at the end of the node
+ * itself, so a single allocation holds both. 'data' still points at the
+ * 'payload', so every function above keeps working on them. the functions
+ * below hand callbacks the 'payload' directly, saving the load of 'data'.
+ * they expect every 'node' in the 'list' to be an inline node.
+ ****************************************************************************/
+
+/* returns the 'payload' of an inline 'node' */
+#define slist_node_inline_data(node) ((void *)(node)->payload)
+
+
+/* returns a new allocated inline 'node' holding a copy of 'size' bytes
+ * ------- of 'data'. returned 'node' needs to be freed, see slist_node_delete
+ * returns NULL if 'size' is 0
+ * returns NULL if 'size' is bigger then SLIST_INLINE_MAX
+ * returns NULL if the 'list' allocator fails
+ * returns NULL with SLIST_COMPACT_NODE defined
+ * passing NULL in 'data' leaves the 'payload' uninitialized
+ *
+ * ABOUT allocation: the 'node' takes sizeof(struct slist_node) + 'size'
+ * ------- bytes, fixed size allocators (see slab.h) need room for it.
+ *
+ * NOTE: inline nodes are told apart by the 'data_dalloc' they are given,
+ * ------- changing it makes the 'payload' be handed to a destructor.
+ * ------- compact nodes have no room for that mark, see SLIST_COMPACT_NODE
+ *
+ * passing invalid ['list' or 'data']
+ * ------- results in undefined behavior
+ */
+struct slist_node *slist_node_new_inline(struct slist_list *list,
+					 const void *data, size_t size);
+
+
+/* same as slist_node_find, 'cmp' receiving each 'node' 'payload' */
+struct slist_node *slist_inline_find(struct slist_list *list, void *key,
+				     int (*cmp)(void *a, void *b));
+
+
+/* same as slist_node_remove, 'cmp' receiving each 'node' 'payload' */
+struct slist_node *slist_inline_remove(struct slist_list *list, void *key,
+				       int (*cmp)(void *a, void *b));
+
+
+/* same as slist_node_foreach, 'action' receiving each 'node' 'payload' */
+void slist_inline_foreach(struct slist_list *list,
+			  void *(*action)(void *carry, void *data, void *param),
+			  void *param);
+
+
+/****************************************************************************
+ * intrusive interface and _base_ documentation
+ *
+ * the intrusive functions mirror the ones above, but operate on
+ * 'struct slist_link' members embedded in user structures. they never
+ * allocate nor free memory, the user owns every element.
+ ****************************************************************************/
+
+/* returns 'list' initialized empty
+ * returns NULL if 'list' is NULL
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct slist_ilist *slist_ilist_init(struct slist_ilist *list);
+
+
+/* returns 'link' after adding it at 'list' head
+ * passing NULL in 'list' returns NULL
+ * passing NULL in 'link' returns NULL
+ *
+ * passing invalid ['list' or 'link']
+ * ------- results in undefined behavior
+ */
+struct slist_link *slist_link_push(struct slist_ilist *list,
+				   struct slist_link *link);
+
+
+/* returns 'link' after adding it at 'list' tail, in O(1)
+ * passing NULL in 'list' returns NULL
+ * passing NULL in 'link' returns NULL
+ *
+ * passing invalid ['list' or 'link']
+ * ------- results in undefined behavior
+ */
+struct slist_link *slist_link_append(struct slist_ilist *list,
+				     struct slist_link *link);
+
+
+/* removes 'list' head and returns it
+ * passing NULL in 'list' returns NULL
+ * passing an empty 'list' returns NULL
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct slist_link *slist_link_pop(struct slist_ilist *list);
+
+
+/* returns 'link' after unlinking it from 'list'
+ * returns NULL if 'link' is not contained in 'list'
+ * passing NULL in 'list' returns NULL
+ * passing NULL in 'link' returns NULL
+ *
+ * NOTE: a singly linked 'link' doesn't know its predecessor, so this
+ * ------- walks 'list' up to 'link'.
+ *
+ * passing invalid ['list' or 'link']
+ * ------- results in undefined behavior
+ */
+struct slist_link *slist_link_unlink(struct slist_ilist *list,
+				     struct slist_link *link);
+
+
+/* returns the 'link' matching 'key'
+ * returns NULL if 'key' is not found
+ * passing NULL in 'list' returns NULL
+ * passing an empty 'list' returns NULL
+ * passing NULL 'cmp' function returns NULL
+ *
+ * ABOUT 'key': handed untouched to 'cmp', NULL is allowed
+ * ABOUT 'cmp': function needs to return 0 when 'link' matches 'key'
+ *
+ * passing invalid ['list' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct slist_link *slist_link_find(struct slist_ilist *list, void *key,
+				   slist_link_cmp_func cmp);
+
+
+/* returns the 'link' matching 'key' removing it
+ * returns NULL if 'key' is not found
+ * passing NULL in 'list' returns NULL
+ * passing an empty 'list' returns NULL
+ * passing NULL 'cmp' function returns NULL
+ *
+ * ABOUT 'cmp': function needs to return 0 when 'link' matches 'key'
+ *
+ * passing invalid ['list' or 'cmp']
+ * ------- results in undefined behavior
+ */
+struct slist_link *slist_link_remove(struct slist_ilist *list, void *key,
+				     slist_link_cmp_func cmp);
+
+
+/* executes 'action' on each 'link' contained in 'list'
+ * returns without any action performed if 'list' is NULL
+ * returns without any action performed if 'list' is empty
+ * returns without any action performed if 'action' is NULL
+ *
+ * ABOUT 'action': same as slist_node_foreach, receiving the 'link'
+ * ------- instead of the 'data'. the next 'link' is read before calling
+ * ------- 'action', so the element may be recycled by it once popped.
+ *
+ * passing invalid ['list' or 'action' or 'param']
+ * ------- results in undefined behavior
+ */
+void slist_link_foreach(struct slist_ilist *list,
+			slist_link_action_func action, void *param);
+
+
+/* returns 'list' reversed
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'list' is empty
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct slist_ilist *slist_ilist_reverse(struct slist_ilist *list);
+
+
+/* returns 'list' after moving 's_list' into 'list' tail/end, in O(1)
+ * returns NULL if 'list' is NULL
+ * returns NULL if 's_list' is NULL
+ * returns NULL if 's_list' is empty
+ *
+ * ---info 's_list' becomes empty
+ *
+ * passing invalid ['list' or 's_list']
+ * ------- results in undefined behavior
+ */
+struct slist_ilist *slist_ilist_append(struct slist_ilist *list,
+				       struct slist_ilist *s_list);
+
+
+/* returns 'n_list' holding every 'link' of 'list' from 'key' onwards
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'list' is empty
+ * returns NULL if 'cmp' is NULL
+ * returns NULL if 'n_list' is NULL
+ * returns NULL if 'key' is not found
+ *
+ * ---info 'n_list' is overwritten, it is expected to be empty
+ * ---info makes 'list' empty if 'key' matches @ head
+ *
+ * ABOUT 'cmp': function needs to return 0 when 'link' matches 'key'
+ *
+ * passing invalid ['list' or 'cmp' or 'n_list']
+ * ------- results in undefined behavior
+ */
+struct slist_ilist *slist_ilist_split(struct slist_ilist *list, void *key,
+				      slist_link_cmp_func cmp,
+				      struct slist_ilist *n_list);
+
+
+/* returns 'n_list' holding every 'link' of 'list' from 'index' onwards
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'list' is empty
+ * returns NULL if 'index' is out of bounds
+ * returns NULL if 'n_list' is NULL
+ *
+ * ---info 'n_list' is overwritten, it is expected to be empty
+ * ---info makes 'list' empty if 'index' is 1/head
+ *
+ * ABOUT 'index': starts counting at 1
+ *
+ * passing invalid ['list' or 'n_list']
+ * ------- results in undefined behavior
+ */
+struct slist_ilist *slist_ilist_split_at(struct slist_ilist *list,
+					 const size_t index,
+					 struct slist_ilist *n_list);
+
 #endif
@@ -25,6 +25,114 @@
 #define LOUD
 #include "common.h"
 
+// intrusive element used by the slist_link tests
+struct item
+{
+	int key;
+	struct slist_link link;
+};
+
+int cmp_item(struct slist_link *link, void *key)
+{
+	return !( slist_container_of(link, struct item, link)->key == *(int*)key );
+}
+
+void *sum_item(void *carry, struct slist_link *link, void *param)
+{
+	*(int*)param += slist_container_of(link, struct item, link)->key;
+	return carry;
+}
+
+// counts the elements deleted through the list wide destructor
+static int dalloc_calls = 0;
+
+void count_dalloc(void *data)
+{
+	++dalloc_calls;
+	free(data);
+}
+
+// counts without freeing, for elements the test keeps
+static void *dalloc_last = NULL;
+
+void note_dalloc(void *data)
+{
+	++dalloc_calls;
+	dalloc_last = data;
+}
+
+void *sum_int(void *carry, void *data, void *param)
+{
+	*(int*)param += *(int*)data;
+	return carry;
+}
+
+//counts the batches, checking 'carry' is handed from one to the next
+static size_t batch_calls = 0;
+static size_t batch_last = 0;
+
+void *sum_batch(void *carry, void **data, size_t n, void *param)
+{
+	assert( (uintptr_t)carry == batch_calls );
+	for(size_t i = 0; i < n; ++i)
+		*(int*)param += *(int*)data[i];
+	++batch_calls;
+	batch_last = n;
+	return (void*)(uintptr_t)batch_calls;
+}
+
+int is_even(void *data)
+{
+	return 0 == *(int*)data % 2;
+}
+
+//checks the 'list' cursor is unset or sits where it claims to
+int cursor_ok(struct slist_list *list)
+{
+	struct slist_node *node = list->head;
+
+	if ( !list->cursor.node )
+		return 1;
+
+	for(size_t idx = 1; idx < list->cursor.index && node; ++idx)
+		node = node->next;
+
+	return node == list->cursor.node;
+}
+
+//orders by tens only, the units tell apart nodes sorting together
+int cmp3_tens(void *a, void *b)
+{
+	return *(int*)a / 10 - *(int*)b / 10;
+}
+
+//checks 'list' holds 'n' values of 'expect' and ends on its tail
+int list_is(struct slist_list *list, const int *expect, size_t n)
+{
+	struct slist_node *node = list->head;
+	struct slist_node *last = NULL;
+
+	if ( n != list->count )
+		return 0;
+
+	for(size_t idx = 0; idx < n; ++idx, last = node, node = node->next)
+		if ( !node || expect[idx] != *(int*)node->data )
+			return 0;
+
+	return NULL == node && last == list->tail;
+}
+
+//radix key helpers, the plain int and its tens
+uint64_t key_int(void *data)
+{
+	return (uint64_t)*(int*)data;
+}
+
+uint64_t key_tens(void *data)
+{
+	return (uint64_t)(*(int*)data / 10);
+}
+
 int main(int argc, char **argv)
 {
 
@@ -32,6 +140,7 @@ int main(int argc, char **argv)
 		wmsg("testing library interface\n");
 		struct slist_list list;
 		wmsg("slist_init");
+		assert( NULL == slist_init(NULL, NULL, NULL) );
 		assert( slist_init(&list, NULL, NULL) );
 		assert( 0 == list.count );
 		assert( SLIST_DEF_ALLOC == list.node_alloc );
@@ -53,6 +162,53 @@ int main(int argc, char **argv)
 		wmsg("[OK]\n");
 	}
 
+	{
+		wmsg("slist_init_allocator");
+		struct slist_list list;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		count_ctx_init(&allocator, &ctx);
+		assert( NULL == slist_init_allocator(NULL, &allocator) );
+		assert( slist_init_allocator(&list, &allocator) );
+		assert( 0 == list.count );
+		assert( NULL == list.head );
+		assert( &allocator == list.allocator );
+		//NULL allocator falls back to the defaults
+		assert( slist_init_allocator(&list, NULL) );
+		assert( NULL == list.allocator );
+		assert( SLIST_DEF_ALLOC == list.node_alloc );
+		assert( SLIST_DEF_DALLOC == list.node_dalloc );
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_list_new_allocator");
+		struct slist_list *list;
+		struct slist_node *node;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		count_ctx_init(&allocator, &ctx);
+		assert( (list = slist_list_new_allocator(&allocator)) );
+		slist_data_dalloc(list, int_dalloc);
+		assert( &allocator == list->allocator );
+		//the list itself does not go through the allocator
+		assert( 0 == ctx.allocs );
+		for(int i = 0; i < 40; ++i)
+		{
+			node = slist_node_new(list, int_copy(i), int_dalloc);
+			slist_node_push(list, node);
+		}
+		assert( 40 == ctx.allocs );
+		slist_node_delete(list, slist_node_pop(list));
+		assert( 1 == ctx.dallocs );
+		//deleting all nodes gives them back in bulk
+		assert( slist_list_delete_all_nodes(list) );
+		assert( 2 == ctx.bulk_dallocs );
+		assert( 1 == ctx.dallocs );
+		slist_list_delete(list);
+		wmsg("[OK]\n");
+	}
+
 	{
 		wmsg("slist_node_new");
 		struct slist_list *list;
@@ -64,9 +220,11 @@ int main(int argc, char **argv)
 		free(node);
 		assert( (node = slist_node_new(list, int_copy(10), int_dalloc)) );
 		assert( 10 == *(int*)node->data );
+#ifndef SLIST_COMPACT_NODE
 		assert( int_dalloc == node->data_dalloc );
+#endif
 		assert( !node->next );
-		assert( (node->data_dalloc(node->data), 1) );
+		int_dalloc(node->data);
 		free(node);
 		free(list);
 		wmsg("[OK]\n");
@@ -98,6 +256,7 @@ int main(int argc, char **argv)
 		struct slist_node *node;
 		//assume slist_list_new works
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		assert( (node = slist_node_new(list, int_copy(10), int_dalloc)) );
 		//assume slist_node_new works
 		slist_node_delete(list, node);
@@ -121,6 +280,7 @@ int main(int argc, char **argv)
 		struct slist_node *node;
 		//assume slist_list_new works
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//assume slist_node_new + int_copy works
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		//test failures
@@ -146,6 +306,7 @@ int main(int argc, char **argv)
 		struct slist_node *node;
 		//assume slist_list_new works
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//assume slist_node_new + int_copy works
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		//test failures
@@ -177,6 +338,7 @@ int main(int argc, char **argv)
 		struct slist_node *node;
 		//assume slist_list_new works
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//assume slist_node_new + int_copy works
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		//test failures
@@ -201,6 +363,7 @@ int main(int argc, char **argv)
 		void *key;
 		//assume slist_list_new works
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//asume slist_node_new + int_copy works
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		key = int_copy(10);
@@ -268,6 +431,7 @@ int main(int argc, char **argv)
 		void *key;
 		//assume slist_list_new works
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//assume slist_node_new + int_copy works
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		key = int_copy(10);
@@ -328,6 +492,7 @@ int main(int argc, char **argv)
 		void *key;
 		//assume slist_list_new works
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//assume slist_node_new + int_copy works
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		key = int_copy(10);
@@ -398,6 +563,7 @@ int main(int argc, char **argv)
 		struct slist_node *node;
 		//assume slist_list_new works
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//assume slist_node_new + int_copy works
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		//test failures
@@ -462,6 +628,7 @@ int main(int argc, char **argv)
 		struct slist_list *list;
 		struct slist_node *node;
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//create some nodes to test
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		slist_node_push(list,node);
@@ -495,6 +662,7 @@ int main(int argc, char **argv)
 		struct slist_list *list;
 		struct slist_node *node;
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//test failures
 		assert( NULL == slist_list_delete_all_nodes(NULL) );
 		//test empty
@@ -516,11 +684,52 @@ int main(int argc, char **argv)
 		wmsg("[OK]\n");
 	}
 
+	{
+		wmsg("slist_list_reset");
+		struct slist_list *list;
+		struct slist_node *node;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		int keep = 7;
+		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == slist_list_reset(NULL, 0) );
+		//test empty
+		assert( list == slist_list_reset(list, 0) );
+		node = slist_node_new(list, int_copy(10), int_dalloc);
+		slist_node_push(list, node);
+		node = slist_node_new(list, int_copy(9), int_dalloc);
+		slist_node_push(list, node);
+		assert( list == slist_list_reset(list, 0) );
+		assert( NULL == list->head );
+		assert( 0 == list->count );
+		//owned data is left alone
+		node = slist_node_new(list, &keep, int_dalloc);
+		slist_node_push(list, node);
+		assert( list == slist_list_reset(list, 1) );
+		assert( 7 == keep );
+		slist_list_delete(list);
+		//without an arena nodes still go through the cache and bulk_dalloc
+		count_ctx_init(&allocator, &ctx);
+		list = slist_list_new_allocator(&allocator);
+		slist_cache_limit(list, 2);
+		for(int i = 0; i < 10; ++i)
+			slist_node_push(list, slist_node_new(list, &keep, NULL));
+		assert( list == slist_list_reset(list, 1) );
+		assert( 7 == keep );
+		assert( 2 == list->cache_count );
+		assert( 1 == ctx.bulk_dallocs && 0 == ctx.dallocs );
+		slist_list_delete(list);
+		wmsg("[OK]\n");
+	}
+
 	{
 		wmsg("slist_list_reverse");
 		struct slist_list *list;
 		struct slist_node *node;
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//test failures
 		assert( NULL == slist_list_reverse(NULL) );
 		//test empty
@@ -547,6 +756,7 @@ int main(int argc, char **argv)
 		struct slist_list *list;
 		struct slist_node *node;
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		node = slist_node_new(list, int_copy(10), int_dalloc);
 		slist_node_push(list, node);
 		assert( 1 == list->count && 1 == slist_get_size(list) );
@@ -562,7 +772,9 @@ int main(int argc, char **argv)
 		struct slist_list *s_list;
 		struct slist_node *node;
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		s_list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(s_list, int_dalloc);
 		//test failures
 		assert( NULL == slist_list_push(NULL, NULL) );
 		assert( NULL == slist_list_push(list, NULL) );
@@ -607,7 +819,9 @@ int main(int argc, char **argv)
 		struct slist_list *s_list;
 		struct slist_node *node;
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		s_list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(s_list, int_dalloc);
 		//test failures
 		assert( NULL == slist_list_append(NULL, NULL) );
 		assert( NULL == slist_list_append(list, NULL) );
@@ -653,6 +867,7 @@ int main(int argc, char **argv)
 		struct slist_node *node;
 		void *key;
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		key = int_copy(6);
 		//test failures
 		assert( NULL == slist_list_split(NULL, NULL, NULL) );
@@ -728,6 +943,7 @@ int main(int argc, char **argv)
 		struct slist_list *n_list;
 		struct slist_node *node;
 		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
 		//test failures
 		assert( NULL == slist_list_split_at(NULL, 1) );
 		//test empty
@@ -794,5 +1010,740 @@ int main(int argc, char **argv)
 	}
 
 
+	{
+		wmsg("slist_link push/append/pop/unlink");
+		struct slist_ilist list;
+		struct item items[4];
+		for(int i = 0; i < 4; ++i)
+			items[i].key = i;
+		assert( NULL == slist_ilist_init(NULL) );
+		assert( &list == slist_ilist_init(&list) );
+		//test failures
+		assert( NULL == slist_link_push(NULL, &items[0].link) );
+		assert( NULL == slist_link_append(&list, NULL) );
+		assert( NULL == slist_link_pop(&list) );
+		//build 1, 0, 2, 3
+		slist_link_push(&list, &items[0].link);
+		assert( list.head == list.tail );
+		slist_link_push(&list, &items[1].link);
+		slist_link_append(&list, &items[2].link);
+		slist_link_append(&list, &items[3].link);
+		assert( 4 == list.count );
+		assert( 1 == slist_container_of(list.head, struct item, link)->key );
+		assert( 3 == slist_container_of(list.tail, struct item, link)->key );
+		//unlink the tail and a missing link
+		assert( &items[3].link == slist_link_unlink(&list, &items[3].link) );
+		assert( NULL == slist_link_unlink(&list, &items[3].link) );
+		assert( list.tail == &items[2].link );
+		assert( &items[1].link == slist_link_pop(&list) );
+		assert( &items[0].link == slist_link_pop(&list) );
+		assert( &items[2].link == slist_link_pop(&list) );
+		assert( 0 == list.count );
+		assert( NULL == list.head && NULL == list.tail );
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_link find/remove/foreach");
+		struct slist_ilist list;
+		struct item items[4];
+		int key = 3;
+		int sum = 0;
+		slist_ilist_init(&list);
+		for(int i = 0; i < 4; ++i)
+		{
+			items[i].key = i;
+			slist_link_append(&list, &items[i].link);
+		}
+		assert( NULL == slist_link_find(&list, &key, NULL) );
+		assert( &items[3].link == slist_link_find(&list, &key, cmp_item) );
+		//removing the tail moves it back
+		assert( &items[3].link == slist_link_remove(&list, &key, cmp_item) );
+		assert( list.tail == &items[2].link );
+		assert( NULL == slist_link_remove(&list, &key, cmp_item) );
+		assert( 3 == list.count );
+		slist_link_foreach(&list, sum_item, &sum);
+		assert( 3 == sum );
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_ilist reverse/append/split");
+		struct slist_ilist list;
+		struct slist_ilist n_list;
+		struct item items[6];
+		int key = 4;
+		slist_ilist_init(&list);
+		slist_ilist_init(&n_list);
+		for(int i = 0; i < 6; ++i)
+		{
+			items[i].key = i;
+			slist_link_append(&list, &items[i].link);
+		}
+		assert( NULL == slist_ilist_reverse(NULL) );
+		assert( &list == slist_ilist_reverse(&list) );
+		assert( 5 == slist_container_of(list.head, struct item, link)->key );
+		assert( 0 == slist_container_of(list.tail, struct item, link)->key );
+		slist_ilist_reverse(&list);
+		//split at key 4 -> list 0..3, n_list 4..5
+		assert( NULL == slist_ilist_split(&list, &key, cmp_item, NULL) );
+		assert( &n_list == slist_ilist_split(&list, &key, cmp_item, &n_list) );
+		assert( 4 == list.count && 2 == n_list.count );
+		assert( list.tail == &items[3].link && NULL == list.tail->next );
+		assert( n_list.tail == &items[5].link );
+		//append it back
+		assert( &list == slist_ilist_append(&list, &n_list) );
+		assert( 6 == list.count && 0 == n_list.count );
+		assert( items[3].link.next == &items[4].link );
+		//split_at, bounds and head
+		assert( NULL == slist_ilist_split_at(&list, 0, &n_list) );
+		assert( NULL == slist_ilist_split_at(&list, 7, &n_list) );
+		assert( &n_list == slist_ilist_split_at(&list, 5, &n_list) );
+		assert( 4 == list.count && 2 == n_list.count );
+		assert( n_list.head == &items[4].link );
+		slist_ilist_append(&list, &n_list);
+		assert( &n_list == slist_ilist_split_at(&list, 1, &n_list) );
+		assert( 0 == list.count && NULL == list.head && NULL == list.tail );
+		assert( 6 == n_list.count && n_list.tail == &items[5].link );
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_node_new_inline");
+		struct slist_list *list;
+		int value = 10;
+		list = slist_list_new(NULL, NULL);
+#ifdef SLIST_COMPACT_NODE
+		//compact nodes have no room to mark inline ones
+		assert( NULL == slist_node_new_inline(list, &value, sizeof( int )) );
+#else
+		struct slist_node *node;
+		//test failures
+		assert( NULL == slist_node_new_inline(list, &value, 0) );
+		assert( NULL == slist_node_new_inline(list, &value, SLIST_INLINE_MAX + 1) );
+		assert( (node = slist_node_new_inline(list, &value, sizeof( int ))) );
+		//the payload is a copy living in the node
+		value = 11;
+		assert( 10 == *(int*)slist_node_inline_data(node) );
+		assert( node->data == slist_node_inline_data(node) );
+		//the mark, never called
+		assert( NULL != node->data_dalloc );
+		slist_node_push(list, node);
+		slist_list_delete_all_nodes(list);
+#endif
+		slist_list_delete(list);
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_node with data right past it");
+		struct slist_list *list;
+		struct slist_node *node;
+		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, note_dalloc);
+		slist_cache_limit(list, 1);
+		//where the payload would be, not an inline node for that
+		node = slist_node_new(list, NULL, note_dalloc);
+		node->data = node->payload;
+		slist_node_push(list, node);
+		dalloc_calls = 0;
+		slist_node_delete(list, slist_node_pop(list));
+		assert( 1 == dalloc_calls );
+		assert( dalloc_last == (void *)node->payload );
+		assert( node == list->cache );
+		slist_list_delete(list);
+		wmsg("[OK]\n");
+	}
+
+#ifndef SLIST_COMPACT_NODE
+	{
+		wmsg("slist_inline find/remove/foreach");
+		struct slist_list *list;
+		struct slist_node *node;
+		int key = 2;
+		int sum = 0;
+		list = slist_list_new(NULL, NULL);
+		for(int i = 4; 0 < i; --i)
+		{
+			node = slist_node_new_inline(list, &i, sizeof( int ));
+			slist_node_push(list, node);
+		}
+		assert( NULL == slist_inline_find(list, &key, NULL) );
+		assert( (node = slist_inline_find(list, &key, cmp_int)) );
+		assert( 2 == *(int*)node->payload );
+		slist_inline_foreach(list, sum_int, &sum);
+		assert( 10 == sum );
+		//remove @ head and middle
+		key = 1;
+		assert( (node = slist_inline_remove(list, &key, cmp_int)) );
+		slist_node_delete(list, node);
+		assert( 2 == *(int*)list->head->payload );
+		key = 3;
+		assert( (node = slist_inline_remove(list, &key, cmp_int)) );
+		slist_node_delete(list, node);
+		assert( 4 == *(int*)list->head->next->payload );
+		assert( NULL == slist_inline_remove(list, &key, cmp_int) );
+		assert( 2 == list->count );
+		slist_list_delete_all_nodes(list);
+		slist_list_delete(list);
+		wmsg("[OK]\n");
+	}
+#endif
+
+	{
+		wmsg("slist_cache_limit/trim");
+
+		struct slist_list *list;
+		struct slist_node *node;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		count_ctx_init(&allocator, &ctx);
+		list = slist_list_new_allocator(&allocator);
+		slist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == slist_cache_limit(NULL, 4) );
+		assert( 0 == slist_cache_trim(NULL, 0) );
+		assert( list == slist_cache_limit(list, 4) );
+		assert( 4 == list->cache_max );
+		//warm up the cache
+		for(int i = 0; i < 4; ++i)
+		{
+			node = slist_node_new(list, int_copy(i), int_dalloc);
+			slist_node_push(list, node);
+		}
+		while ( list->head )
+			slist_node_delete(list, slist_node_pop(list));
+		assert( 4 == ctx.allocs );
+		assert( 0 == ctx.dallocs );
+		assert( 4 == list->cache_count );
+		//steady state queue traffic makes no allocator calls
+		for(int i = 0; i < 1000; ++i)
+		{
+			node = slist_node_new(list, int_copy(i), int_dalloc);
+			slist_node_push(list, node);
+			slist_node_delete(list, slist_node_pop(list));
+		}
+		assert( 4 == ctx.allocs );
+		assert( 0 == ctx.dallocs );
+#ifndef SLIST_COMPACT_NODE
+		//inline nodes bypass the cache
+		node = slist_node_new_inline(list, &ctx, sizeof( int ));
+		slist_node_delete(list, node);
+		assert( 5 == ctx.allocs && 1 == ctx.dallocs );
+#endif
+		//bounding the cache frees the extra nodes
+		slist_cache_limit(list, 1);
+		assert( 1 == list->cache_count );
+		assert( ctx.allocs - 1 == ctx.dallocs );
+		assert( 1 == slist_cache_trim(list, 0) );
+		assert( NULL == list->cache );
+		slist_cache_limit(list, 2);
+		node = slist_node_new(list, NULL, NULL);
+		slist_node_delete(list, node);
+		//the list takes its cache with it
+		slist_list_delete(list);
+		assert( ctx.allocs == ctx.dallocs );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_data_dalloc");
+
+		struct slist_list *list;
+		struct slist_list *n_list;
+#ifndef SLIST_COMPACT_NODE
+		int value = 1;
+#endif
+		list = slist_list_new(NULL, NULL);
+		//test failures
+		assert( NULL == slist_data_dalloc(NULL, count_dalloc) );
+		assert( NULL == list->data_dalloc );
+		assert( list == slist_data_dalloc(list, count_dalloc) );
+#ifndef SLIST_COMPACT_NODE
+		//inline nodes are left alone
+		slist_node_push(list, slist_node_new_inline(list, &value, sizeof( int )));
+#endif
+		//nodes carry no destructor of their own
+		for(int i = 0; i < 6; ++i)
+			slist_node_push(list, slist_node_new(list, int_copy(i), NULL));
+		//the split off list takes the destructor along
+		assert( (n_list = slist_list_split_at(list, 4)) );
+		assert( count_dalloc == n_list->data_dalloc );
+		dalloc_calls = 0;
+		slist_node_delete(list, slist_node_pop(list));
+		assert( 1 == dalloc_calls );
+		slist_list_delete_all_nodes(list);
+		assert( 3 == dalloc_calls );
+		slist_list_delete(list);
+		slist_list_delete_all_nodes(n_list);
+		assert( 6 == dalloc_calls );
+		slist_list_delete(n_list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_get_stats");
+
+		struct slist_list *list;
+		struct slist_list *n_list;
+		struct slist_stats stats;
+		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( 0 == slist_get_stats(NULL, &stats) );
+		assert( 0 == slist_get_stats(list, NULL) );
+		for(int i = 0; i < 10; ++i)
+			slist_node_push(list, slist_node_new(list, int_copy(9 - i), NULL));
+		//the split off nodes take their count along
+		assert( (n_list = slist_list_split_at(list, 7)) );
+		assert( 6 == list->count && 4 == n_list->count );
+		slist_node_delete(list, slist_node_pop(list));
+		slist_list_delete_all_nodes(n_list);
+#ifdef SLIST_STATS
+		assert( 1 == slist_get_stats(list, &stats) );
+		assert( 10 == stats.allocs );
+		assert( 1 == stats.dallocs );
+		assert( 5 == stats.live );
+		assert( 10 == stats.peak );
+		assert( 10 * sizeof( struct slist_node) == stats.bytes );
+		assert( 1 == stats.data_dallocs );
+		assert( 1 == slist_get_stats(n_list, &stats) );
+		assert( 0 == stats.allocs );
+		assert( 4 == stats.dallocs && 4 == stats.data_dallocs );
+		assert( 0 == stats.live && 4 == stats.peak );
+#else
+		assert( 0 == slist_get_stats(list, &stats) );
+#endif
+		slist_list_delete(n_list);
+		slist_list_delete_all_nodes(list);
+		slist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+
+	{
+		wmsg("slist tail");
+
+		struct slist_list *list;
+		struct slist_list *s_list;
+		struct slist_list *n_list;
+		struct slist_node *node;
+		int key;
+		list = slist_list_new(NULL, NULL);
+		s_list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		slist_data_dalloc(s_list, int_dalloc);
+		assert( NULL == list->tail );
+		//push sets the tail on an empty list only
+		node = slist_node_new(list, int_copy(1), NULL);
+		slist_node_push(list, node);
+		assert( node == list->tail );
+		slist_node_push(list, slist_node_new(list, int_copy(0), NULL));
+		assert( node == list->tail );
+		//append returns the node it added
+		node = slist_node_new(list, int_copy(2), NULL);
+		assert( node == slist_node_append(list, node) );
+		assert( node == list->tail && NULL == node->next );
+		//list: 0, 1, 2
+		for(int i = 3; i < 6; ++i)
+			slist_node_append(s_list, slist_node_new(s_list, int_copy(i), NULL));
+		//list push/append link through the tails
+		assert( list == slist_list_append(list, s_list) );
+		assert( NULL == s_list->head && NULL == s_list->tail );
+		assert( 5 == *(int*)list->tail->data );
+		slist_node_append(s_list, slist_node_new(s_list, int_copy(-1), NULL));
+		assert( list == slist_list_push(list, s_list) );
+		assert( 5 == *(int*)list->tail->data );
+		assert( -1 == *(int*)list->head->data );
+		//list: -1, 0, 1, 2, 3, 4, 5 - removals at the tail move it back
+		key = 5;
+		slist_node_delete(list, slist_node_remove(list, &key, cmp_int));
+		assert( 4 == *(int*)list->tail->data );
+		slist_node_delete(list, slist_node_remove_at(list, list->count));
+		assert( 3 == *(int*)list->tail->data );
+		//list: -1, 0, 1, 2, 3
+		assert( (n_list = slist_list_split_at(list, 3)) );
+		assert( 0 == *(int*)list->tail->data );
+		assert( 3 == *(int*)n_list->tail->data );
+		key = 2;
+		//s_list was left empty by the push
+		slist_list_delete(s_list);
+		assert( (s_list = slist_list_split(n_list, &key, cmp_int)) );
+		assert( 1 == *(int*)n_list->tail->data );
+		assert( 3 == *(int*)s_list->tail->data );
+		//reverse swaps the ends
+		slist_list_reverse(s_list);
+		assert( 2 == *(int*)s_list->tail->data );
+		assert( NULL == s_list->tail->next );
+		//popping the last node clears it
+		slist_node_delete(n_list, slist_node_pop(n_list));
+		assert( NULL == n_list->head && NULL == n_list->tail );
+		//and so does emptying a list
+		slist_list_delete_all_nodes(list);
+		assert( NULL == list->tail );
+		slist_list_delete_all_nodes(s_list);
+		assert( NULL == s_list->tail );
+		slist_list_delete(n_list);
+		slist_list_delete(s_list);
+		slist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist cursor/get_at");
+
+		struct slist_list *list;
+		struct slist_list *n_list;
+		struct slist_node *node;
+		size_t moved;
+		int key;
+		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == slist_node_get_at(NULL, 1) );
+		assert( NULL == slist_node_get_at(list, 1) );
+		assert( NULL == list->cursor.node );
+		for(int i = 0; i < 100; ++i)
+			slist_node_append(list, slist_node_new(list, int_copy(i), NULL));
+		assert( NULL == slist_node_get_at(list, 0) );
+		assert( NULL == slist_node_get_at(list, 101) );
+		assert( 99 == *(int*)slist_node_get_at(list, 100)->data );
+		//lookups leave it on the node found
+		for(size_t idx = 1; idx <= 100; ++idx)
+		{
+			node = slist_node_get_at(list, idx);
+			assert( (int)idx - 1 == *(int*)node->data );
+			assert( node == list->cursor.node && idx == list->cursor.index );
+		}
+		//removing scans from it: 50, 51, 52 go, the cursor stays on 49
+		slist_node_get_at(list, 40);
+		for(int i = 0; i < 3; ++i)
+		{
+			node = slist_node_remove_at(list, 51);
+			assert( 50 + i == *(int*)node->data );
+			slist_node_delete(list, node);
+			assert( 49 == *(int*)list->cursor.node->data );
+			assert( 50 == list->cursor.index );
+		}
+		//every mutation keeps it right
+		slist_node_push(list, slist_node_new(list, int_copy(-1), NULL));
+		assert( 51 == list->cursor.index && cursor_ok(list) );
+		slist_node_delete(list, slist_node_pop(list));
+		slist_node_delete(list, slist_node_pop(list));
+		assert( 49 == list->cursor.index && cursor_ok(list) );
+		key = 10;
+		slist_node_delete(list, slist_node_remove(list, &key, cmp_int));
+		assert( 48 == list->cursor.index && cursor_ok(list) );
+		key = 49;
+		slist_node_delete(list, slist_node_remove(list, &key, cmp_int));
+		assert( 48 == *(int*)list->cursor.node->data && cursor_ok(list) );
+		slist_list_reverse(list);
+		assert( cursor_ok(list) );
+		slist_list_reverse(list);
+		//split before it hands it to the new list
+		slist_node_get_at(list, 30);
+		assert( (n_list = slist_list_split_at(list, 20)) );
+		assert( 11 == n_list->cursor.index && cursor_ok(n_list) );
+		assert( 19 == list->cursor.index && cursor_ok(list) );
+		moved = n_list->count;
+		assert( list == slist_list_push(list, n_list) );
+		assert( NULL == n_list->cursor.node );
+		assert( 19 + moved == list->cursor.index );
+		assert( cursor_ok(list) );
+		slist_list_delete_all_nodes(list);
+		assert( NULL == list->cursor.node );
+		slist_list_delete(n_list);
+		slist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist sorted insert/find/bounds/merge");
+
+		struct slist_list *list;
+		struct slist_list *s_list;
+		struct slist_node *node;
+		int expect[200];
+		int key = 0;
+		list = slist_list_new(NULL, NULL);
+		s_list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		slist_data_dalloc(s_list, int_dalloc);
+		node = slist_node_new(list, int_copy(0), NULL);
+		//test failures
+		assert( NULL == slist_node_insert_sorted(NULL, node, cmp3_int) );
+		assert( NULL == slist_node_insert_sorted(list, NULL, cmp3_int) );
+		assert( NULL == slist_node_insert_sorted(list, node, NULL) );
+		assert( NULL == slist_node_find_sorted(list, &key, cmp3_int) );
+		assert( NULL == slist_node_lower_bound(list, &key, cmp3_int) );
+		assert( NULL == slist_node_upper_bound(list, &key, cmp3_int) );
+		assert( NULL == slist_list_merge_sorted(list, s_list, cmp3_int) );
+		slist_node_delete(list, node);
+		//equal keys keep insertion order, the cursor follows every insert
+		for(int units = 0; units < 10; ++units)
+			for(int i = 0; i < 10; ++i)
+			{
+				key = (i * 7 % 10) * 10 + units;
+				node = slist_node_new(list, int_copy(key), NULL);
+				assert( node == slist_node_insert_sorted(list, node, cmp3_tens) );
+				assert( cursor_ok(list) );
+			}
+		for(int i = 0; i < 200; ++i)
+			expect[i] = i;
+		assert( list_is(list, expect, 100) );
+		//find and bounds
+		key = 55;
+		assert( 55 == *(int*)slist_node_find_sorted(list, &key, cmp3_int)->data );
+		assert( 56 == list->cursor.index && cursor_ok(list) );
+		key = 100;
+		assert( NULL == slist_node_find_sorted(list, &key, cmp3_int) );
+		key = -1;
+		assert( NULL == slist_node_find_sorted(list, &key, cmp3_int) );
+		key = 42;
+		assert( 40 == *(int*)slist_node_lower_bound(list, &key, cmp3_tens)->data );
+		assert( 41 == list->cursor.index && cursor_ok(list) );
+		assert( 50 == *(int*)slist_node_upper_bound(list, &key, cmp3_tens)->data );
+		assert( 51 == list->cursor.index && cursor_ok(list) );
+		key = 12;
+		assert( 10 == *(int*)slist_node_lower_bound(list, &key, cmp3_tens)->data );
+		key = 99;
+		assert( list->tail == slist_node_lower_bound(list, &key, cmp3_int) );
+		assert( NULL == slist_node_upper_bound(list, &key, cmp3_int) );
+		//merge the odd numbers into the even ones
+		slist_list_delete_all_nodes(list);
+		for(int i = 0; i < 200; ++i)
+		{
+			if ( i % 2 )
+				slist_node_append(s_list, slist_node_new(s_list, int_copy(i), NULL));
+			else
+				slist_node_append(list, slist_node_new(list, int_copy(i), NULL));
+		}
+		assert( NULL == slist_list_merge_sorted(list, NULL, cmp3_int) );
+		assert( NULL == slist_list_merge_sorted(list, s_list, NULL) );
+		assert( list == slist_list_merge_sorted(list, s_list, cmp3_int) );
+		assert( 0 == s_list->count && NULL == s_list->head && NULL == s_list->tail );
+		assert( list_is(list, expect, 200) );
+		//on ties the nodes already in 'list' go first
+		node = slist_node_append(s_list, slist_node_new(s_list, int_copy(199), NULL));
+		slist_node_push(s_list, slist_node_new(s_list, int_copy(-1), NULL));
+		assert( list == slist_list_merge_sorted(list, s_list, cmp3_int) );
+		assert( node == list->tail && node != slist_node_get_at(list, 201) );
+		assert( -1 == *(int*)list->head->data && 202 == list->count );
+		slist_list_delete_all_nodes(list);
+		slist_list_delete(list);
+		slist_list_delete(s_list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_list_sort");
+
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		struct slist_list *list;
+		int expect[1000];
+		int n = 0;
+		count_ctx_init(&allocator, &ctx);
+		list = slist_list_new_allocator(&allocator);
+		slist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == slist_list_sort(NULL, cmp3_int) );
+		assert( NULL == slist_list_sort(list, cmp3_int) );
+		slist_node_append(list, slist_node_new(list, int_copy(0), NULL));
+		assert( NULL == slist_list_sort(list, NULL) );
+		//every length up to a few runs, against a sorted array
+		for(int len = 1; len <= 40; ++len)
+		{
+			slist_list_delete_all_nodes(list);
+			for(int i = 0; i < len; ++i)
+			{
+				expect[i] = i;
+				slist_node_push(list, slist_node_new(list, int_copy(i), NULL));
+			}
+			assert( list == slist_list_sort(list, cmp3_int) );
+			assert( list_is(list, expect, len) );
+		}
+		//stable: by tens, the units keep the order they had
+		slist_list_delete_all_nodes(list);
+		for(int tens = 0; tens < 100; ++tens)
+			for(int units = 0; units < 10; ++units)
+				expect[n++] = tens * 10 + units;
+		for(int i = 0; i < 1000; ++i)
+			slist_node_append(list, slist_node_new(list,
+				int_copy((i * 7 % 100) * 10 + i / 100), NULL));
+		ctx.allocs = 0;
+		assert( list == slist_list_sort(list, cmp3_tens) );
+		assert( 0 == ctx.allocs );
+		assert( list_is(list, expect, 1000) );
+		slist_list_delete_all_nodes(list);
+		slist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_list_radix_sort");
+
+		struct slist_list *list;
+		int expect[1000];
+		int n = 0;
+		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		//test failures
+		assert( NULL == slist_list_radix_sort(NULL, key_int, 4) );
+		assert( NULL == slist_list_radix_sort(list, key_int, 4) );
+		slist_node_append(list, slist_node_new(list, int_copy(0), NULL));
+		assert( NULL == slist_list_radix_sort(list, NULL, 4) );
+		assert( NULL == slist_list_radix_sort(list, key_int, 0) );
+		assert( NULL == slist_list_radix_sort(list, key_int, 9) );
+		assert( list == slist_list_radix_sort(list, key_int, 8) );
+		slist_list_delete_all_nodes(list);
+		//stable: by tens, the units keep the order they had
+		for(int tens = 0; tens < 100; ++tens)
+			for(int units = 0; units < 10; ++units)
+				expect[n++] = tens * 10 + units;
+		for(int i = 0; i < 1000; ++i)
+			slist_node_append(list, slist_node_new(list,
+				int_copy((i * 7 % 100) * 10 + i / 100), NULL));
+		assert( list == slist_list_radix_sort(list, key_tens, 1) );
+		assert( list_is(list, expect, 1000) );
+		slist_list_delete_all_nodes(list);
+		//keys over several bytes, a constant one in the middle skipped
+		for(int i = 0; i < 1000; ++i)
+			expect[i] = 0x30000 + i % 256 + (i / 256) * 0x1000000;
+		for(int i = 0; i < 1000; ++i)
+			slist_node_push(list, slist_node_new(list, int_copy(expect[i * 7 % 1000]), NULL));
+		assert( list == slist_list_radix_sort(list, key_int, 4) );
+		assert( list_is(list, expect, 1000) );
+		//only the low byte taken, the rest stays in order
+		assert( list == slist_list_radix_sort(list, key_int, 1) );
+		assert( 0x30000 == *(int*)list->head->data );
+		assert( 0x30000 + 0x1000000 == *(int*)slist_node_get_at(list, 2)->data );
+		slist_list_delete_all_nodes(list);
+		slist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_list_merge_k");
+
+		struct slist_list *list;
+		struct slist_list *lists[40];
+		int expect[1000];
+		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		for(int i = 0; i < 40; ++i)
+			lists[i] = slist_list_new(NULL, NULL);
+		//test failures
+		assert( NULL == slist_list_merge_k(NULL, lists, 40, cmp3_int) );
+		assert( NULL == slist_list_merge_k(list, NULL, 40, cmp3_int) );
+		assert( NULL == slist_list_merge_k(list, lists, 40, NULL) );
+		//nothing to merge
+		assert( list == slist_list_merge_k(list, lists, 0, cmp3_int) );
+		assert( list == slist_list_merge_k(list, lists, 40, cmp3_int) );
+		assert( 0 == list->count && NULL == list->head && NULL == list->tail );
+		//the units tell the inputs apart: 0 in 'list', the rest in 'lists'
+		for(int i = 0; i < 1000; ++i)
+		{
+			expect[i] = i;
+			if ( 0 == i % 10 )
+				slist_node_append(list, slist_node_new(list, int_copy(i), NULL));
+			else
+				slist_node_append(lists[i % 10 - 1],
+					slist_node_new(lists[i % 10 - 1], int_copy(i), NULL));
+		}
+		slist_list_delete(lists[9]);
+		lists[9] = NULL;
+		//equal tens, so ties are settled by where each node came from
+		assert( list == slist_list_merge_k(list, lists, 40, cmp3_tens) );
+		assert( list_is(list, expect, 1000) );
+		for(int i = 0; i < 40; ++i)
+			assert( 9 == i || (0 == lists[i]->count && NULL == lists[i]->head
+					   && NULL == lists[i]->tail) );
+		//and with a single input left it is linked as it is
+		slist_node_append(lists[0], slist_node_new(lists[0], int_copy(1000), NULL));
+		slist_node_append(lists[0], slist_node_new(lists[0], int_copy(1001), NULL));
+		assert( list == slist_list_merge_k(list, lists, 1, cmp3_int) );
+		assert( 1002 == list->count && 1001 == *(int*)list->tail->data );
+		slist_list_delete_all_nodes(list);
+		slist_list_delete(list);
+		for(int i = 0; i < 40; ++i)
+			slist_list_delete(lists[i]);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_filter_inplace");
+
+		struct slist_list *list;
+		struct dutils_allocator allocator;
+		struct count_ctx ctx;
+		int expect[50];
+		count_ctx_init(&allocator, &ctx);
+		list = slist_list_new_allocator(&allocator);
+		slist_data_dalloc(list, count_dalloc);
+		//test failures
+		assert( NULL == slist_filter_inplace(NULL, is_even) );
+		assert( NULL == slist_filter_inplace(list, is_even) );
+		//odd at both ends, so head and tail both move
+		for(int i = 1; i <= 101; ++i)
+			slist_node_append(list, slist_node_new(list, int_copy(i), NULL));
+		assert( NULL == slist_filter_inplace(list, NULL) );
+		slist_node_get_at(list, 61);
+		dalloc_calls = 0;
+		assert( 101 == ctx.allocs );
+		assert( list == slist_filter_inplace(list, is_even) );
+		assert( 101 == ctx.allocs );
+		assert( 51 == dalloc_calls && 51 == ctx.dallocs );
+		for(int i = 0; i < 50; ++i)
+			expect[i] = (i + 1) * 2;
+		assert( list_is(list, expect, 50) );
+		assert( cursor_ok(list) );
+		assert( 60 == *(int*)list->cursor.node->data );
+		//rejecting everything leaves it empty
+		for(struct slist_node *node = list->head; node; node = node->next)
+			++*(int*)node->data;
+		assert( list == slist_filter_inplace(list, is_even) );
+		assert( 101 == dalloc_calls );
+		assert( 0 == list->count && NULL == list->head && NULL == list->tail );
+		assert( NULL == list->cursor.node );
+		slist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("slist_node_foreach_batch");
+
+		struct slist_list *list;
+		int sum = 0;
+		list = slist_list_new(NULL, NULL);
+		slist_data_dalloc(list, int_dalloc);
+		//test failures
+		batch_calls = 0;
+		slist_node_foreach_batch(NULL, sum_batch, &sum);
+		slist_node_foreach_batch(list, sum_batch, &sum);
+		for(int i = 0; i < 2 * SLIST_BATCH_SIZE + 3; ++i)
+			slist_node_append(list, slist_node_new(list, int_copy(i), NULL));
+		slist_node_foreach_batch(list, NULL, &sum);
+		assert( 0 == batch_calls && 0 == sum );
+		//full batches, the remainder in the last one
+		slist_node_foreach_batch(list, sum_batch, &sum);
+		assert( 3 == batch_calls && 3 == batch_last );
+		assert( (2 * SLIST_BATCH_SIZE + 3) * (2 * SLIST_BATCH_SIZE + 2) / 2 == sum );
+		slist_list_delete_all_nodes(list);
+		slist_list_delete(list);
+
+		wmsg("[OK]\n");
+	}
+
 	return 0;
 }
@@ -0,0 +1,626 @@
+/*
+ * ulist.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include <string.h>
+
+#include "ulist.h"
+
+/****************************************************************************
+ * internal helpers
+ ****************************************************************************/
+
+static struct ulist_node *ulist_node_new(struct ulist_list *list)
+{
+	struct ulist_node *node = NULL;
+
+	if ( NULL == (node = list->node_alloc( sizeof( struct ulist_node))) ) {
+		//FIXME: add support for custom error loggin and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	node->next = NULL;
+	node->prev = NULL;
+	node->count = 0;
+
+	return node;
+}/* ulist_node_new */
+
+
+//links 'node' after 'prev', at the head when 'prev' is NULL
+static void ulist_node_link(struct ulist_list *list, struct ulist_node *prev,
+			    struct ulist_node *node)
+{
+	node->prev = prev;
+	node->next = (prev ? prev->next : list->head);
+
+	if ( node->next )
+		node->next->prev = node;
+	else
+		list->tail = node;
+
+	if ( prev )
+		prev->next = node;
+	else
+		list->head = node;
+}/* ulist_node_link */
+
+
+//unlinks and frees 'node'
+static void ulist_node_free(struct ulist_list *list, struct ulist_node *node)
+{
+	if ( node->prev )
+		node->prev->next = node->next;
+	else
+		list->head = node->next;
+
+	if ( node->next )
+		node->next->prev = node->prev;
+	else
+		list->tail = node->prev;
+
+	list->node_dalloc(node);
+}/* ulist_node_free */
+
+
+//returns the node holding element 'index', its offset goes in 'off'
+static struct ulist_node *ulist_locate(const struct ulist_list *list,
+				       size_t index, size_t *off)
+{
+	struct ulist_node *node = NULL;
+	size_t first;
+
+	if ( index <= list->count / 2 ) {
+		for(node = list->head, first = 1; index >= first + node->count;
+		    node = node->next)
+			first += node->count;
+	} else {
+		first = list->count + 1;
+		for(node = list->tail; ; node = node->prev)
+		{
+			first -= node->count;
+			if ( index >= first )
+				break;
+		}
+	}
+
+	*off = index - first;
+
+	return node;
+}/* ulist_locate */
+
+
+//frees 'node' once empty, or merges it with a neighbour when under half full
+static void ulist_node_settle(struct ulist_list *list, struct ulist_node *node)
+{
+	struct ulist_node *other = NULL;
+
+	if ( 0 == node->count ) {
+		ulist_node_free(list, node);
+		return;
+	}
+
+	if ( node->count >= ULIST_K / 2 )
+		return;
+
+	if ( node->next && node->count + node->next->count <= ULIST_K ) {
+		other = node->next;
+		memcpy(&node->data[node->count], other->data,
+		       other->count * sizeof( void *));
+		node->count += other->count;
+		ulist_node_free(list, other);
+	} else if ( node->prev && node->count + node->prev->count <= ULIST_K ) {
+		other = node->prev;
+		memcpy(&other->data[other->count], node->data,
+		       node->count * sizeof( void *));
+		other->count += node->count;
+		ulist_node_free(list, node);
+	}
+}/* ulist_node_settle */
+
+
+//takes element 'off' out of 'node'
+static void *ulist_node_take(struct ulist_list *list, struct ulist_node *node,
+			     size_t off)
+{
+	void *data = node->data[off];
+
+	memmove(&node->data[off], &node->data[off + 1],
+		(node->count - off - 1) * sizeof( void *));
+	--node->count;
+	--list->count;
+
+	return data;
+}/* ulist_node_take */
+
+
+static struct ulist_list *ulist_setup(struct ulist_list *list,
+				      void *(*node_alloc)(size_t),
+				      void (*node_dalloc)(void *))
+{
+	list->count = 0;
+	list->head = NULL;
+	list->tail = NULL;
+	list->node_alloc = (node_alloc ? node_alloc : ULIST_DEF_ALLOC);
+	list->node_dalloc = (node_dalloc ? node_dalloc : ULIST_DEF_DALLOC);
+	list->data_dalloc = NULL;
+
+	return list;
+}/* ulist_setup */
+
+
+/****************************************************************************
+ * ulist library interface implementation
+ ****************************************************************************/
+
+struct ulist_list *ulist_init(struct ulist_list *list,
+			      void *(*node_alloc)(size_t),
+			      void (*node_dalloc)(void *))
+{
+	if ( !list )
+		return NULL;
+
+	return ulist_setup(list, node_alloc, node_dalloc);
+}/* ulist_init */
+
+
+struct ulist_list *ulist_list_new(void *(*node_alloc)(size_t),
+				  void (*node_dalloc)(void *))
+{
+	node_alloc = (node_alloc ? node_alloc : ULIST_DEF_ALLOC);
+
+	struct ulist_list *list = NULL;
+
+	if ( NULL == (list = node_alloc( sizeof( struct ulist_list))) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	return ulist_setup(list, node_alloc, node_dalloc);
+}/* ulist_list_new */
+
+
+struct ulist_list *ulist_data_dalloc(struct ulist_list *list,
+				     void (*data_dalloc)(void *))
+{
+	if ( !list )
+		return NULL;
+
+	list->data_dalloc = data_dalloc;
+
+	return list;
+}/* ulist_data_dalloc */
+
+
+void ulist_list_delete(struct ulist_list *list)
+{
+	if ( !list )
+		return;
+
+	void (*node_dalloc)(void *) = list->node_dalloc;
+	node_dalloc(list);
+}/* ulist_list_delete */
+
+
+struct ulist_list *ulist_push(struct ulist_list *list, void *data)
+{
+	if ( !list )
+		return NULL;
+
+	struct ulist_node *node = list->head;
+
+	if ( !node || ULIST_K == node->count ) {
+		if ( NULL == (node = ulist_node_new(list)) )
+			return NULL;
+
+		ulist_node_link(list, NULL, node);
+	}
+
+	memmove(&node->data[1], node->data, node->count * sizeof( void *));
+	node->data[0] = data;
+	++node->count;
+	++list->count;
+
+	return list;
+}/* ulist_push */
+
+
+struct ulist_list *ulist_append(struct ulist_list *list, void *data)
+{
+	if ( !list )
+		return NULL;
+
+	struct ulist_node *node = list->tail;
+
+	if ( !node || ULIST_K == node->count ) {
+		if ( NULL == (node = ulist_node_new(list)) )
+			return NULL;
+
+		ulist_node_link(list, list->tail, node);
+	}
+
+	node->data[node->count++] = data;
+	++list->count;
+
+	return list;
+}/* ulist_append */
+
+
+void *ulist_pop(struct ulist_list *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	struct ulist_node *node = list->head;
+	void *data = ulist_node_take(list, node, 0);
+
+	ulist_node_settle(list, node);
+
+	return data;
+}/* ulist_pop */
+
+
+void *ulist_pop_tail(struct ulist_list *list)
+{
+	if ( !list || !list->tail )
+		return NULL;
+
+	struct ulist_node *node = list->tail;
+	void *data = ulist_node_take(list, node, node->count - 1);
+
+	ulist_node_settle(list, node);
+
+	return data;
+}/* ulist_pop_tail */
+
+
+void *ulist_get(struct ulist_list *list, const size_t index)
+{
+	if ( !list || 0 == index || index > list->count )
+		return NULL;
+
+	size_t off;
+	struct ulist_node *node = ulist_locate(list, index, &off);
+
+	return node->data[off];
+}/* ulist_get */
+
+
+struct ulist_list *ulist_insert_at(struct ulist_list *list,
+				   const size_t index, void *data)
+{
+	if ( !list || 0 == index || index > list->count + 1 )
+		return NULL;
+
+	if ( 1 == index )
+		return ulist_push(list, data);
+
+	if ( list->count + 1 == index )
+		return ulist_append(list, data);
+
+	size_t off;
+	struct ulist_node *node = ulist_locate(list, index, &off);
+	struct ulist_node *half = NULL;
+
+	//full, move the upper half to a new node
+	if ( ULIST_K == node->count ) {
+		if ( NULL == (half = ulist_node_new(list)) )
+			return NULL;
+
+		half->count = ULIST_K - ULIST_K / 2;
+		node->count = ULIST_K / 2;
+		memcpy(half->data, &node->data[node->count],
+		       half->count * sizeof( void *));
+		ulist_node_link(list, node, half);
+
+		if ( off > node->count ) {
+			off -= node->count;
+			node = half;
+		}
+	}
+
+	memmove(&node->data[off + 1], &node->data[off],
+		(node->count - off) * sizeof( void *));
+	node->data[off] = data;
+	++node->count;
+	++list->count;
+
+	return list;
+}/* ulist_insert_at */
+
+
+void *ulist_remove_at(struct ulist_list *list, const size_t index)
+{
+	if ( !list || 0 == index || index > list->count )
+		return NULL;
+
+	size_t off;
+	struct ulist_node *node = ulist_locate(list, index, &off);
+	void *data = ulist_node_take(list, node, off);
+
+	ulist_node_settle(list, node);
+
+	return data;
+}/* ulist_remove_at */
+
+
+void *ulist_find(struct ulist_list *list, void *key,
+		 int (*cmp)(void *a, void *b))
+{
+	if ( !list || !key || !cmp )
+		return NULL;
+
+	struct ulist_node *node = NULL;
+
+	for(node = list->head; NULL != node; node = node->next)
+	{
+		for(size_t idx = 0; idx < node->count; ++idx)
+		{
+			if ( 0 == cmp(node->data[idx], key) )
+				return node->data[idx];
+		}
+	}
+
+	return NULL;
+}/* ulist_find */
+
+
+size_t ulist_find_index_of(struct ulist_list *list, void *key,
+			   int (*cmp)(void *a, void *b))
+{
+	if ( !list || !key || !cmp )
+		return 0;
+
+	struct ulist_node *node = NULL;
+	size_t first = 1;
+
+	for(node = list->head; NULL != node; first += node->count,
+	    node = node->next)
+	{
+		for(size_t idx = 0; idx < node->count; ++idx)
+		{
+			if ( 0 == cmp(node->data[idx], key) )
+				return first + idx;
+		}
+	}
+
+	return 0;
+}/* ulist_find_index_of */
+
+
+void ulist_foreach(struct ulist_list *list,
+		   void *(*action)(void *carry, void *data, void *param),
+		   void *param)
+{
+	if ( !list || !action )
+		return;
+
+	struct ulist_node *node = NULL;
+	void *carry = NULL;
+
+	for(node = list->head; NULL != node; node = node->next)
+	{
+		for(size_t idx = 0; idx < node->count; ++idx)
+			carry = action(carry, node->data[idx], param);
+	}
+}/* ulist_foreach */
+
+
+struct ulist_list *ulist_list_delete_all_nodes(struct ulist_list *list)
+{
+	if ( !list || !list->head )
+		return NULL;
+
+	struct ulist_node *node = NULL;
+	struct ulist_node *next = NULL;
+
+	for(node = list->head; NULL != node; node = next)
+	{
+		next = node->next;
+
+		if ( list->data_dalloc ) {
+			for(size_t idx = 0; idx < node->count; ++idx)
+			{
+				if ( node->data[idx] )
+					list->data_dalloc(node->data[idx]);
+			}
+		}
+
+		list->node_dalloc(node);
+	}
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->count = 0;
+
+	return list;
+}/* ulist_list_delete_all_nodes */
+
+
+inline size_t ulist_get_size(struct ulist_list *list)
+{
+	return list->count;
+}/* ulist_get_size */
+
+
+struct ulist_list *ulist_list_append(struct ulist_list *list,
+				     struct ulist_list *s_list)
+{
+	if ( !list || !s_list || !s_list->head )
+		return NULL;
+
+	if ( list->tail )
+		list->tail->next = s_list->head;
+	else
+		list->head = s_list->head;
+
+	s_list->head->prev = list->tail;
+	list->tail = s_list->tail;
+	list->count += s_list->count;
+
+	//empty s_list
+	s_list->head = NULL;
+	s_list->tail = NULL;
+	s_list->count = 0;
+
+	return list;
+}/* ulist_list_append */
+
+
+struct ulist_list *ulist_list_split_at(struct ulist_list *list,
+				       const size_t index)
+{
+	if ( !list || 0 == index || index > list->count )
+		return NULL;
+
+	struct ulist_list *n_list = NULL;
+	struct ulist_node *node = NULL;
+	struct ulist_node *half = NULL;
+	size_t off;
+
+	if ( NULL == (n_list = ulist_list_new(list->node_alloc,
+					      list->node_dalloc)) )
+		return NULL;
+
+	n_list->data_dalloc = list->data_dalloc;
+	node = ulist_locate(list, index, &off);
+
+	//'index' is mid node, its upper part starts the new list
+	if ( off ) {
+		if ( NULL == (half = ulist_node_new(list)) ) {
+			ulist_list_delete(n_list);
+			return NULL;
+		}
+
+		half->count = node->count - off;
+		node->count = off;
+		memcpy(half->data, &node->data[off], half->count * sizeof( void *));
+		ulist_node_link(list, node, half);
+		node = half;
+	}
+
+	n_list->head = node;
+	n_list->tail = list->tail;
+	n_list->count = list->count - index + 1;
+
+	list->tail = node->prev;
+	if ( list->tail )
+		list->tail->next = NULL;
+	else
+		list->head = NULL;
+
+	list->count = index - 1;
+	node->prev = NULL;
+
+	return n_list;
+}/* ulist_list_split_at */
+
+
+struct ulist_list *ulist_map(const struct ulist_list *list, ulist_map_func func,
+			     void (*dalloc)(void *))
+{
+	if ( !list || !list->head || !func )
+		return NULL;
+
+	struct ulist_list *new_list = NULL;
+	struct ulist_node *node = NULL;
+	void *data = NULL;
+
+	if ( NULL == (new_list = ulist_list_new(list->node_alloc,
+						list->node_dalloc)) )
+		return NULL;
+
+	new_list->data_dalloc = dalloc;
+
+	for(node = list->head; NULL != node; node = node->next)
+	{
+		for(size_t idx = 0; idx < node->count; ++idx)
+		{
+			data = func(node->data[idx]);
+			if ( ulist_append(new_list, data) )
+				continue;
+
+			if ( dalloc && data )
+				dalloc(data);
+
+			ulist_list_delete_all_nodes(new_list);
+			ulist_list_delete(new_list);
+			return NULL;
+		}
+	}
+
+	return new_list;
+}/* ulist_map */
+
+
+struct ulist_list *ulist_filter(const struct ulist_list *list,
+				ulist_filter_func func)
+{
+	if ( !list || !list->head || !func )
+		return NULL;
+
+	struct ulist_list *new_list = NULL;
+	struct ulist_node *node = NULL;
+
+	if ( NULL == (new_list = ulist_list_new(list->node_alloc,
+						list->node_dalloc)) )
+		return NULL;
+
+	for(node = list->head; NULL != node; node = node->next)
+	{
+		for(size_t idx = 0; idx < node->count; ++idx)
+		{
+			if ( !func(node->data[idx]) )
+				continue;
+
+			//shallow copy, no data_dalloc
+			if ( !ulist_append(new_list, node->data[idx]) ) {
+				ulist_list_delete_all_nodes(new_list);
+				ulist_list_delete(new_list);
+				return NULL;
+			}
+		}
+	}
+
+	return new_list;
+}/* ulist_filter */
+
+
+void *ulist_fold(const struct ulist_list *list, void *initial,
+		 ulist_fold_func func)
+{
+	if ( !list || !func )
+		return initial;
+
+	struct ulist_node *node = NULL;
+	void *acc = initial;
+
+	for(node = list->head; NULL != node; node = node->next)
+	{
+		for(size_t idx = 0; idx < node->count; ++idx)
+			acc = func(acc, node->data[idx]);
+	}
+
+	return acc;
+}/* ulist_fold */
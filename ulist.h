@@ -0,0 +1,342 @@
+/*
+ * ulist.h
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#ifndef DUTILS_ULIST_H_
+#define DUTILS_ULIST_H_
+
+
+/****************************************************************************
+ * standard libraries
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define ULIST_DEF_ALLOC malloc
+#define ULIST_DEF_DALLOC free
+
+/* elements held by a single node. the default makes a node 128 bytes,
+ * two cache lines, on LP64. may be defined before including ulist.h
+ */
+#ifndef ULIST_K
+#define ULIST_K 13
+#endif
+
+
+/****************************************************************************
+ * base data structures
+ ****************************************************************************/
+
+/* unrolled node: 'count' elements packed at the start of 'data'.
+ * nodes split when inserting into a full one and merge with a
+ * neighbour once they drop under half full.
+ */
+struct ulist_node
+{
+	struct ulist_node *next;
+	struct ulist_node *prev;
+	size_t count;
+	void *data[ULIST_K];
+};
+
+struct ulist_list
+{
+	//elements, not nodes
+	size_t count;
+	struct ulist_node *head;
+	struct ulist_node *tail;
+	void *(*node_alloc)(size_t);
+	void (*node_dalloc)(void *);
+	//deletes elements when the list does, see ulist_data_dalloc
+	void (*data_dalloc)(void *);
+};
+
+
+/****************************************************************************
+ * conviniente data types for library consumers/users
+ ****************************************************************************/
+
+typedef struct ulist_node ulist_node_t;
+typedef struct ulist_list ulist_list_t;
+
+/****************************************************************************
+ * functional operations typedefs
+ ****************************************************************************/
+
+typedef void *(*ulist_map_func)(void *data);
+typedef bool (*ulist_filter_func)(void *data);
+typedef void *(*ulist_fold_func)(void *acc, void *data);
+
+
+/****************************************************************************
+ * library interface and _base_ documentation
+ ****************************************************************************/
+
+/* returns 'list' initialized with 'node_alloc' and 'node_dalloc'
+ * NULL is returned if 'list' is NULL
+ * passing NULL to 'node_alloc' sets it to ULIST_DEF_ALLOC
+ * passing NULL to 'node_dalloc' sets it to ULIST_DEF_DALLOC.
+ *
+ * passing invalid ['list' or 'node_alloc' or 'node_dalloc']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_init(struct ulist_list *list,
+			      void *(*node_alloc)(size_t),
+			      void (*node_dalloc)(void *));
+
+
+/* returns a new allocated 'list' initialized with
+ * ------- 'node_alloc' and 'node_dalloc'.
+ * ------- the returned 'list' has to be freed, see ulist_list_delete
+ * passing NULL to 'node_alloc' sets it to ULIST_DEF_ALLOC.
+ * passing NULL to 'node_dalloc' sets it to ULIST_DEF_DALLOC.
+ * NULL is returned if 'node_alloc' fails to allocate memory.
+ *
+ * passing invalid ['node_alloc' or 'node_dalloc']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_list_new(void *(*node_alloc)(size_t),
+				  void (*node_dalloc)(void *));
+
+
+/* returns 'list' after setting 'data_dalloc' to delete every element
+ * ------- when the 'list' deletes them.
+ * returns NULL if 'list' is NULL
+ * passing NULL in 'data_dalloc' unsets it, which is the default.
+ *
+ * passing invalid ['list' or 'data_dalloc']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_data_dalloc(struct ulist_list *list,
+				     void (*data_dalloc)(void *));
+
+
+/* deletes 'list'
+ * passing NULL in 'list' returns with no operation executed
+ *
+ * NOTE: 'nodes' are not deleted, see ulist_list_delete_all_nodes
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ * ------- passing a 'list' not created with ulist_list_new
+ */
+void ulist_list_delete(struct ulist_list *list);
+
+
+/* returns 'list' after adding 'data' at its head
+ * returns NULL if 'list' is NULL
+ * returns NULL if a new node is needed and can't be allocated
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_push(struct ulist_list *list, void *data);
+
+
+/* returns 'list' after adding 'data' at its tail
+ * returns NULL if 'list' is NULL
+ * returns NULL if a new node is needed and can't be allocated
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_append(struct ulist_list *list, void *data);
+
+
+/* returns the element at 'list' head removing it.
+ * returns NULL if 'list' is NULL or empty.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+void *ulist_pop(struct ulist_list *list);
+
+
+/* returns the element at 'list' tail removing it.
+ * returns NULL if 'list' is NULL or empty.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+void *ulist_pop_tail(struct ulist_list *list);
+
+
+/* returns the element stored in 'index' position
+ * returns NULL if 'list' is NULL or empty.
+ * returns NULL if 'index' is out of bounds.
+ *
+ * ABOUT ['index']: starts counting at 1. nodes are skipped whole,
+ * ------- walking from the closest end.
+ *
+ * passing invalid ['list' or 'index']
+ * ------- results in undefined behavior
+ */
+void *ulist_get(struct ulist_list *list, const size_t index);
+
+
+/* returns 'list' after inserting 'data' so it ends up in 'index' position
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'index' is 0 or past 'count' + 1
+ * returns NULL if a full node needs splitting and allocation fails
+ *
+ * ABOUT ['index']: starts counting at 1, 'count' + 1 appends.
+ *
+ * passing invalid ['list' or 'index']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_insert_at(struct ulist_list *list,
+				   const size_t index, void *data);
+
+
+/* returns the element stored in 'index' position removing it.
+ * returns NULL if 'list' is NULL or empty.
+ * returns NULL if 'index' is out of bounds.
+ *
+ * ABOUT ['index']: starts counting at 1
+ *
+ * passing invalid ['list' or 'index']
+ * ------- results in undefined behavior
+ */
+void *ulist_remove_at(struct ulist_list *list, const size_t index);
+
+
+/* returns the first element matching 'key'
+ * returns NULL if 'key' is not found
+ * passing NULL in 'list', 'key' or 'cmp' returns NULL.
+ *
+ * ABOUT ['cmp']: function needs to return 0 when 'a' and 'b' match
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+void *ulist_find(struct ulist_list *list, void *key,
+		 int (*cmp)(void *a, void *b));
+
+
+/* returns the 'index' of 'key' in 'list'
+ * returns 0 if 'list' is NULL, empty or 'key' is not found.
+ * returns 0 if 'key' or 'cmp' are NULL
+ *
+ * ABOUT [index]: starts at 1, 0 is reserved (see above)
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+size_t ulist_find_index_of(struct ulist_list *list, void *key,
+			   int (*cmp)(void *a, void *b));
+
+
+/* executes 'action' in each element contained in 'list'
+ * returns without any action performed if 'list' is NULL or empty
+ * returns without any action performed if 'action' is NULL
+ * passing NULL in 'param' is allowed
+ *
+ * ABOUT ['action']: same as dlist_node_foreach
+ *
+ * passing invalid ['list' or 'action' or 'param']
+ * ------- results in undefined behavior
+ */
+void ulist_foreach(struct ulist_list *list,
+		   void *(*action)(void *carry, void *data, void *param),
+		   void *param);
+
+
+/* returns an empty 'list' after deleting all 'nodes' contained in it.
+ * ------- elements are deleted with 'data_dalloc' when set.
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'list' is empty
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_list_delete_all_nodes(struct ulist_list *list);
+
+
+/* returns the number of elements contained in 'list'
+ * ABOUT ulist_get_size: no safety checks are made
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+size_t ulist_get_size(struct ulist_list *list);
+
+
+/* returns 'list' after moving every element of 's_list' to its tail
+ * returns NULL if 'list' or 's_list' are NULL
+ * returns NULL if 's_list' is empty
+ *
+ * NOTE: nodes are linked as they are, no element is copied.
+ * ------- 's_list' is left empty.
+ *
+ * passing invalid ['list' or 's_list']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_list_append(struct ulist_list *list,
+				     struct ulist_list *s_list);
+
+
+/* returns a newly allocated 'list' with head set to the element
+ * -------- stored in 'index', holding every element from there on.
+ * returns NULL if 'list' is NULL or empty.
+ * returns NULL if 'index' is out of bounds.
+ * returns NULL if allocation fails, 'list' is left as it was.
+ *
+ * ---info makes 'list' empty if 'index' is 1/head
+ * ---info the newly allocated list has to be freed. see ulist_list_delete
+ *
+ * NOTE: at most one node is split, the rest change list as they are.
+ * ------- 'data_dalloc' is handed over.
+ *
+ * passing invalid ['list']
+ * -------- results in undefined behavior
+ */
+struct ulist_list *ulist_list_split_at(struct ulist_list *list,
+				       const size_t index);
+
+/* returns a new list with each element transformed by 'func'
+ * returns NULL if 'list' is NULL, empty or allocation fails
+ * 'dalloc' becomes the new list 'data_dalloc'
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_map(const struct ulist_list *list, ulist_map_func func,
+			     void (*dalloc)(void *));
+
+/* returns a new list with elements that pass 'func' predicate
+ * returns NULL if 'list' is NULL, empty or allocation fails
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct ulist_list *ulist_filter(const struct ulist_list *list,
+				ulist_filter_func func);
+
+/* folds the list from left to right using 'func', starting with 'initial'
+ * returns the final accumulator value
+ * returns 'initial' if 'list' is NULL or empty
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+void *ulist_fold(const struct ulist_list *list, void *initial,
+		 ulist_fold_func func);
+
+#endif
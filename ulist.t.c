@@ -0,0 +1,333 @@
+/*
+ * ulist.t.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "ulist.h"
+#include <stdio.h>
+
+#include <assert.h>
+
+#define LOUD
+#include "common.h"
+
+void *double_int(void *data)
+{
+	return int_copy(*(int*)data * 2);
+}
+
+bool is_even(void *data)
+{
+	return 0 == *(int*)data % 2;
+}
+
+void *add_int(void *acc, void *data)
+{
+	*(int*)acc += *(int*)data;
+	return acc;
+}
+
+void *sum_int(void *carry, void *data, void *param)
+{
+	*(int*)param += *(int*)data;
+	return carry;
+}
+
+//checks 'list' holds 'n' values of 'expect' and its nodes are sane
+int list_is(struct ulist_list *list, const int *expect, size_t n)
+{
+	struct ulist_node *node;
+	struct ulist_node *prev = NULL;
+	size_t idx = 0;
+
+	if ( n != list->count )
+		return 0;
+
+	for(node = list->head; NULL != node; prev = node, node = node->next)
+	{
+		if ( 0 == node->count || ULIST_K < node->count )
+			return 0;
+		if ( prev != node->prev )
+			return 0;
+		for(size_t off = 0; off < node->count; ++off)
+			if ( idx >= n || expect[idx++] != *(int*)node->data[off] )
+				return 0;
+	}
+
+	return prev == list->tail && idx == n;
+}
+
+size_t node_count(const struct ulist_list *list)
+{
+	size_t n = 0;
+
+	for(struct ulist_node *node = list->head; node; node = node->next)
+		++n;
+
+	return n;
+}
+
+int main(int argc, char **argv)
+{
+	wmsg("testing ulist lib interface\n");
+
+	{
+		wmsg("ulist_init");
+
+		struct ulist_list list;
+		assert( NULL == ulist_init(NULL, NULL, NULL) );
+		assert( ulist_init(&list, NULL, NULL) );
+		assert( 0 == list.count );
+		assert( NULL == list.head && NULL == list.tail );
+		assert( malloc == list.node_alloc );
+		assert( free == list.node_dalloc );
+		assert( NULL == list.data_dalloc );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("ulist_push/append/pop/pop_tail");
+
+		struct ulist_list *list;
+		int expect[3 * ULIST_K];
+		int *data;
+		assert( NULL == ulist_push(NULL, NULL) );
+		assert( NULL == ulist_append(NULL, NULL) );
+		assert( NULL == ulist_pop(NULL) );
+		assert( NULL == ulist_pop_tail(NULL) );
+		assert( (list = ulist_list_new(NULL, NULL)) );
+		ulist_data_dalloc(list, int_dalloc);
+		assert( NULL == ulist_pop(list) );
+		//ULIST_K pushed and ULIST_K appended to either side of 0
+		for(int i = 1; i <= ULIST_K; ++i)
+		{
+			assert( list == ulist_push(list, int_copy(-i)) );
+			assert( list == ulist_append(list, int_copy(i)) );
+		}
+		ulist_push(list, int_copy(0));
+		expect[0] = 0;
+		for(int i = 1; i <= ULIST_K; ++i)
+		{
+			expect[i] = i - ULIST_K - 1;
+			expect[ULIST_K + i] = i;
+		}
+		assert( list_is(list, expect, 2 * ULIST_K + 1) );
+		assert( 2 * ULIST_K + 1 == ulist_get_size(list) );
+		data = ulist_pop(list);
+		assert( 0 == *data );
+		int_dalloc(data);
+		data = ulist_pop_tail(list);
+		assert( ULIST_K == *data );
+		int_dalloc(data);
+		//drain both ends
+		while ( list->count )
+		{
+			int_dalloc(ulist_pop(list));
+			if ( list->count )
+				int_dalloc(ulist_pop_tail(list));
+		}
+		assert( 0 == list->count );
+		assert( NULL == list->head && NULL == list->tail );
+		assert( NULL == ulist_list_delete_all_nodes(list) );
+		//a split node popped under half full merges back, at either end
+		for(int end = 0; end < 2; ++end)
+		{
+			size_t pops = 0;
+			size_t half;
+			for(int i = 0; i < ULIST_K; ++i)
+				ulist_append(list, int_copy(i));
+			ulist_insert_at(list, ULIST_K / 2 + 1, int_copy(-1));
+			assert( 2 == node_count(list) );
+			half = end ? list->tail->count : list->head->count;
+			while ( 1 < node_count(list) )
+			{
+				int_dalloc(end ? ulist_pop_tail(list) : ulist_pop(list));
+				++pops;
+			}
+			assert( half - ULIST_K / 2 + 1 == pops );
+			ulist_list_delete_all_nodes(list);
+		}
+		ulist_list_delete_all_nodes(list);
+		ulist_list_delete(list);
+		ulist_list_delete(NULL);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("ulist_get/insert_at/remove_at");
+
+		struct ulist_list list;
+		int expect[200];
+		size_t n = 0;
+		size_t at;
+		int *data;
+		ulist_init(&list, NULL, NULL);
+		ulist_data_dalloc(&list, int_dalloc);
+		//test failures
+		assert( NULL == ulist_get(NULL, 1) );
+		assert( NULL == ulist_get(&list, 1) );
+		assert( NULL == ulist_insert_at(&list, 0, NULL) );
+		assert( NULL == ulist_insert_at(&list, 2, NULL) );
+		assert( NULL == ulist_remove_at(&list, 1) );
+		//inserts all over the place, splitting full nodes
+		for(int i = 0; i < 200; ++i)
+		{
+			at = (size_t)(i * 7) % (n + 1) + 1;
+			assert( &list == ulist_insert_at(&list, at, int_copy(i)) );
+			for(size_t idx = n; idx >= at; --idx)
+				expect[idx] = expect[idx - 1];
+			expect[at - 1] = i;
+			++n;
+		}
+		assert( list_is(&list, expect, n) );
+		for(size_t idx = 1; idx <= n; ++idx)
+			assert( expect[idx - 1] == *(int*)ulist_get(&list, idx) );
+		assert( NULL == ulist_get(&list, n + 1) );
+		//removes all over the place, merging nodes back
+		while ( n > 20 )
+		{
+			at = 1 + n / 3;
+			data = ulist_remove_at(&list, at);
+			assert( expect[at - 1] == *data );
+			int_dalloc(data);
+			for(size_t idx = at; idx < n; ++idx)
+				expect[idx - 1] = expect[idx];
+			--n;
+			assert( list_is(&list, expect, n) );
+		}
+		assert( NULL == ulist_remove_at(&list, 0) );
+		assert( NULL == ulist_remove_at(&list, n + 1) );
+		ulist_list_delete_all_nodes(&list);
+		assert( 0 == list.count );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("ulist_find/find_index_of/foreach");
+
+		struct ulist_list list;
+		int key = 30;
+		int sum = 0;
+		ulist_init(&list, NULL, NULL);
+		ulist_data_dalloc(&list, int_dalloc);
+		assert( NULL == ulist_find(&list, &key, cmp_int) );
+		assert( 0 == ulist_find_index_of(&list, &key, cmp_int) );
+		for(int i = 0; i < 40; ++i)
+			ulist_append(&list, int_copy(i));
+		assert( NULL == ulist_find(NULL, &key, cmp_int) );
+		assert( NULL == ulist_find(&list, NULL, cmp_int) );
+		assert( NULL == ulist_find(&list, &key, NULL) );
+		assert( 30 == *(int*)ulist_find(&list, &key, cmp_int) );
+		assert( 31 == ulist_find_index_of(&list, &key, cmp_int) );
+		key = 40;
+		assert( NULL == ulist_find(&list, &key, cmp_int) );
+		assert( 0 == ulist_find_index_of(&list, &key, cmp_int) );
+		ulist_foreach(&list, sum_int, &sum);
+		assert( 780 == sum );
+		ulist_list_delete_all_nodes(&list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("ulist_list_split_at/append");
+
+		struct ulist_list list;
+		struct ulist_list *n_list;
+		int expect[40];
+		ulist_init(&list, NULL, NULL);
+		ulist_data_dalloc(&list, int_dalloc);
+		assert( NULL == ulist_list_split_at(&list, 1) );
+		for(int i = 0; i < 40; ++i)
+		{
+			ulist_append(&list, int_copy(i));
+			expect[i] = i;
+		}
+		assert( NULL == ulist_list_split_at(&list, 0) );
+		assert( NULL == ulist_list_split_at(&list, 41) );
+		//mid node
+		assert( (n_list = ulist_list_split_at(&list, 18)) );
+		assert( list_is(&list, expect, 17) );
+		assert( list_is(n_list, expect + 17, 23) );
+		assert( int_dalloc == n_list->data_dalloc );
+		//and back together
+		assert( NULL == ulist_list_append(&list, NULL) );
+		assert( &list == ulist_list_append(&list, n_list) );
+		assert( 0 == n_list->count && NULL == n_list->head );
+		assert( list_is(&list, expect, 40) );
+		assert( NULL == ulist_list_append(&list, n_list) );
+		ulist_list_delete(n_list);
+		//on a node boundary
+		assert( (n_list = ulist_list_split_at(&list, ULIST_K + 1)) );
+		assert( list_is(&list, expect, ULIST_K) );
+		assert( list_is(n_list, expect + ULIST_K, 40 - ULIST_K) );
+		ulist_list_delete_all_nodes(n_list);
+		ulist_list_delete(n_list);
+		ulist_list_delete_all_nodes(&list);
+		//@ head
+		for(int i = 0; i < 5; ++i)
+			ulist_append(&list, int_copy(i));
+		assert( (n_list = ulist_list_split_at(&list, 1)) );
+		assert( 0 == list.count && NULL == list.head && NULL == list.tail );
+		assert( list_is(n_list, expect, 5) );
+		ulist_list_delete_all_nodes(n_list);
+		ulist_list_delete(n_list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("ulist_map/filter/fold");
+
+		struct ulist_list list;
+		struct ulist_list *mapped;
+		struct ulist_list *filtered;
+		int acc = 0;
+		int expect[30];
+		ulist_init(&list, NULL, NULL);
+		ulist_data_dalloc(&list, int_dalloc);
+		//test failures
+		assert( NULL == ulist_map(&list, double_int, int_dalloc) );
+		assert( NULL == ulist_filter(&list, is_even) );
+		assert( &acc == ulist_fold(&list, &acc, add_int) );
+		for(int i = 0; i < 30; ++i)
+			ulist_append(&list, int_copy(i));
+		assert( NULL == ulist_map(&list, NULL, NULL) );
+		assert( (mapped = ulist_map(&list, double_int, int_dalloc)) );
+		for(int i = 0; i < 30; ++i)
+			expect[i] = i * 2;
+		assert( list_is(mapped, expect, 30) );
+		assert( int_dalloc == mapped->data_dalloc );
+		assert( (filtered = ulist_filter(&list, is_even)) );
+		assert( list_is(filtered, expect, 15) );
+		assert( NULL == filtered->data_dalloc );
+		ulist_fold(&list, &acc, add_int);
+		assert( 435 == acc );
+		ulist_list_delete_all_nodes(filtered);
+		ulist_list_delete(filtered);
+		ulist_list_delete_all_nodes(mapped);
+		ulist_list_delete(mapped);
+		ulist_list_delete_all_nodes(&list);
+
+		wmsg("[OK]\n");
+	}
+
+	return 0;
+}
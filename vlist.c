@@ -0,0 +1,572 @@
+/*
+ * vlist.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include <string.h>
+
+#include "vlist.h"
+
+/****************************************************************************
+ * internal helpers
+ ****************************************************************************/
+
+//grows the node array to 'capacity' slots, keeping the used ones
+static int vlist_grow(struct vlist_list *list, size_t capacity)
+{
+	struct vlist_node *nodes = NULL;
+
+	//VLIST_NIL is never a slot
+	if ( capacity > VLIST_NIL )
+		capacity = VLIST_NIL;
+
+	if ( capacity <= list->capacity )
+		return 0;
+
+	if ( NULL == (nodes = list->node_alloc(capacity * sizeof( struct vlist_node))) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return 0;
+	}
+
+	if ( list->nodes ) {
+		memcpy(nodes, list->nodes, list->used * sizeof( struct vlist_node));
+		list->node_dalloc(list->nodes);
+	}
+
+	list->nodes = nodes;
+	list->capacity = (uint32_t)capacity;
+
+	return 1;
+}/* vlist_grow */
+
+
+//returns a slot holding 'data', not linked yet
+static uint32_t vlist_slot_take(struct vlist_list *list, void *data)
+{
+	uint32_t slot = list->free;
+
+	if ( VLIST_NIL != slot ) {
+		list->free = list->nodes[slot].next;
+	} else {
+		if ( list->used == list->capacity &&
+		     !vlist_grow(list, (list->capacity ?
+					(size_t)list->capacity * 2 :
+					VLIST_DEF_CAPACITY)) )
+			return VLIST_NIL;
+
+		slot = list->used++;
+	}
+
+	list->nodes[slot].data = data;
+	list->nodes[slot].next = VLIST_NIL;
+	list->nodes[slot].prev = VLIST_NIL;
+
+	return slot;
+}/* vlist_slot_take */
+
+
+static inline void vlist_slot_give(struct vlist_list *list, uint32_t slot)
+{
+	list->nodes[slot].data = NULL;
+	list->nodes[slot].next = list->free;
+	list->free = slot;
+}/* vlist_slot_give */
+
+
+//returns the slot at 'index' position, walking from the closest end
+static uint32_t vlist_slot_at(const struct vlist_list *list, size_t index)
+{
+	uint32_t slot;
+	size_t idx;
+
+	if ( index <= list->count / 2 ) {
+		for(slot = list->head, idx = 1; idx < index; ++idx)
+			slot = list->nodes[slot].next;
+	} else {
+		for(slot = list->tail, idx = list->count; idx > index; --idx)
+			slot = list->nodes[slot].prev;
+	}
+
+	return slot;
+}/* vlist_slot_at */
+
+
+static struct vlist_list *vlist_setup(struct vlist_list *list,
+				      void *(*node_alloc)(size_t),
+				      void (*node_dalloc)(void *))
+{
+	list->count = 0;
+	list->head = VLIST_NIL;
+	list->tail = VLIST_NIL;
+	list->free = VLIST_NIL;
+	list->used = 0;
+	list->capacity = 0;
+	list->nodes = NULL;
+	list->node_alloc = (node_alloc ? node_alloc : VLIST_DEF_ALLOC);
+	list->node_dalloc = (node_dalloc ? node_dalloc : VLIST_DEF_DALLOC);
+	list->data_dalloc = NULL;
+
+	return list;
+}/* vlist_setup */
+
+
+/* moves 'slot' and every node after it to a new list, sized for the
+ * 'count' nodes it takes. returns NULL leaving 'list' untouched on failure.
+ */
+static struct vlist_list *vlist_list_cut(struct vlist_list *list,
+					 uint32_t slot, size_t count)
+{
+	struct vlist_list *n_list = NULL;
+	uint32_t next;
+
+	if ( NULL == (n_list = vlist_list_new(list->node_alloc,
+					      list->node_dalloc)) )
+		return NULL;
+
+	if ( !vlist_reserve(n_list, count) ) {
+		vlist_list_delete(n_list);
+		return NULL;
+	}
+
+	n_list->data_dalloc = list->data_dalloc;
+
+	//cut 'list' short before 'slot'
+	list->tail = list->nodes[slot].prev;
+	if ( VLIST_NIL == list->tail )
+		list->head = VLIST_NIL;
+	else
+		list->nodes[list->tail].next = VLIST_NIL;
+
+	list->count -= count;
+
+	//room is reserved, appending can't fail
+	for(; VLIST_NIL != slot; slot = next)
+	{
+		next = list->nodes[slot].next;
+		vlist_append(n_list, list->nodes[slot].data);
+		vlist_slot_give(list, slot);
+	}
+
+	return n_list;
+}/* vlist_list_cut */
+
+
+/****************************************************************************
+ * vlist library interface implementation
+ ****************************************************************************/
+
+struct vlist_list *vlist_init(struct vlist_list *list,
+			      void *(*node_alloc)(size_t),
+			      void (*node_dalloc)(void *))
+{
+	if ( !list )
+		return NULL;
+
+	return vlist_setup(list, node_alloc, node_dalloc);
+}/* vlist_init */
+
+
+struct vlist_list *vlist_list_new(void *(*node_alloc)(size_t),
+				  void (*node_dalloc)(void *))
+{
+	node_alloc = (node_alloc ? node_alloc : VLIST_DEF_ALLOC);
+
+	struct vlist_list *list = NULL;
+
+	if ( NULL == (list = node_alloc( sizeof( struct vlist_list))) ) {
+		//FIXME: add support for custom error logging and msg
+		fprintf(stderr,"%s[%d]:%s alloc failed\n", __FILE__,
+			__LINE__,__func__);
+
+		return NULL;
+	}
+
+	return vlist_setup(list, node_alloc, node_dalloc);
+}/* vlist_list_new */
+
+
+struct vlist_list *vlist_data_dalloc(struct vlist_list *list,
+				     void (*data_dalloc)(void *))
+{
+	if ( !list )
+		return NULL;
+
+	list->data_dalloc = data_dalloc;
+
+	return list;
+}/* vlist_data_dalloc */
+
+
+struct vlist_list *vlist_reserve(struct vlist_list *list, size_t capacity)
+{
+	if ( !list || capacity > VLIST_NIL )
+		return NULL;
+
+	if ( capacity > list->capacity && !vlist_grow(list, capacity) )
+		return NULL;
+
+	return list;
+}/* vlist_reserve */
+
+
+void vlist_release(struct vlist_list *list)
+{
+	if ( !list )
+		return;
+
+	if ( list->nodes )
+		list->node_dalloc(list->nodes);
+
+	vlist_setup(list, list->node_alloc, list->node_dalloc);
+}/* vlist_release */
+
+
+void vlist_list_delete(struct vlist_list *list)
+{
+	if ( !list )
+		return;
+
+	void (*node_dalloc)(void *) = list->node_dalloc;
+
+	if ( list->nodes )
+		node_dalloc(list->nodes);
+
+	node_dalloc(list);
+}/* vlist_list_delete */
+
+
+uint32_t vlist_push(struct vlist_list *list, void *data)
+{
+	if ( !list )
+		return VLIST_NIL;
+
+	uint32_t slot = vlist_slot_take(list, data);
+
+	if ( VLIST_NIL == slot )
+		return VLIST_NIL;
+
+	list->nodes[slot].next = list->head;
+
+	if ( VLIST_NIL == list->head )
+		list->tail = slot;
+	else
+		list->nodes[list->head].prev = slot;
+
+	list->head = slot;
+	++list->count;
+
+	return slot;
+}/* vlist_push */
+
+
+uint32_t vlist_append(struct vlist_list *list, void *data)
+{
+	if ( !list )
+		return VLIST_NIL;
+
+	uint32_t slot = vlist_slot_take(list, data);
+
+	if ( VLIST_NIL == slot )
+		return VLIST_NIL;
+
+	list->nodes[slot].prev = list->tail;
+
+	if ( VLIST_NIL == list->tail )
+		list->head = slot;
+	else
+		list->nodes[list->tail].next = slot;
+
+	list->tail = slot;
+	++list->count;
+
+	return slot;
+}/* vlist_append */
+
+
+void *vlist_pop(struct vlist_list *list)
+{
+	if ( !list || VLIST_NIL == list->head )
+		return NULL;
+
+	return vlist_unlink(list, list->head);
+}/* vlist_pop */
+
+
+void *vlist_unlink(struct vlist_list *list, uint32_t slot)
+{
+	if ( !list )
+		return NULL;
+
+	struct vlist_node *node = &list->nodes[slot];
+	void *data = node->data;
+
+	if ( VLIST_NIL == node->prev )
+		list->head = node->next;
+	else
+		list->nodes[node->prev].next = node->next;
+
+	if ( VLIST_NIL == node->next )
+		list->tail = node->prev;
+	else
+		list->nodes[node->next].prev = node->prev;
+
+	--list->count;
+	vlist_slot_give(list, slot);
+
+	return data;
+}/* vlist_unlink */
+
+
+uint32_t vlist_find(struct vlist_list *list, void *key,
+		    int (*cmp)(void *a, void *b))
+{
+	if ( !list || !key || !cmp )
+		return VLIST_NIL;
+
+	uint32_t slot;
+
+	for(slot = list->head; VLIST_NIL != slot; slot = list->nodes[slot].next)
+	{
+		if ( 0 == cmp(list->nodes[slot].data, key) )
+			break;
+	}
+
+	return slot;
+}/* vlist_find */
+
+
+size_t vlist_find_index_of(struct vlist_list *list, void *key,
+			   int (*cmp)(void *a, void *b))
+{
+	if ( !list || !key || !cmp )
+		return 0;
+
+	uint32_t slot;
+	size_t idx = 1;
+
+	for(slot = list->head; VLIST_NIL != slot;
+	    slot = list->nodes[slot].next, ++idx)
+	{
+		if ( 0 == cmp(list->nodes[slot].data, key) )
+			return idx;
+	}
+
+	return 0;
+}/* vlist_find_index_of */
+
+
+void *vlist_remove(struct vlist_list *list, void *key,
+		   int (*cmp)(void *a, void *b))
+{
+	uint32_t slot = vlist_find(list, key, cmp);
+
+	if ( VLIST_NIL == slot )
+		return NULL;
+
+	return vlist_unlink(list, slot);
+}/* vlist_remove */
+
+
+void *vlist_remove_at(struct vlist_list *list, const size_t index)
+{
+	if ( !list || 0 == index || index > list->count )
+		return NULL;
+
+	return vlist_unlink(list, vlist_slot_at(list, index));
+}/* vlist_remove_at */
+
+
+void vlist_foreach(struct vlist_list *list,
+		   void *(*action)(void *carry, void *data, void *param),
+		   void *param)
+{
+	if ( !list || !action )
+		return;
+
+	uint32_t slot;
+	void *carry = NULL;
+
+	for(slot = list->head; VLIST_NIL != slot; slot = list->nodes[slot].next)
+		carry = action(carry, list->nodes[slot].data, param);
+}/* vlist_foreach */
+
+
+struct vlist_list *vlist_list_delete_all_nodes(struct vlist_list *list)
+{
+	if ( !list || VLIST_NIL == list->head )
+		return NULL;
+
+	uint32_t slot;
+
+	if ( list->data_dalloc ) {
+		for(slot = list->head; VLIST_NIL != slot;
+		    slot = list->nodes[slot].next)
+		{
+			if ( list->nodes[slot].data )
+				list->data_dalloc(list->nodes[slot].data);
+		}
+	}
+
+	//every slot is free again, no need to thread them
+	list->head = VLIST_NIL;
+	list->tail = VLIST_NIL;
+	list->free = VLIST_NIL;
+	list->used = 0;
+	list->count = 0;
+
+	return list;
+}/* vlist_list_delete_all_nodes */
+
+
+struct vlist_list *vlist_list_reverse(struct vlist_list *list)
+{
+	if ( !list || VLIST_NIL == list->head )
+		return NULL;
+
+	uint32_t slot;
+	uint32_t next;
+
+	for(slot = list->head; VLIST_NIL != slot; slot = next)
+	{
+		next = list->nodes[slot].next;
+		list->nodes[slot].next = list->nodes[slot].prev;
+		list->nodes[slot].prev = next;
+	}
+
+	slot = list->head;
+	list->head = list->tail;
+	list->tail = slot;
+
+	return list;
+}/* vlist_list_reverse */
+
+
+inline size_t vlist_get_size(struct vlist_list *list)
+{
+	return list->count;
+}/* vlist_get_size */
+
+
+struct vlist_list *vlist_list_split(struct vlist_list *list, void *key,
+				    int (*cmp)(void *a, void *b))
+{
+	if ( !list || !key || !cmp )
+		return NULL;
+
+	uint32_t slot;
+	size_t idx = 0;
+
+	for(slot = list->head; VLIST_NIL != slot;
+	    slot = list->nodes[slot].next, ++idx)
+	{
+		if ( 0 == cmp(list->nodes[slot].data, key) )
+			break;
+	}
+
+	//check if node was found
+	if ( VLIST_NIL == slot )
+		return NULL;
+
+	return vlist_list_cut(list, slot, list->count - idx);
+}/* vlist_list_split */
+
+
+struct vlist_list *vlist_list_split_at(struct vlist_list *list,
+				       const size_t index)
+{
+	if ( !list || 0 == index || index > list->count )
+		return NULL;
+
+	return vlist_list_cut(list, vlist_slot_at(list, index),
+			      list->count - index + 1);
+}/* vlist_list_split_at */
+
+
+struct vlist_list *vlist_map(const struct vlist_list *list, vlist_map_func func,
+			     void (*dalloc)(void *))
+{
+	if ( !list || VLIST_NIL == list->head || !func )
+		return NULL;
+
+	struct vlist_list *new_list = NULL;
+	uint32_t slot;
+
+	if ( NULL == (new_list = vlist_list_new(list->node_alloc,
+						list->node_dalloc)) )
+		return NULL;
+
+	if ( !vlist_reserve(new_list, list->count) ) {
+		vlist_list_delete(new_list);
+		return NULL;
+	}
+
+	//room is reserved, appending can't fail
+	for(slot = list->head; VLIST_NIL != slot; slot = list->nodes[slot].next)
+		vlist_append(new_list, func(list->nodes[slot].data));
+
+	new_list->data_dalloc = dalloc;
+
+	return new_list;
+}/* vlist_map */
+
+
+struct vlist_list *vlist_filter(const struct vlist_list *list,
+				vlist_filter_func func)
+{
+	if ( !list || VLIST_NIL == list->head || !func )
+		return NULL;
+
+	struct vlist_list *new_list = NULL;
+	uint32_t slot;
+
+	if ( NULL == (new_list = vlist_list_new(list->node_alloc,
+						list->node_dalloc)) )
+		return NULL;
+
+	for(slot = list->head; VLIST_NIL != slot; slot = list->nodes[slot].next)
+	{
+		if ( !func(list->nodes[slot].data) )
+			continue;
+
+		//shallow copy, no data_dalloc
+		if ( VLIST_NIL == vlist_append(new_list, list->nodes[slot].data) ) {
+			vlist_list_delete(new_list);
+			return NULL;
+		}
+	}
+
+	return new_list;
+}/* vlist_filter */
+
+
+void *vlist_fold(const struct vlist_list *list, void *initial,
+		 vlist_fold_func func)
+{
+	if ( !list || !func )
+		return initial;
+
+	void *acc = initial;
+	uint32_t slot;
+
+	for(slot = list->head; VLIST_NIL != slot; slot = list->nodes[slot].next)
+		acc = func(acc, list->nodes[slot].data);
+
+	return acc;
+}/* vlist_fold */
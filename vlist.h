@@ -0,0 +1,397 @@
+/*
+ * vlist.h
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#ifndef DUTILS_VLIST_H_
+#define DUTILS_VLIST_H_
+
+
+/****************************************************************************
+ * standard libraries
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define VLIST_DEF_ALLOC malloc
+#define VLIST_DEF_DALLOC free
+
+//marks the end of the list, no slot has this index
+#define VLIST_NIL UINT32_MAX
+
+//slots taken by the first growth of an empty list
+#define VLIST_DEF_CAPACITY 16
+
+
+/****************************************************************************
+ * base data structures
+ ****************************************************************************/
+
+/* nodes live in a single array owned by the 'list' and link to each other
+ * by slot index. a 'node' is known by its slot, which stays the same
+ * while it is in the 'list', even when the array moves to grow.
+ */
+struct vlist_node
+{
+	void *data;
+	uint32_t next;
+	uint32_t prev;
+};
+
+struct vlist_list
+{
+	size_t count;
+	uint32_t head;
+	uint32_t tail;
+	//released slots, linked through 'next'
+	uint32_t free;
+	//slots past 'used' were never handed out
+	uint32_t used;
+	uint32_t capacity;
+	struct vlist_node *nodes;
+	void *(*node_alloc)(size_t);
+	void (*node_dalloc)(void *);
+	//deletes 'data' when the list does, see vlist_data_dalloc
+	void (*data_dalloc)(void *);
+};
+
+/* returns the 'data' held by 'slot' */
+#define vlist_data(list, slot) ((list)->nodes[(slot)].data)
+
+/* returns the slot after/before 'slot', VLIST_NIL at the ends.
+ * example: ******************************************************************
+ * -------- for(uint32_t i = list->head; VLIST_NIL != i; i = vlist_next(list, i))
+ * -------- 	print_test(vlist_data(list, i));
+ * -------- ******************************************************************
+ */
+#define vlist_next(list, slot) ((list)->nodes[(slot)].next)
+#define vlist_prev(list, slot) ((list)->nodes[(slot)].prev)
+
+
+/****************************************************************************
+ * conviniente data types for library consumers/users
+ ****************************************************************************/
+
+typedef struct vlist_node vlist_node_t;
+typedef struct vlist_list vlist_list_t;
+
+/****************************************************************************
+ * functional operations typedefs
+ ****************************************************************************/
+
+typedef void *(*vlist_map_func)(void *data);
+typedef bool (*vlist_filter_func)(void *data);
+typedef void *(*vlist_fold_func)(void *acc, void *data);
+
+
+/****************************************************************************
+ * library interface and _base_ documentation
+ ****************************************************************************/
+
+/* returns 'list' initialized with 'node_alloc' and 'node_dalloc'
+ * NULL is returned if 'list' is NULL
+ * passing NULL to 'node_alloc' sets it to VLIST_DEF_ALLOC
+ * passing NULL to 'node_dalloc' sets it to VLIST_DEF_DALLOC.
+ *
+ * ABOUT [ node_alloc, node_dalloc ]: used for the node array alone,
+ * ------- one call per growth step. see vlist_release.
+ *
+ * NOTE: no memory is taken until the first 'node' is added.
+ *
+ * passing invalid ['list' or 'node_alloc' or 'node_dalloc']
+ * ------- results in undefined behavior
+ */
+struct vlist_list *vlist_init(struct vlist_list *list,
+			      void *(*node_alloc)(size_t),
+			      void (*node_dalloc)(void *));
+
+
+/* returns a new allocated 'list' initialized with
+ * ------- 'node_alloc' and 'node_dalloc'.
+ * ------- the returned 'list' has to be freed, see vlist_list_delete
+ * passing NULL to 'node_alloc' sets it to VLIST_DEF_ALLOC.
+ * passing NULL to 'node_dalloc' sets it to VLIST_DEF_DALLOC.
+ * NULL is returned if 'node_alloc' fails to allocate memory.
+ *
+ * passing invalid ['node_alloc' or 'node_dalloc']
+ * ------- results in undefined behavior
+ */
+struct vlist_list *vlist_list_new(void *(*node_alloc)(size_t),
+				  void (*node_dalloc)(void *));
+
+
+/* returns 'list' after setting 'data_dalloc' to delete the 'data' of
+ * ------- every 'node' when the 'list' deletes them.
+ * returns NULL if 'list' is NULL
+ * passing NULL in 'data_dalloc' unsets it, which is the default.
+ *
+ * passing invalid ['list' or 'data_dalloc']
+ * ------- results in undefined behavior
+ */
+struct vlist_list *vlist_data_dalloc(struct vlist_list *list,
+				     void (*data_dalloc)(void *));
+
+
+/* returns 'list' after making room for at least 'capacity' nodes
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'capacity' can't be indexed or allocation fails,
+ * ------- 'list' is left as it was.
+ *
+ * NOTE: growing moves the node array, slots stay valid but pointers
+ * ------- to 'nodes' don't.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct vlist_list *vlist_reserve(struct vlist_list *list, size_t capacity);
+
+
+/* frees the node array of 'list', leaving it empty.
+ * passing NULL in 'list' returns with no operation executed
+ *
+ * NOTE: 'data' is not deleted, see vlist_list_delete_all_nodes.
+ * ------- meant for 'lists' set up with vlist_init.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+void vlist_release(struct vlist_list *list);
+
+
+/* deletes 'list' and its node array in one go
+ * passing NULL in 'list' returns with no operation executed
+ *
+ * NOTE: 'data' is not deleted, see vlist_list_delete_all_nodes.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ * ------- passing a 'list' not created with vlist_list_new
+ */
+void vlist_list_delete(struct vlist_list *list);
+
+
+/* returns the slot holding 'data' after making it the 'list' head.
+ * returns VLIST_NIL if 'list' is NULL
+ * returns VLIST_NIL if the node array can't grow
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+uint32_t vlist_push(struct vlist_list *list, void *data);
+
+
+/* returns the slot holding 'data' after making it the 'list' tail.
+ * returns VLIST_NIL if 'list' is NULL
+ * returns VLIST_NIL if the node array can't grow
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+uint32_t vlist_append(struct vlist_list *list, void *data);
+
+
+/* returns the 'data' at 'list' head removing it.
+ * returns NULL if 'list' is NULL.
+ * returns NULL if 'list' is empty.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+void *vlist_pop(struct vlist_list *list);
+
+
+/* returns the 'data' held by 'slot' removing it from 'list'. O(1)
+ * returns NULL if 'list' is NULL.
+ *
+ * passing a 'slot' not in 'list'
+ * ------- results in undefined behavior
+ */
+void *vlist_unlink(struct vlist_list *list, uint32_t slot);
+
+
+/* returns the slot whose 'data' matches 'key'
+ * returns VLIST_NIL if 'key' is not found
+ * passing NULL in 'list' returns VLIST_NIL.
+ * passing NULL 'key' returns VLIST_NIL.
+ * passing NULL 'cmp' returns VLIST_NIL.
+ *
+ * ABOUT ['cmp']: function needs to return 0 when 'a' and 'b' match
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+uint32_t vlist_find(struct vlist_list *list, void *key,
+		    int (*cmp)(void *a, void *b));
+
+
+/* returns the 'index' of 'key' in 'list'
+ * returns 0 if 'list' is NULL, empty or 'key' is not found.
+ * returns 0 if 'key' or 'cmp' are NULL
+ *
+ * ABOUT [index]: starts at 1, 0 is reserved (see above)
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+size_t vlist_find_index_of(struct vlist_list *list, void *key,
+			   int (*cmp)(void *a, void *b));
+
+
+/* returns the 'data' matching 'key' removing it.
+ * returns NULL if 'list' is NULL or empty.
+ * returns NULL if 'key' or 'cmp' are NULL.
+ * returns NULL if 'key' is not found.
+ *
+ * ABOUT ['cmp']: function needs to return 0 when 'a' and 'b' match
+ *
+ * passing invalid ['list' or 'key' or 'cmp']
+ * ------- results in undefined behavior
+ */
+void *vlist_remove(struct vlist_list *list, void *key,
+		   int (*cmp)(void *a, void *b));
+
+
+/* returns the 'data' stored in 'index' position removing it.
+ * returns NULL if 'list' is NULL or empty.
+ * returns NULL if 'index' is out of bounds.
+ *
+ * ABOUT ['index']: starts counting at 1. walks from the closest end.
+ *
+ * passing invalid ['list' or 'index']
+ * ------- results in undefined behavior
+ */
+void *vlist_remove_at(struct vlist_list *list, const size_t index);
+
+
+/* executes 'action' in each 'node' contained in 'list'
+ * returns without any action performed if 'list' is NULL or empty
+ * returns without any action performed if 'action' is NULL
+ * passing NULL in 'param' is allowed
+ *
+ * ABOUT ['action']: same as dlist_node_foreach
+ *
+ * passing invalid ['list' or 'action' or 'param']
+ * ------- results in undefined behavior
+ */
+void vlist_foreach(struct vlist_list *list,
+		   void *(*action)(void *carry, void *data, void *param),
+		   void *param);
+
+
+/* returns an empty 'list' after deleting all 'nodes' contained in it.
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'list' is empty
+ *
+ * NOTE: 'data' is deleted with 'data_dalloc' when set, the node array is
+ * ------- kept for reuse. without 'data_dalloc' no node is visited.
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct vlist_list *vlist_list_delete_all_nodes(struct vlist_list *list);
+
+
+/* returns 'list' reversed
+ * returns NULL if 'list' is NULL
+ * returns NULL if 'list' is empty
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+struct vlist_list *vlist_list_reverse(struct vlist_list *list);
+
+
+/* returns the number of 'nodes' contained in 'list'
+ * ABOUT vlist_get_size: no safety checks are made
+ *
+ * passing invalid ['list']
+ * ------- results in undefined behavior
+ */
+size_t vlist_get_size(struct vlist_list *list);
+
+
+/* returns a newly allocated 'list' starting at the 'node' matching 'key'
+ * ------- holding every 'node' from there to the tail.
+ * returns NULL if 'list' is NULL or empty.
+ * returns NULL if 'key' or 'cmp' are NULL.
+ * returns NULL if 'key' is not found.
+ * returns NULL if allocation of 'new list' fails, 'list' is left as it was.
+ *
+ * ---info makes 'list' empty if 'key' matches @ head
+ * ---info the newly allocated list has to be freed. see vlist_list_delete
+ *
+ * NOTE: moved 'nodes' get new slots in a node array of their own,
+ * ------- their old slots are released. 'data_dalloc' is handed over.
+ *
+ * passing invalid ['list']
+ * -------- results in undefined behavior
+ */
+struct vlist_list *vlist_list_split(struct vlist_list *list, void *key,
+				    int (*cmp)(void *a, void *b));
+
+
+/* returns a newly allocated 'list' with head set to 'node' stored in index
+ * returns NULL if 'list' is NULL or empty.
+ * returns NULL if 'index' is out of bounds.
+ * returns NULL if allocation of 'new list' fails, 'list' is left as it was.
+ *
+ * ---info makes 'list' empty if 'index' is 1/head
+ * ---info the newly allocated list has to be freed. see vlist_list_delete
+ *
+ * NOTE: see vlist_list_split
+ *
+ * passing invalid ['list']
+ * -------- results in undefined behavior
+ */
+struct vlist_list *vlist_list_split_at(struct vlist_list *list,
+				       const size_t index);
+
+/* returns a new list with each element transformed by 'func'
+ * returns NULL if 'list' is NULL, empty or allocation fails
+ * 'dalloc' becomes the new list 'data_dalloc'
+ *
+ * NOTE: the new node array is allocated once, at the 'list' size.
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct vlist_list *vlist_map(const struct vlist_list *list, vlist_map_func func,
+			     void (*dalloc)(void *));
+
+/* returns a new list with elements that pass 'func' predicate
+ * returns NULL if 'list' is NULL, empty or allocation fails
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+struct vlist_list *vlist_filter(const struct vlist_list *list,
+				vlist_filter_func func);
+
+/* folds the list from left to right using 'func', starting with 'initial'
+ * returns the final accumulator value
+ * returns 'initial' if 'list' is NULL or empty
+ *
+ * passing invalid ['list' or 'func']
+ * ------- results in undefined behavior
+ */
+void *vlist_fold(const struct vlist_list *list, void *initial,
+		 vlist_fold_func func);
+
+#endif
@@ -0,0 +1,321 @@
+/*
+ * vlist.t.c
+ * This file is part of dutils library collection
+ * Copyright (C) 2014  Darcy Bras da Silva
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/
+ */
+
+#include "vlist.h"
+#include <stdio.h>
+
+#include <assert.h>
+
+#define LOUD
+#include "common.h"
+
+void *double_int(void *data)
+{
+	return int_copy(*(int*)data * 2);
+}
+
+bool is_even(void *data)
+{
+	return 0 == *(int*)data % 2;
+}
+
+void *add_int(void *acc, void *data)
+{
+	*(int*)acc += *(int*)data;
+	return acc;
+}
+
+void *sum_int(void *carry, void *data, void *param)
+{
+	*(int*)param += *(int*)data;
+	return carry;
+}
+
+//checks 'list' holds 'n' values of 'expect' in order, both ways
+int list_is(struct vlist_list *list, const int *expect, size_t n)
+{
+	uint32_t slot;
+	size_t idx = 0;
+
+	if ( n != list->count )
+		return 0;
+
+	for(slot = list->head; VLIST_NIL != slot; slot = vlist_next(list, slot))
+		if ( idx >= n || expect[idx++] != *(int*)vlist_data(list, slot) )
+			return 0;
+
+	for(slot = list->tail; VLIST_NIL != slot; slot = vlist_prev(list, slot))
+		if ( expect[--idx] != *(int*)vlist_data(list, slot) )
+			return 0;
+
+	return 0 == idx;
+}
+
+int main(int argc, char **argv)
+{
+	wmsg("testing vlist lib interface\n");
+
+	{
+		wmsg("vlist_init");
+
+		struct vlist_list list;
+		assert( NULL == vlist_init(NULL, NULL, NULL) );
+		assert( vlist_init(&list, NULL, NULL) );
+		assert( 0 == list.count );
+		assert( VLIST_NIL == list.head );
+		assert( VLIST_NIL == list.tail );
+		assert( NULL == list.nodes );
+		assert( malloc == list.node_alloc );
+		assert( free == list.node_dalloc );
+		assert( NULL == list.data_dalloc );
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("vlist_reserve/release");
+
+		struct vlist_list list;
+		vlist_init(&list, NULL, NULL);
+		assert( NULL == vlist_reserve(NULL, 8) );
+		assert( &list == vlist_reserve(&list, 100) );
+		assert( 100 == list.capacity );
+		//never shrinks
+		assert( &list == vlist_reserve(&list, 10) );
+		assert( 100 == list.capacity );
+		vlist_release(&list);
+		assert( NULL == list.nodes );
+		assert( 0 == list.capacity );
+		vlist_release(NULL);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("vlist_push/append/pop");
+
+		struct vlist_list *list;
+		int expect[] = { 2, 1, 0, 100, 101, 102 };
+		uint32_t slot;
+		assert( VLIST_NIL == vlist_push(NULL, NULL) );
+		assert( VLIST_NIL == vlist_append(NULL, NULL) );
+		assert( NULL == vlist_pop(NULL) );
+		assert( (list = vlist_list_new(NULL, NULL)) );
+		assert( NULL == vlist_pop(list) );
+		vlist_data_dalloc(list, int_dalloc);
+		for(int i = 0; i < 3; ++i)
+		{
+			assert( VLIST_NIL != vlist_push(list, int_copy(i)) );
+			assert( VLIST_NIL != vlist_append(list, int_copy(100 + i)) );
+		}
+		assert( list_is(list, expect, 6) );
+		assert( 6 == vlist_get_size(list) );
+		int *data = vlist_pop(list);
+		assert( 2 == *data );
+		//the released slot is the next one handed out
+		slot = list->free;
+		assert( slot == vlist_push(list, data) );
+		assert( list_is(list, expect, 6) );
+		//growing keeps slots valid
+		for(int i = 0; i < 1000; ++i)
+			vlist_append(list, int_copy(i));
+		assert( 1006 == list->count );
+		assert( 2 == *(int*)vlist_data(list, slot) );
+		assert( list == vlist_list_delete_all_nodes(list) );
+		assert( 0 == list->count );
+		assert( VLIST_NIL == list->head );
+		assert( NULL == vlist_list_delete_all_nodes(list) );
+		vlist_list_delete(list);
+		vlist_list_delete(NULL);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("vlist_find/remove/remove_at/unlink");
+
+		struct vlist_list list;
+		int key = 3;
+		int *data;
+		uint32_t slot;
+		vlist_init(&list, NULL, NULL);
+		vlist_data_dalloc(&list, int_dalloc);
+		for(int i = 0; i < 8; ++i)
+			vlist_append(&list, int_copy(i));
+		//test failures
+		assert( VLIST_NIL == vlist_find(NULL, &key, cmp_int) );
+		assert( VLIST_NIL == vlist_find(&list, NULL, cmp_int) );
+		assert( VLIST_NIL == vlist_find(&list, &key, NULL) );
+		assert( 0 == vlist_find_index_of(&list, NULL, cmp_int) );
+		assert( NULL == vlist_remove_at(&list, 0) );
+		assert( NULL == vlist_remove_at(&list, 9) );
+		assert( NULL == vlist_unlink(NULL, 0) );
+		//find
+		assert( VLIST_NIL != (slot = vlist_find(&list, &key, cmp_int)) );
+		assert( 3 == *(int*)vlist_data(&list, slot) );
+		assert( 4 == vlist_find_index_of(&list, &key, cmp_int) );
+		//remove
+		assert( (data = vlist_remove(&list, &key, cmp_int)) );
+		assert( 3 == *data );
+		int_dalloc(data);
+		assert( NULL == vlist_remove(&list, &key, cmp_int) );
+		//remove_at, from both ends
+		data = vlist_remove_at(&list, 2);
+		assert( 1 == *data );
+		int_dalloc(data);
+		data = vlist_remove_at(&list, 5);
+		assert( 6 == *data );
+		int_dalloc(data);
+		data = vlist_remove_at(&list, 5);
+		assert( 7 == *data );
+		int_dalloc(data);
+		{
+			int expect[] = { 0, 2, 4, 5 };
+			assert( list_is(&list, expect, 4) );
+		}
+		//unlink is O(1) by slot
+		key = 4;
+		slot = vlist_find(&list, &key, cmp_int);
+		data = vlist_unlink(&list, slot);
+		assert( 4 == *data );
+		int_dalloc(data);
+		{
+			int expect[] = { 0, 2, 5 };
+			assert( list_is(&list, expect, 3) );
+		}
+		vlist_list_delete_all_nodes(&list);
+		vlist_release(&list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("vlist_foreach/reverse");
+
+		struct vlist_list list;
+		int sum = 0;
+		int expect[] = { 4, 3, 2, 1, 0 };
+		vlist_init(&list, NULL, NULL);
+		vlist_data_dalloc(&list, int_dalloc);
+		assert( NULL == vlist_list_reverse(&list) );
+		vlist_foreach(&list, sum_int, &sum);
+		assert( 0 == sum );
+		for(int i = 0; i < 5; ++i)
+			vlist_append(&list, int_copy(i));
+		vlist_foreach(&list, sum_int, &sum);
+		assert( 10 == sum );
+		assert( &list == vlist_list_reverse(&list) );
+		assert( list_is(&list, expect, 5) );
+		vlist_list_delete_all_nodes(&list);
+		vlist_release(&list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("vlist_list_split/split_at");
+
+		struct vlist_list list;
+		struct vlist_list *n_list;
+		int key = 3;
+		vlist_init(&list, NULL, NULL);
+		vlist_data_dalloc(&list, int_dalloc);
+		//test failures
+		assert( NULL == vlist_list_split(&list, &key, cmp_int) );
+		assert( NULL == vlist_list_split_at(&list, 1) );
+		for(int i = 0; i < 6; ++i)
+			vlist_append(&list, int_copy(i));
+		assert( NULL == vlist_list_split_at(&list, 0) );
+		assert( NULL == vlist_list_split_at(&list, 7) );
+		key = 10;
+		assert( NULL == vlist_list_split(&list, &key, cmp_int) );
+		//split by key
+		key = 3;
+		assert( (n_list = vlist_list_split(&list, &key, cmp_int)) );
+		{
+			int expect[] = { 0, 1, 2 };
+			int n_expect[] = { 3, 4, 5 };
+			assert( list_is(&list, expect, 3) );
+			assert( list_is(n_list, n_expect, 3) );
+		}
+		assert( int_dalloc == n_list->data_dalloc );
+		//released slots are reused before untouched ones
+		vlist_append(&list, int_copy(9));
+		assert( 6 == list.used );
+		//split_at @ tail and @ head
+		vlist_list_delete_all_nodes(n_list);
+		vlist_list_delete(n_list);
+		assert( (n_list = vlist_list_split_at(&list, 4)) );
+		assert( 9 == *(int*)vlist_data(n_list, n_list->head) );
+		assert( 3 == list.count && 1 == n_list->count );
+		vlist_list_delete_all_nodes(n_list);
+		vlist_list_delete(n_list);
+		assert( (n_list = vlist_list_split_at(&list, 1)) );
+		assert( 0 == list.count && VLIST_NIL == list.head );
+		assert( 3 == n_list->count );
+		vlist_list_delete_all_nodes(n_list);
+		vlist_list_delete(n_list);
+		vlist_release(&list);
+
+		wmsg("[OK]\n");
+	}
+
+	{
+		wmsg("vlist_map/filter/fold");
+
+		struct vlist_list list;
+		struct vlist_list *mapped;
+		struct vlist_list *filtered;
+		int acc = 0;
+		vlist_init(&list, NULL, NULL);
+		vlist_data_dalloc(&list, int_dalloc);
+		//test failures
+		assert( NULL == vlist_map(&list, double_int, int_dalloc) );
+		assert( NULL == vlist_filter(&list, is_even) );
+		assert( &acc == vlist_fold(&list, &acc, add_int) );
+		for(int i = 1; i <= 5; ++i)
+			vlist_append(&list, int_copy(i));
+		assert( NULL == vlist_map(&list, NULL, NULL) );
+		//map takes a single array
+		assert( (mapped = vlist_map(&list, double_int, int_dalloc)) );
+		assert( 5 == mapped->capacity );
+		{
+			int expect[] = { 2, 4, 6, 8, 10 };
+			assert( list_is(mapped, expect, 5) );
+		}
+		assert( int_dalloc == mapped->data_dalloc );
+		assert( (filtered = vlist_filter(&list, is_even)) );
+		{
+			int expect[] = { 2, 4 };
+			assert( list_is(filtered, expect, 2) );
+		}
+		assert( NULL == filtered->data_dalloc );
+		vlist_fold(&list, &acc, add_int);
+		assert( 15 == acc );
+		vlist_list_delete(filtered);
+		vlist_list_delete_all_nodes(mapped);
+		vlist_list_delete(mapped);
+		vlist_list_delete_all_nodes(&list);
+		vlist_release(&list);
+
+		wmsg("[OK]\n");
+	}
+
+	return 0;
+}